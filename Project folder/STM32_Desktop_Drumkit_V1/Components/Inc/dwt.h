@@ -0,0 +1,63 @@
+/**
+ * @file dwt.h
+ * @brief Cycle-accurate timebase based on the Cortex-M4 DWT cycle counter
+ *
+ * HAL_GetTick() only resolves milliseconds, which is too coarse for
+ * sub-millisecond timing (hit ordering, latency measurement). These helpers
+ * expose the free running DWT->CYCCNT counter (SystemCoreClock ticks).
+ *
+ * Timestamps are raw cycle counts; always compare them by subtraction
+ * (now - then) so the 32-bit wrap (~25 s at 168 MHz) is handled.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Enable the DWT cycle counter (call once before any other DWT_ function)
+ */
+static inline void DWT_Init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Get current cycle count
+ * @return uint32_t Raw DWT->CYCCNT value
+ */
+static inline uint32_t DWT_GetCycles(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief Convert a cycle count (usually a difference) to microseconds
+ * @param cycles Number of CPU cycles
+ * @return uint32_t Microseconds
+ */
+static inline uint32_t DWT_CyclesToUs(uint32_t cycles) {
+    return cycles / (SystemCoreClock / 1000000U);
+}
+
+/**
+ * @brief Convert microseconds to a cycle count
+ * @param us Microseconds
+ * @return uint32_t Number of CPU cycles
+ */
+static inline uint32_t DWT_UsToCycles(uint32_t us) {
+    return us * (SystemCoreClock / 1000000U);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file health.h
+ * @brief Runtime health counters (loop rate, ADC/DMA/I2C/UART faults)
+ *
+ * This file defines the Health class, one central block of counters fed
+ * from the HAL error callbacks and the hot paths:
+ * - Main loop iterations per second and the longest iteration
+ * - ADC overruns (the ADC DMA is restarted from poll())
+ * - DMA transfer errors (ADC, UART, I2C)
+ * - I2C busy waits, retries, given up transfers and bus errors (OLED)
+ * - UART TX failures (MIDI out, debug log DMA) and MIDI ACK timeouts
+ *
+ * Error_Handler() stores a fatal record in CCMRAM (count and caller,
+ * survives a reset, not the power off) before it stops: at a breakpoint
+ * when a debugger is attached, else in the usual endless loop. The record
+ * is logged at the next boot. An automatic reset is opt-in
+ * (HEALTH_FATAL_RESET), because gpio.c drives PWR_EN low at init: the
+ * reset powers the kit off until the next long press, and a persistent
+ * init failure turns into a reset / power off loop.
+ *
+ * Shown on the OLED (main menu "Health") and by the shell command "health".
+ * Health_Count() is the C entry for the oled-menu library and Core.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "main.h"
+
+#ifndef HEALTH_FATAL_RESET
+#define HEALTH_FATAL_RESET 0            // 1: Error_Handler resets the MCU (powers the kit off, see above)
+#endif
+
+/**
+ * @brief Health counter identifiers
+ */
+enum HealthCounter {
+    HEALTH_ADC_OVERRUN,         // ADC overruns (conversions lost)
+    HEALTH_DMA_ERROR,           // DMA transfer errors (any peripheral)
+    HEALTH_I2C_BUSY,            // I2C transfers that had to wait for the previous one
+    HEALTH_I2C_RETRY,           // I2C transfer starts repeated (handle or bus busy)
+    HEALTH_I2C_TIMEOUT,         // I2C transfers given up
+    HEALTH_I2C_ERROR,           // I2C errors (NACK, arbitration lost, bus error)
+    HEALTH_OLED_DROP,           // OLED bus jobs dropped (queue full, nothing was sent)
+    HEALTH_UART_TX_TIMEOUT,     // UART transmits that failed or timed out (MIDI out, debug log)
+    HEALTH_MIDI_ACK_TIMEOUT,    // MIDI bytes without ACK within MIDI_SEND_TIMEOUT_MS
+    HEALTH_COUNTER_NUM
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Increment a health counter (C entry)
+ * @param counter HealthCounter
+ */
+void Health_Count(uint8_t counter);
+
+/**
+ * @brief Record a fatal error (called by Error_Handler)
+ * @param caller Return address of Error_Handler
+ *
+ * Returns, unless HEALTH_FATAL_RESET is set: then it resets the MCU.
+ */
+void Health_Fatal(uint32_t caller);
+
+#ifdef __cplusplus
+}
+
+#define HEALTH_RATE_PERIOD_MS 1000      // Loop rate measuring period
+
+/**
+ * @class Health
+ * @brief Central health counter block
+ */
+class Health {
+    public:
+        /**
+         * @brief Construct a new Health object
+         */
+        Health();
+
+        /**
+         * @brief Increment a counter (thread mode or interrupt)
+         * @param counter HealthCounter
+         *
+         * Not atomic: a counter bumped from thread mode and an interrupt at
+         * once may lose a count, which is fine for statistics.
+         */
+        inline void count(HealthCounter counter) { _counters[counter]++; }
+
+        /**
+         * @brief Account one main loop iteration
+         * @param cycles Iteration time (DWT cycles)
+         */
+        inline void loopTick(uint32_t cycles) {
+            _loops++;
+            if (cycles > _loop_max_cycles) { _loop_max_cycles = cycles; }
+        }
+
+        /**
+         * @brief Update the loop rate and restart stopped ADC DMAs (call periodically)
+         */
+        void poll();
+
+        /**
+         * @brief Clear all counters (the fatal record is kept)
+         */
+        void reset();
+
+        /**
+         * @brief Get a counter
+         * @param counter HealthCounter
+         * @return uint32_t Count since boot or reset()
+         */
+        inline uint32_t getCounter(HealthCounter counter) { return _counters[counter]; }
+
+        /**
+         * @brief Get main loop iterations in the last HEALTH_RATE_PERIOD_MS
+         * @return uint32_t Iterations per second
+         */
+        inline uint32_t getLoopRate() { return _loop_rate; }
+
+        /**
+         * @brief Get the longest main loop iteration
+         * @return uint32_t Time in us
+         */
+        uint32_t getLoopMaxUs();
+
+        /**
+         * @brief Get number of Error_Handler calls since power on
+         * @return uint32_t Call count
+         */
+        uint32_t getFatalCount();
+
+        /**
+         * @brief Get the caller of the last Error_Handler
+         * @return uint32_t Code address (0 if none)
+         */
+        uint32_t getFatalCaller();
+
+        /**
+         * @brief Log all counters (INFO)
+         */
+        void dump();
+
+        /**
+         * @brief Convert a counter to a short name
+         * @param counter HealthCounter
+         * @return const char* Name (max 13 characters)
+         */
+        static const char* Counter2Str(HealthCounter counter);
+
+    private:
+        volatile uint32_t _counters[HEALTH_COUNTER_NUM];
+
+        uint32_t _loops;                    // Iterations since boot
+        uint32_t _loops_at_rate;            // _loops at the start of the measuring period
+        uint32_t _loop_rate;                // Iterations in the last period
+        uint32_t _loop_max_cycles;          // Longest iteration
+        uint32_t _rate_tick;                // HAL tick of the measuring period start
+
+        volatile uint8_t _adc_restart;      // ADCs to restart, bit n = ADCn+1 (set in interrupt)
+
+        friend void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc); // Friend function for interrupt handling
+};
+
+extern Health health;
+
+#endif
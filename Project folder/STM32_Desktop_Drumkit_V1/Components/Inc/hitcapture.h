@@ -0,0 +1,130 @@
+/**
+ * @file hitcapture.h
+ * @brief Pre-trigger waveform capture of each hit
+ *
+ * This file defines the HitCapture class. While enabled (settings menu
+ * "Hit Capture"), every pad scan stores the raw ADC value of each pad in a
+ * short per-pad history ring. On a hit the last CAP_PRE_SAMPLES values are
+ * copied into a free slot of the capture pool and the following samples are
+ * appended until the slot holds CAP_SAMPLES, so each capture shows the
+ * piezo signal from before the threshold crossing to after the measuring window.
+ *
+ * Finished captures are sent from the link task as binary trace blocks
+ * (TRACE_BLOCK_CAPTURE, see trace.h) whenever the log ring has room:
+ *
+ *     pad       1 byte   Pad::PadID
+ *     seq       1 byte   Capture counter (gaps: captures dropped, pool full)
+ *     hit       4 bytes  Hit onset, DWT cycles (same timebase as trace records)
+ *     thr       2 bytes  Hit threshold at the time
+ *     period    2 bytes  Sample period in us (pad scan period)
+ *     pre       1 byte   Samples before the trigger (the last one crossed the threshold)
+ *     count     2 bytes  Samples
+ *     samples            count x 12 bit, packed as Trace_Pack12()
+ *
+ * Tools/capture_decode.py extracts them from a UART capture.
+ *
+ * History rings and pool are statically sized and live in CCMRAM
+ * (.ccmbss, not loaded and not zeroed by the startup code, the constructor
+ * clears them), so they do not take SRAM from the DMA buffers. CCMRAM is
+ * CPU-only: blocks are copied into the (SRAM) log ring for the DMA.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+#include "pad.h"
+
+#define CAP_PRE_SAMPLES 24              // Pre-trigger history per pad (~2.4 ms at the 10 kHz pad scan)
+#define CAP_SAMPLES 256                 // Samples per capture, pre + post (~25 ms, covers the measuring window)
+#define CAP_SLOTS 16                    // Captures in the pool (~8 KB of CCMRAM)
+#define CAP_PERIOD_US 100               // Pad scan period (TASK_PADS_PERIOD_US)
+
+#define CAP_HEADER_SIZE 13
+#define CAP_PAYLOAD_SIZE (CAP_HEADER_SIZE + CAP_SAMPLES * 3 / 2)
+
+/**
+ * @class HitCapture
+ * @brief Per pad pre-trigger history and capture pool
+ */
+class HitCapture {
+    public:
+        /**
+         * @brief One capture slot
+         */
+        struct Capture {
+            uint32_t hit_cycles;        // Hit onset (DWT cycles)
+            uint16_t threshold;         // Hit threshold at the time
+            uint16_t len;               // Samples stored so far
+            uint8_t pad;                // Pad::PadID
+            uint8_t seq;                // Capture counter
+            uint8_t state;              // SLOT_x
+            uint16_t samples[CAP_SAMPLES];
+        };
+
+        /**
+         * @brief Construct a new HitCapture object
+         */
+        HitCapture();
+
+        /**
+         * @brief Enable or disable capturing (captures in flight are discarded on disable)
+         * @param enabled true to capture
+         */
+        inline void setEnabled(bool enabled) { _enabled = enabled; }
+
+        /**
+         * @brief Check whether capturing is enabled
+         * @return true if on (menu switch or shell)
+         */
+        inline bool isEnabled() { return _enabled; }
+
+        /**
+         * @brief Store the current ADC values (call once per pad scan, before trigger())
+         */
+        void sample();
+
+        /**
+         * @brief Start a capture for a pad (ignored while that pad has one running)
+         * @param pad Pad identifier
+         * @param hit_cycles Hit onset (DWT cycles)
+         * @param threshold Hit threshold at the time
+         */
+        void trigger(Pad::PadID pad, uint32_t hit_cycles, uint16_t threshold);
+
+        /**
+         * @brief Send the oldest finished capture if the log ring has room (call periodically)
+         */
+        void poll();
+
+        /**
+         * @brief Get number of captures sent
+         * @return uint32_t Capture count
+         */
+        inline uint32_t getSent() { return _sent; }
+
+        /**
+         * @brief Get number of hits not captured (pool full)
+         * @return uint32_t Dropped capture count
+         */
+        inline uint32_t getDropped() { return _dropped; }
+
+    private:
+        enum { SLOT_FREE, SLOT_RECORDING, SLOT_READY };
+
+        bool _enabled;
+        uint8_t _histPos;                   // Next history write index (shared by all pads)
+        int8_t _active[Pad::PAD_NUM];       // Recording slot per pad, -1 if none
+        uint8_t _seq;
+
+        uint32_t _sent;
+        uint32_t _dropped;
+
+        void _reset();
+};
+
+extern HitCapture hitCapture;
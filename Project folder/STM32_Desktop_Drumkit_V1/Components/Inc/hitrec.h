@@ -0,0 +1,94 @@
+/**
+ * @file hitrec.h
+ * @brief Hit event flight recorder
+ *
+ * This file defines the HitRecorder class. The last HITREC_SIZE completed
+ * hits are always kept in a RAM ring (one packed 12-byte event each, a few
+ * stores per hit), so a missed or doubled note can be analysed after the fact.
+ *
+ * A multi click (3+) on a display page dumps the ring to the debug UART as
+ * text lines, oldest event first:
+ *
+ *     #HREC BEGIN n=<events> total=<hits since boot> now=<HAL tick>
+ *     #HREC <24 hex digits>      One Event, bytes in memory order (little endian)
+ *     #HREC END
+ *
+ * The lines pass through the trace decoder unchanged; Tools/hitrec_decode.py
+ * turns them into a timeline. The dump is sent a few lines per poll() as the
+ * log ring has room, recording goes on meanwhile.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+
+#define HITREC_SIZE 128                 // Events kept (power of 2, 12 bytes each)
+#define HITREC_LINE_LEN 32              // "#HREC " + 24 hex digits + "\r\n"
+
+/**
+ * @class HitRecorder
+ * @brief Ring of the last hit events
+ */
+class HitRecorder {
+    public:
+        /**
+         * @brief One recorded hit (12 bytes, layout shared with Tools/hitrec_decode.py)
+         */
+        struct __attribute__((packed)) Event {
+            uint32_t tick;              // HAL tick at measurement completion (ms)
+            uint16_t peak;              // Peak ADC value
+            uint16_t threshold;         // Hit threshold at the time
+            uint8_t pad_result;         // Pad::PadID (bits 3-0) | Midi::QueueResult (bits 7-4)
+            uint8_t velocity;           // MIDI velocity sent
+            uint8_t window_ms;          // Measuring window length (ms, 255 = 255 or longer)
+            uint8_t queue_depth;        // Burst queue length after queuing this hit
+        };
+
+        /**
+         * @brief Construct a new HitRecorder object
+         */
+        HitRecorder();
+
+        /**
+         * @brief Record one hit
+         * @param ev Event
+         */
+        inline void record(const Event& ev) {
+            _events[_total & (HITREC_SIZE - 1)] = ev;
+            _total++;
+        }
+
+        /**
+         * @brief Start a dump (ignored if one is running)
+         */
+        void requestDump();
+
+        /**
+         * @brief Send pending dump lines as the log ring has room (call periodically)
+         */
+        void poll();
+
+        /**
+         * @brief Get number of hits recorded since boot
+         * @return uint32_t Hit count
+         */
+        inline uint32_t getTotal() { return _total; }
+
+    private:
+        Event _events[HITREC_SIZE];
+        uint32_t _total;            // Hits recorded, the newest event is at (_total - 1)
+
+        bool _dumping;
+        bool _headerSent;
+        uint32_t _dumpNext;         // Next event (running index) to send
+        uint32_t _dumpEnd;          // Running index the dump stops at
+
+        void _sendEvent(const Event& ev);
+};
+
+extern HitRecorder hitRecorder;
@@ -0,0 +1,166 @@
+/**
+ * @file logger.h
+ * @brief Asynchronous debug log on USART1 (TX DMA)
+ *
+ * This file defines the Logger class. Log lines are formatted into a ring
+ * buffer and drained in the background by USART1 TX DMA, so logging costs
+ * the formatting time only instead of ~87 us per byte at 115200 baud.
+ *
+ * - LOG_E / LOG_W / LOG_I / LOG_D take a printf format (no line ending,
+ *   "\r\n" is appended). Macros above LOG_BUILD_LEVEL compile out entirely.
+ * - At runtime lines above the logger level are skipped before formatting.
+ *   The level follows the "Debug Log" menu switch: INFO when off, DEBUG when on.
+ * - When the ring is full the line is dropped and counted, the caller never waits.
+ *
+ * The ring has a single producer (thread mode, the main loop) and a single
+ * consumer (the TX complete interrupt), each side only writes its own index.
+ * Do not log from interrupts.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+
+#define LOG_LVL_NONE 0
+#define LOG_LVL_ERROR 1
+#define LOG_LVL_WARN 2
+#define LOG_LVL_INFO 3
+#define LOG_LVL_DEBUG 4
+
+#ifndef LOG_BUILD_LEVEL
+#define LOG_BUILD_LEVEL LOG_LVL_DEBUG   // Highest level compiled in
+#endif
+
+#define LOG_BUF_SIZE 2048               // Ring size in bytes (power of 2, ~180 ms of output at 115200)
+#define LOG_LINE_MAX 128                // Max formatted line length including "\r\n"
+
+/**
+ * @class Logger
+ * @brief Ring-buffered, DMA-drained debug log
+ */
+class Logger {
+    public:
+        /**
+         * @brief Construct a new Logger object
+         */
+        Logger();
+
+        /**
+         * @brief Format and queue one log line
+         * @param level LOG_LVL_ERROR ... LOG_LVL_DEBUG
+         * @param fmt printf format (without line ending)
+         *
+         * ERROR and WARN lines are prefixed with "E: " / "W: ".
+         */
+        void print(uint8_t level, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+
+        /**
+         * @brief Queue a raw string as is
+         * @param level Log level
+         * @param str String (line ending included by the caller)
+         */
+        void write(uint8_t level, const char* str);
+
+        /**
+         * @brief Queue binary bytes as is (used by the trace encoder, no level check)
+         * @param data Bytes
+         * @param len Length
+         * @return true if queued, false if dropped (ring full)
+         */
+        bool writeRaw(const uint8_t* data, uint16_t len);
+
+        /**
+         * @brief Set runtime level
+         * @param level Lines above this level are skipped
+         */
+        inline void setLevel(uint8_t level) { _level = level; }
+
+        /**
+         * @brief Get runtime level
+         * @return uint8_t Level
+         */
+        inline uint8_t getLevel() { return _level; }
+
+        /**
+         * @brief Restart the DMA after a failed start or a transfer error (call periodically)
+         */
+        void poll();
+
+        /**
+         * @brief Get number of dropped lines (ring full)
+         * @return uint32_t Dropped line count
+         */
+        inline uint32_t getDropped() { return _dropped; }
+
+        /**
+         * @brief Get number of bytes queued since boot
+         * @return uint32_t Byte count
+         */
+        inline uint32_t getWritten() { return _written; }
+
+        /**
+         * @brief Get number of TX DMA transfers that ended in an error (resent)
+         * @return uint32_t Error count
+         */
+        inline uint32_t getTxErrors() { return _tx_errors; }
+
+        /**
+         * @brief Get number of bytes waiting in the ring (including the DMA chunk)
+         * @return uint16_t Byte count
+         */
+        inline uint16_t getPending() { return (uint16_t)(_head - _tail); }
+
+        /**
+         * @brief Get free space in the ring (a write of up to this size is not dropped)
+         * @return uint16_t Byte count
+         */
+        inline uint16_t getFree() { return LOG_BUF_SIZE - getPending(); }
+
+    private:
+        char _buf[LOG_BUF_SIZE];
+        volatile uint16_t _head;        // Free running write index (producer only)
+        volatile uint16_t _tail;        // Free running read index (TX complete interrupt only)
+        volatile uint16_t _dma_len;     // Bytes in flight, 0 if the DMA is idle
+
+        uint8_t _level;
+        uint32_t _dropped;
+        uint32_t _written;
+        uint32_t _tx_errors;
+
+        bool _push(const char* data, uint16_t len);
+        void _kick();
+        void _startDma();
+
+        friend void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart); // Friend function for interrupt handling
+};
+
+extern Logger logger;
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_ERROR
+#define LOG_E(...) logger.print(LOG_LVL_ERROR, __VA_ARGS__)
+#else
+#define LOG_E(...) ((void)0)
+#endif
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_WARN
+#define LOG_W(...) logger.print(LOG_LVL_WARN, __VA_ARGS__)
+#else
+#define LOG_W(...) ((void)0)
+#endif
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_INFO
+#define LOG_I(...) logger.print(LOG_LVL_INFO, __VA_ARGS__)
+#else
+#define LOG_I(...) ((void)0)
+#endif
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_DEBUG
+#define LOG_D(...) logger.print(LOG_LVL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_D(...) ((void)0)
+#endif
@@ -71,7 +71,7 @@
     82 - Shaker
 ---------------------------------------------------------- */
 
-// Notes used in the drumkit
+// Notes used in the drumkit (GM preset)
 // DAW mapping should align with these values (GM standard)
 #define ACOUSTIC_BASS_DRUM 35  // MIDI note number for acoustic bass drum
 #define ACOUSTIC_SNARE     38  // MIDI note number for acoustic snare
@@ -89,6 +89,16 @@
 #define NOTEOFF_DELAY_MS 20             // Delay before sending note off message in milliseconds
 #define MIDI_CHANNEL_ID 10              // Default MIDI channel ID for drumkit (channel 10 is percussion)
 #define MIDI_SEND_TIMEOUT_MS 100        // Timeout for MIDI send operations (ms)
+#define MIDI_BURST_WINDOW_US 300        // Default window for coalescing simultaneous hits into one burst (us)
+#define MIDI_BURST_WINDOW_MAX_US 500    // Upper bound of the coalescing window (us)
+#define MIDI_HOLD_BUF_SIZE 16           // Notes held while the link is down (replayed on reconnect)
+#define MIDI_STALE_CUTOFF_MS 150        // Default max age of a held note, older ones are dropped (ms)
+#define MIDI_NOTE_MAP_PRESET_NUM 3      // Number of note map presets (see NoteMapPreset)
+#define MIDI_LINK_BYTES_PER_SEC 3125    // Link budget: 31250 baud / 10 bits per byte
+#define MIDI_UTIL_BUCKET_MS 100         // Utilization meter bucket length (ms)
+#define MIDI_UTIL_BUCKETS 10            // Utilization meter window = buckets * bucket length (1 s)
+#define MIDI_SYSEX_TX_SIZE 80           // Max SysEx payload of queueSysEx() (bytes, without F0/F7)
+#define MIDI_SYSEX_SLICE_BYTES 3        // SysEx bytes sent per flushBurst() call (as long as one note message)
 
 
 /**
@@ -97,6 +107,17 @@
  * 
  * This class manages sending MIDI messages and handling note on/off events.
  * It supports automatic note off timing and channel state tracking.
+ * 
+ * Hits that complete at (almost) the same time can be queued with queueNoteOn()
+ * and are sent by flushBurst() as one running-status burst ordered by hit onset.
+ * Notes that cannot be sent (link down, ACK timeout) are held in a bounded
+ * buffer and replayed on reconnect unless they have gone stale. A message
+ * broken off after its first bytes is replayed in full (the receiver drops
+ * the partial one at the next status byte), a Note Off that fails stays
+ * pending until it is sent.
+ * 
+ * Pad to note/channel mapping comes from RAM-resident note maps. Each preset
+ * has its own table, switching presets only swaps the active table pointer.
  */
 class Midi {
     public:
@@ -110,6 +131,84 @@ class Midi {
             uint8_t channel;            // MIDI channel
         };
 
+        /**
+         * @brief Note map presets
+         */
+        enum NoteMapPreset {
+            MAP_GM,         // General MIDI percussion (channel 10)
+            MAP_VST,        // Drum VST layout (channel 1)
+            MAP_MODULE      // E-drum module layout (kit on channel 10, hi-hats on 11)
+        };
+
+        /**
+         * @brief Result of queueNoteOn()
+         */
+        enum QueueResult {
+            QUEUED,         // Queued, link up
+            QUEUED_HELD,    // Queued while the link is down (goes to the hold buffer)
+            QUEUED_FLUSHED, // Queue was full, the pending burst was sent (or its oldest note held) first
+            REJECTED        // Invalid pad
+        };
+
+        /**
+         * @brief Pad to MIDI note/channel table
+         */
+        struct NoteMap {
+            const char* name;                       // Preset name (for display)
+            uint8_t note[MIDI_CHANNELS_NUM];        // MIDI note for each pad (0-127)
+            uint8_t channel[MIDI_CHANNELS_NUM];     // MIDI channel for each pad (1-16)
+        };
+
+        /**
+         * @brief A queued Note On waiting in the coalescing stage
+         */
+        struct BurstEvent {
+            Pad::PadID padID;           // Pad that was hit
+            uint8_t velocity;           // MIDI velocity (0-127)
+            uint32_t hit_cycles;        // Hit onset timestamp (DWT cycles), used for ordering
+            uint32_t queued_cycles;     // Time the event entered the queue (DWT cycles)
+            uint32_t hit_tick;          // Hit onset in HAL ticks (ms), for the stale cutoff
+        };
+
+        /**
+         * @brief Statistics of the burst coalescing stage
+         */
+        struct BurstStats {
+            uint32_t bursts;                        // Number of bursts flushed
+            uint32_t notes;                         // Number of Note On messages sent in bursts
+            uint32_t size_hist[MIDI_CHANNELS_NUM];  // size_hist[n - 1]: bursts that carried n notes
+            uint8_t max_size;                       // Largest burst seen
+            uint32_t latency_sum_us;                // Sum of added latency over all sent notes (us)
+            uint32_t latency_max_us;                // Max added latency of a single note (us)
+        };
+
+        /**
+         * @brief Statistics of the hold (store-and-forward) buffer
+         */
+        struct HoldStats {
+            uint32_t held;              // Notes put into the hold buffer
+            uint32_t replayed;          // Held notes sent after reconnect
+            uint32_t stale;             // Held notes dropped for exceeding the stale cutoff
+            uint32_t overflow;          // Held notes dropped because the buffer was full
+            uint32_t aborted;           // Messages broken off after their first bytes
+        };
+
+        /**
+         * @brief Transport statistics (counted at the byte/message level)
+         */
+        struct TxStats {
+            uint32_t bytes;             // Bytes put on the wire
+            uint32_t note_on;           // Complete Note On messages
+            uint32_t note_off;          // Complete Note Off messages
+            uint32_t sysex;             // Complete SysEx frames
+            uint32_t retries;           // UART writes repeated because the handle was busy
+            uint32_t timeouts;          // _sendByte failures (no ACK within MIDI_SEND_TIMEOUT_MS)
+            uint32_t tx_errors;         // UART writes that failed (after the retry)
+            uint32_t ack_wait_sum_us;   // Sum of ACK wait time over all bytes (us)
+            uint32_t ack_wait_max_us;   // Longest ACK wait (us)
+            uint8_t queue_depth_max;    // Deepest burst queue seen
+        };
+
         /**
          * @brief Construct a new Midi object
          */
@@ -119,9 +218,10 @@ class Midi {
          * @brief Send a MIDI Note On message
          * @param padID Pad identifier
          * @param velocity MIDI velocity (0-127)
-         * @param channel MIDI channel (defaults to 10)
+         * 
+         * Note and channel are taken from the active note map.
          */
-        bool sendNoteOn(Pad::PadID padID, uint8_t velocity, uint8_t channel = MIDI_CHANNEL_ID);
+        bool sendNoteOn(Pad::PadID padID, uint8_t velocity);
 
         /**
          * @brief Send a MIDI Note Off message
@@ -136,6 +236,25 @@ class Midi {
          */
         void sendNoteOff(Pad::PadID padID);
 
+        /**
+         * @brief Queue a System Exclusive message
+         * @param data Payload without the 0xF0/0xF7 framing (7-bit bytes)
+         * @param len Payload length (up to MIDI_SYSEX_TX_SIZE)
+         * @return true if queued, false if the link is down, another frame is pending or it is too long
+         * 
+         * The frame is copied and sent by flushBurst(), MIDI_SYSEX_SLICE_BYTES
+         * per call, so no single call waits for more than one note message worth
+         * of ACKs. Notes wait while the frame is open: a channel message inside
+         * a SysEx frame would end it.
+         */
+        bool queueSysEx(const uint8_t* data, uint16_t len);
+
+        /**
+         * @brief Check if a queued SysEx frame is not completely sent yet
+         * @return true if pending
+         */
+        inline bool isSysExPending() { return _sysex_len != 0; }
+
         /**
          * @brief Handle automatic note off events
          * 
@@ -149,12 +268,206 @@ class Midi {
          */
         bool isConnected();
 
+        /**
+         * @brief Queue a Note On into the coalescing stage
+         * @param padID Pad identifier
+         * @param velocity MIDI velocity (0-127)
+         * @param hit_cycles Hit onset timestamp (DWT cycles)
+         * @return QueueResult What happened to the note (for the hit recorder)
+         */
+        QueueResult queueNoteOn(Pad::PadID padID, uint8_t velocity, uint32_t hit_cycles);
+
+        /**
+         * @brief Send the queued Note On messages as one burst once the window has elapsed
+         * @param active_pads Number of pads still measuring (0 closes the window immediately)
+         * @return uint8_t Number of notes sent (0 if nothing was flushed)
+         * 
+         * Should be called once per main loop iteration, after all pads were processed.
+         * A pending SysEx frame goes first, the notes wait until it is complete.
+         */
+        uint8_t flushBurst(uint8_t active_pads);
+
+        /**
+         * @brief Check if flushBurst() or autoNoteOff() has something to send
+         * @param active_pads Number of pads still measuring
+         * @return true if a SysEx frame is pending, a burst is due, held notes can be replayed or a Note Off is due
+         * 
+         * Release condition of the scheduler's MIDI task, cheap enough to poll every pass.
+         */
+        bool hasWork(uint8_t active_pads);
+
+        /**
+         * @brief Get number of notes waiting in the coalescing stage
+         * @return uint8_t Pending note count
+         */
+        inline uint8_t getBurstPending() { return _burst_len; }
+
+        /**
+         * @brief Set the coalescing window
+         * @param window_us Window in microseconds (clamped to MIDI_BURST_WINDOW_MAX_US, 0 disables coalescing)
+         */
+        void setBurstWindow(uint16_t window_us);
+
+        /**
+         * @brief Get the coalescing window
+         * @return uint16_t Window in microseconds
+         */
+        inline uint16_t getBurstWindow() { return _burst_window_us; }
+
+        /**
+         * @brief Get burst statistics
+         * @return const BurstStats& Statistics since boot or last reset
+         */
+        inline const BurstStats& getBurstStats() { return _burst_stats; }
+
+        /**
+         * @brief Get hold buffer statistics
+         * @return const HoldStats& Statistics since boot or last reset
+         */
+        inline const HoldStats& getHoldStats() { return _hold_stats; }
+
+        /**
+         * @brief Get number of notes waiting in the hold buffer
+         * @return uint8_t Held note count
+         */
+        inline uint8_t getHeldCount() { return _hold_len; }
+
+        /**
+         * @brief Set the stale cutoff for held notes
+         * @param cutoff_ms Max age of a held note in milliseconds
+         */
+        void setStaleCutoff(uint16_t cutoff_ms);
+
+        /**
+         * @brief Get the stale cutoff for held notes
+         * @return uint16_t Cutoff in milliseconds
+         */
+        inline uint16_t getStaleCutoff() { return _stale_cutoff_ms; }
+
+        /**
+         * @brief Reset burst and hold statistics
+         */
+        void resetBurstStats();
+
+        /**
+         * @brief Get transport statistics
+         * @return const TxStats& Statistics since boot or last reset
+         */
+        inline const TxStats& getTxStats() { return _tx_stats; }
+
+        /**
+         * @brief Reset transport statistics and utilization meter
+         */
+        void resetTxStats();
+
+        /**
+         * @brief Get link utilization over the last second
+         * @return uint8_t Percent of the 31250 baud budget (0-100)
+         */
+        uint8_t getLinkUtilization();
+
+        /**
+         * @brief Get the highest link utilization seen
+         * @return uint8_t Percent of the 31250 baud budget (0-100)
+         */
+        inline uint8_t getLinkUtilizationPeak() { return _util_peak; }
+
+        /**
+         * @brief Print transport and burst statistics over the debug UART
+         */
+        void dumpStats();
+
+        /**
+         * @brief Switch the active note map
+         * @param preset Preset to activate
+         * 
+         * Notes already sounding keep the note/channel they were sent with,
+         * so their Note Off still matches after a switch.
+         */
+        void selectNoteMap(NoteMapPreset preset);
+
+        /**
+         * @brief Get the active note map preset
+         * @return NoteMapPreset Active preset
+         */
+        inline NoteMapPreset getNoteMapPreset() { return (NoteMapPreset)(_activeMap - _noteMaps); }
+
+        /**
+         * @brief Get the active note map
+         * @return const NoteMap& Active table
+         */
+        inline const NoteMap& getNoteMap() { return *_activeMap; }
+
+        /**
+         * @brief Restore a preset table to its built-in values (drops overrides)
+         * @param preset Preset to restore
+         */
+        void resetNoteMap(NoteMapPreset preset);
+
+        /**
+         * @brief Override the note of a pad in the active map
+         * @param padID Pad identifier
+         * @param note MIDI note number (0-127)
+         */
+        void setPadNote(Pad::PadID padID, uint8_t note);
+
+        /**
+         * @brief Override the channel of a pad in the active map
+         * @param padID Pad identifier
+         * @param channel MIDI channel (1-16)
+         */
+        void setPadChannel(Pad::PadID padID, uint8_t channel);
+
+        /**
+         * @brief Get the note of a pad in the active map
+         * @param padID Pad identifier
+         * @return uint8_t MIDI note number
+         */
+        inline uint8_t getPadNote(Pad::PadID padID) { return _activeMap->note[padID]; }
+
+        /**
+         * @brief Get the channel of a pad in the active map
+         * @param padID Pad identifier
+         * @return uint8_t MIDI channel (1-16)
+         */
+        inline uint8_t getPadChannel(Pad::PadID padID) { return _activeMap->channel[padID]; }
+
     private:
         volatile ChnState _channel_states[MIDI_CHANNELS_NUM]; // Array of channel states (volatile for memory visibility)
 
         volatile bool _ack;       // Acknowledge flag (updated in interrupt)
         volatile bool _connected; // Connection status flag (updated in interrupt)
 
+        BurstEvent _burst[MIDI_CHANNELS_NUM]; // Coalescing queue (each pad completes at most once per window)
+        uint8_t _burst_len;                   // Number of queued events
+        uint16_t _burst_window_us;            // Coalescing window (us)
+        BurstStats _burst_stats;              // Burst statistics
+
+        BurstEvent _hold[MIDI_HOLD_BUF_SIZE]; // Hold buffer (ring) for notes not sent yet
+        uint8_t _hold_head;                   // Index of the oldest held note
+        uint8_t _hold_len;                    // Number of held notes
+        uint16_t _stale_cutoff_ms;            // Max age of a held note (ms)
+        HoldStats _hold_stats;                // Hold buffer statistics
+
+        TxStats _tx_stats;                              // Transport statistics
+        uint16_t _util_bytes[MIDI_UTIL_BUCKETS];        // Bytes sent per utilization bucket
+        uint32_t _util_slot[MIDI_UTIL_BUCKETS];         // Time slot each bucket belongs to
+        uint8_t _util_peak;                             // Highest utilization seen (%)
+
+        uint8_t _sysex[MIDI_SYSEX_TX_SIZE + 2];         // Pending SysEx frame (with F0/F7)
+        uint8_t _sysex_len;                             // Frame length (0 = none)
+        uint8_t _sysex_pos;                             // Bytes of the frame sent
+
+        NoteMap _noteMaps[MIDI_NOTE_MAP_PRESET_NUM]; // RAM copies of the presets (editable)
+        NoteMap* volatile _activeMap;                // Active table (swapped atomically)
+
+        /**
+         * @brief Built-in note map presets
+         * 
+         * Maps Pad::PadID to corresponding MIDI note numbers and channels
+         */
+        static const NoteMap _NOTE_MAP_PRESETS[MIDI_NOTE_MAP_PRESET_NUM];
+
         /**
          * @brief Send a single MIDI byte
          * @param byte MIDI byte to send
@@ -162,22 +475,36 @@ class Midi {
         bool _sendByte(uint8_t byte);
 
         /**
-         * @brief MIDI note mapping for each pad
-         * 
-         * Maps Pad::PadID to corresponding MIDI note numbers
-         */
-        static constexpr uint8_t _PAD_MIDI_NOTE_MAP[MIDI_CHANNELS_NUM] = {
-            OPEN_HI_HAT,        // OpenHiHat
-            CLOSED_HI_HAT,      // CloseHiHat
-            CRASH_CYMBAL_1,     // Crash
-            RIDE_CYMBAL_1,      // Ride
-            SIDESTICK,          // SideStick
-            ACOUSTIC_BASS_DRUM, // Kick
-            ACOUSTIC_SNARE,     // Snare
-            HIGH_MID_TOM,       // MidTom
-            LOW_TOM,            // LowTom
-            HIGH_TOM            // HighTom
-        };
+         * @brief Account a byte in the utilization meter
+         */
+        void _countUtilization();
+
+        /**
+         * @brief Send the next part of the pending SysEx frame
+         * @return true if the frame is complete (or dropped), false if bytes are left
+         */
+        bool _sendSysExSlice();
+
+        /**
+         * @brief Send Note On messages back to back with running status
+         * @param events Events in send order
+         * @param count Number of events
+         * @return uint8_t Number of complete messages sent
+         */
+        uint8_t _sendNoteOns(const BurstEvent* events, uint8_t count);
+
+        /**
+         * @brief Put an unsent note into the hold buffer (drops the oldest when full)
+         * @param ev Event to hold
+         */
+        void _holdEvent(const BurstEvent& ev);
+
+        /**
+         * @brief Replay held notes, dropping stale ones
+         */
+        void _replayHeld();
 
         friend void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin); // Friend function for interrupt handling
-};
\ No newline at end of file
+};
+
+extern Midi midi;
@@ -0,0 +1,167 @@
+/**
+ * @file midi_in.h
+ * @brief MIDI input (USART2 RX) and SysEx configuration protocol
+ *
+ * This file defines the MidiIn class. USART2 RX runs as a circular DMA into
+ * a ring buffer, poll() parses newly arrived bytes in place with MidiParser
+ * (no copy, no blocking) and dispatches:
+ * - Realtime bytes (clock/start/stop) for host sync
+ * - SysEx frames for bulk read/write of all pad parameters
+ *
+ * SysEx protocol (all bytes 7-bit, framed by F0 ... F7):
+ *
+ *     F0 7D 01 <cmd> <data...> F7
+ *
+ *     cmd 01  Dump request     -> device answers with cmd 02
+ *     cmd 02  Dump             <config block>
+ *     cmd 03  Bulk write       <config block> -> device answers with ACK/NAK
+ *     cmd 7F  ACK              <cmd>
+ *     cmd 7E  NAK              <cmd> <error>
+ *
+ *     config block = <note map preset> then for each pad (PadID order):
+ *         thr_hi thr_lo lim_hi lim_lo curve note channel-1
+ *     (12-bit ADC values split into 5 high + 7 low bits)
+ *
+ * A dump sent back with cmd 03 writes the same configuration. Replies
+ * (cmd 02, 7F, 7E) received are ignored, so a loopback cannot start a NAK
+ * ping-pong; any other unknown command is answered with a NAK.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+#include "pad.h"
+#include "midi.h"
+#include "midi_parser.h"
+
+#define MIDI_IN_RX_BUF_SIZE 256         // USART2 RX DMA ring size (bytes, ~80 ms of MIDI at full rate)
+#define MIDI_IN_POLL_BUDGET 64          // Max bytes parsed per poll() call
+#define MIDI_IN_SYSEX_BUF_SIZE 96       // Max SysEx payload accepted (bytes)
+
+#define SYSEX_MANUFACTURER_ID 0x7D      // Non-commercial / educational manufacturer ID
+#define SYSEX_DEVICE_ID 0x01            // Drumkit device ID
+#define SYSEX_HEADER_LEN 3              // Manufacturer, device, command
+#define SYSEX_PAD_BLOCK_LEN 7           // Bytes per pad in the config block
+#define SYSEX_CONFIG_LEN (1 + Pad::PAD_NUM * SYSEX_PAD_BLOCK_LEN) // Config block length
+
+static_assert(SYSEX_HEADER_LEN + SYSEX_CONFIG_LEN <= MIDI_SYSEX_TX_SIZE, "dump does not fit Midi::queueSysEx()");
+
+/**
+ * @class MidiIn
+ * @brief MIDI input handler on USART2 RX
+ */
+class MidiIn {
+    public:
+        /**
+         * @brief SysEx command codes
+         */
+        enum SysExCmd {
+            CMD_DUMP_REQUEST = 0x01,
+            CMD_DUMP         = 0x02,
+            CMD_BULK_WRITE   = 0x03,
+            CMD_NAK          = 0x7E,
+            CMD_ACK          = 0x7F
+        };
+
+        /**
+         * @brief SysEx NAK error codes
+         */
+        enum SysExError {
+            ERR_LENGTH      = 0x01,     // Wrong payload length
+            ERR_RANGE       = 0x02,     // Value out of range
+            ERR_UNKNOWN_CMD = 0x03      // Unsupported command
+        };
+
+        /**
+         * @brief Construct a new MidiIn object
+         */
+        MidiIn();
+
+        /**
+         * @brief Start circular DMA reception on USART2
+         */
+        void begin();
+
+        /**
+         * @brief Parse received bytes (call in main loop)
+         * @param idle true if no hit is in flight, allows pending SysEx replies to be sent
+         *
+         * Parses at most MIDI_IN_POLL_BUDGET bytes per call. A SysEx reply is
+         * handed to Midi::queueSysEx() once the pads are idle; the MIDI task
+         * sends it in slices and holds notes back until the frame is complete.
+         */
+        void poll(bool idle);
+
+        /**
+         * @brief Check if the host transport is running (Start/Continue received)
+         * @return true if running
+         */
+        inline bool isTransportRunning() { return _transport_running; }
+
+        /**
+         * @brief Get MIDI clock ticks since last Start (24 per quarter note)
+         * @return uint32_t Clock count
+         */
+        inline uint32_t getClockCount() { return _clock_count; }
+
+        /**
+         * @brief Get host tempo derived from MIDI clock
+         * @return uint16_t Tempo in 0.1 BPM (0 if no clock received)
+         */
+        uint16_t getTempoBPMx10();
+
+        /**
+         * @brief Get parser statistics
+         * @return const MidiParser::Stats& Statistics
+         */
+        inline const MidiParser::Stats& getParserStats() { return _parser.getStats(); }
+
+        /**
+         * @brief Get number of received bytes
+         * @return uint32_t Byte count
+         */
+        inline uint32_t getRxBytes() { return _rx_bytes; }
+
+        /**
+         * @brief Get number of UART receive errors (overrun, framing, noise)
+         * @return uint32_t Error count
+         */
+        inline uint32_t getRxErrors() { return _rx_errors; }
+
+    private:
+        uint8_t _rx_buf[MIDI_IN_RX_BUF_SIZE];       // DMA ring buffer (written by DMA only)
+        uint16_t _rx_tail;                          // Next index to parse
+        uint32_t _rx_bytes;                         // Received byte count
+        volatile uint32_t _rx_errors;               // UART error count (updated in interrupt)
+
+        uint8_t _sysex_buf[MIDI_IN_SYSEX_BUF_SIZE]; // SysEx payload buffer
+        MidiParser _parser;                         // Stream parser
+
+        uint8_t _reply[SYSEX_HEADER_LEN + SYSEX_CONFIG_LEN]; // Pending SysEx reply payload
+        uint16_t _reply_len;                        // Pending reply length (0 = none)
+
+        bool _transport_running;                    // Start/Continue received
+        uint32_t _clock_count;                      // Clock ticks since Start
+        uint32_t _last_clock_cycles;                // DWT timestamp of last clock tick
+        uint32_t _clock_interval_us;                // Smoothed clock interval (us, 0 = unknown)
+
+        static void _onMessage(uint8_t status, uint8_t data1, uint8_t data2);
+        static void _onRealtime(uint8_t byte);
+        static void _onSysEx(const uint8_t* data, uint16_t len);
+
+        void _handleSysEx(const uint8_t* data, uint16_t len);
+        void _buildDump();
+        uint8_t _applyConfig(const uint8_t* block);
+        void _replyAck(uint8_t cmd);
+        void _replyNak(uint8_t cmd, uint8_t error);
+        void _startRx();
+
+        friend void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart); // Friend function for interrupt handling
+};
+
+extern MidiIn midiIn;
@@ -0,0 +1,110 @@
+/**
+ * @file midi_parser.h
+ * @brief Streaming MIDI byte parser
+ *
+ * This file defines the MidiParser class which turns a raw MIDI byte stream
+ * into channel messages, realtime bytes and SysEx frames. It handles running
+ * status, realtime bytes interleaved anywhere (also inside SysEx) and
+ * messages split across any number of feed() calls.
+ *
+ * The parser has no hardware dependency, so it can also be fed on the host.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @class MidiParser
+ * @brief Byte-by-byte MIDI stream parser
+ *
+ * Handlers are plain function pointers (like the button callbacks) and are
+ * called synchronously from feed(). SysEx payload is collected into a caller
+ * supplied buffer, everything else is parsed in place.
+ */
+class MidiParser {
+    public:
+        typedef void (*MessageHandler)(uint8_t status, uint8_t data1, uint8_t data2); // Channel / system common message
+        typedef void (*RealtimeHandler)(uint8_t byte);                                 // 0xF8-0xFF
+        typedef void (*SysExHandler)(const uint8_t* data, uint16_t len);               // Payload between 0xF0 and 0xF7
+
+        /**
+         * @brief Parser statistics
+         */
+        struct Stats {
+            uint32_t messages;          // Channel / system common messages dispatched
+            uint32_t realtime;          // Realtime bytes dispatched
+            uint32_t sysex;             // Complete SysEx frames dispatched
+            uint32_t sysex_overflow;    // SysEx frames dropped (payload larger than buffer)
+            uint32_t sysex_aborted;     // SysEx frames cut off by a status byte
+            uint32_t stray;             // Data bytes without a valid status (discarded)
+        };
+
+        /**
+         * @brief Construct a new MidiParser object
+         * @param sysex_buf Buffer for SysEx payload
+         * @param sysex_size Size of sysex_buf in bytes
+         */
+        MidiParser(uint8_t* sysex_buf, uint16_t sysex_size);
+
+        inline void attachMessage(MessageHandler handler) { _onMessage = handler; }
+        inline void attachRealtime(RealtimeHandler handler) { _onRealtime = handler; }
+        inline void attachSysEx(SysExHandler handler) { _onSysEx = handler; }
+
+        /**
+         * @brief Parse one byte
+         * @param byte Received MIDI byte
+         */
+        void feed(uint8_t byte);
+
+        /**
+         * @brief Parse a block of bytes (may end in the middle of a message)
+         * @param data Received bytes
+         * @param len Number of bytes
+         */
+        void feed(const uint8_t* data, uint16_t len);
+
+        /**
+         * @brief Drop any partial message and running status
+         */
+        void reset();
+
+        /**
+         * @brief Get parser statistics
+         * @return const Stats& Statistics since construction
+         */
+        inline const Stats& getStats() { return _stats; }
+
+    private:
+        MessageHandler _onMessage;
+        RealtimeHandler _onRealtime;
+        SysExHandler _onSysEx;
+
+        uint8_t* _sysex_buf;            // SysEx payload buffer
+        uint16_t _sysex_size;           // Capacity of _sysex_buf
+        uint16_t _sysex_len;            // Bytes collected in current frame
+        bool _in_sysex;                 // Inside F0 ... F7
+        bool _sysex_overflow;           // Current frame did not fit
+
+        uint8_t _status;                // Running status (0 = none)
+        uint8_t _data[2];               // Data bytes of the current message
+        uint8_t _data_count;            // Data bytes collected
+        uint8_t _data_needed;           // Data bytes the current status needs
+
+        Stats _stats;
+
+        /**
+         * @brief Number of data bytes following a status byte
+         * @param status Status byte (0x80-0xF7)
+         * @return uint8_t 0-2
+         */
+        static uint8_t _dataLength(uint8_t status);
+
+        void _endSysEx(bool complete);
+        void _dispatch();
+};
@@ -0,0 +1,190 @@
+/**
+ * @file oled_bus.h
+ * @brief Asynchronous OLED transport (I2C1 DMA job queue)
+ *
+ * This file defines the OledBus class, the only code that talks to the
+ * SSD1306. Both OLED stacks (the OLED class and the oled-menu library)
+ * hand their transfers over and return at once:
+ * - Command jobs: a command sequence, sent as one transaction. A command
+ *   queued right behind another command job that has not started yet is
+ *   appended to it, so the menu library's one byte OLED_SendCmd() calls
+ *   become a few transactions.
+ * - Page jobs: a column span of one display page. The bytes are copied into
+ *   a staging row. While the page job waits, later submissions for the same
+ *   page only refresh the staging row and widen the span. A frame sent
+ *   while the previous one is still on the bus therefore costs no extra
+ *   transfer, and the newest content wins. Each page job is one transaction:
+ *   the column / page window (0x21 / 0x22, horizontal addressing mode) as
+ *   single commands, then the span data.
+ *
+ * A page transaction that is given up after its retries invalidates that
+ * page of the display core (OLED_InvalidatePage()), so the next refresh
+ * sends the whole page again instead of trusting the lost span.
+ *
+ * The next job is started from HAL_I2C_MasterTxCpltCallback(). Nothing
+ * waits for the bus; when the queue is full the job is dropped and counted
+ * (HEALTH_OLED_DROP: a display glitch, never a pad scan stall). poll()
+ * restarts the queue after a failed start or a transfer error.
+ *
+ * Single producer (thread mode), single consumer (the I2C interrupt). The
+ * submit functions mask interrupts while they touch the queue.
+ *
+ * OledBus_Cmds() / OledBus_Page() are the C entries for the oled-menu library.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "main.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "oled_draw.h"
+#ifdef __cplusplus
+}
+#endif
+
+#define OLED_BUS_ADDR 0x78              // SSD1306 8-bit write address
+#define OLED_BUS_PAGES OLED_PAGE        // Display pages (8 px rows) of the 128x32 panel
+#define OLED_BUS_COLUMNS OLED_COLUMN    // Display width in pixels
+#define OLED_BUS_QUEUE_LEN 16           // Queued jobs (power of 2)
+#define OLED_BUS_CMD_MAX 30             // Command bytes per command job
+#define OLED_BUS_WINDOW_CMD_LEN 6       // 0x21 x0 x1 0x22 p0 p1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Queue a command sequence (C entry)
+ * @param cmds Command bytes (with their arguments)
+ * @param len Number of bytes (1 ~ OLED_BUS_CMD_MAX)
+ * @return true if queued, false if dropped (queue full)
+ */
+bool OledBus_Cmds(const uint8_t* cmds, uint8_t len);
+
+/**
+ * @brief Queue a column span of a display page (C entry)
+ * @param page Page (0 ~ OLED_BUS_PAGES-1)
+ * @param x1 First column
+ * @param x2 End column, exclusive
+ * @param row The whole page row (OLED_BUS_COLUMNS bytes), only the span is read
+ * @return true if queued or merged, false if dropped (queue full)
+ */
+bool OledBus_Page(uint8_t page, uint8_t x1, uint8_t x2, const uint8_t* row);
+
+#ifdef __cplusplus
+}
+
+/**
+ * @class OledBus
+ * @brief Queued, DMA-driven SSD1306 transfers on I2C1
+ */
+class OledBus {
+    public:
+        /**
+         * @brief Construct a new OledBus object
+         */
+        OledBus();
+
+        /**
+         * @brief Queue a command sequence
+         * @param cmds Command bytes (with their arguments)
+         * @param len Number of bytes (1 ~ OLED_BUS_CMD_MAX)
+         * @return true if queued, false if dropped (queue full)
+         */
+        bool cmds(const uint8_t* cmds, uint8_t len);
+
+        /**
+         * @brief Queue a column span of a display page, merged with a waiting job of the same page
+         * @param page Page (0 ~ OLED_BUS_PAGES-1)
+         * @param x1 First column
+         * @param x2 End column, exclusive
+         * @param row The whole page row (OLED_BUS_COLUMNS bytes), only the span is read
+         * @return true if queued or merged, false if dropped (queue full)
+         *
+         * A merged span grows to cover both, its bytes are taken from row.
+         */
+        bool page(uint8_t page, uint8_t x1, uint8_t x2, const uint8_t* row);
+
+        /**
+         * @brief Check whether all jobs are sent
+         * @return true if the queue is empty and the bus idle
+         */
+        bool isIdle();
+
+        /**
+         * @brief Wait until all jobs are sent (before power off or a reset)
+         * @param timeout_ms Max wait
+         * @return true if idle, false on timeout
+         */
+        bool wait(uint32_t timeout_ms);
+
+        /**
+         * @brief Restart the queue after a failed start or a transfer error (call periodically)
+         */
+        void poll();
+
+        /**
+         * @brief Get number of sent transactions since boot
+         * @return uint32_t Job count
+         */
+        inline uint32_t getJobs() { return _jobs; }
+
+        /**
+         * @brief Get number of page submissions merged into a waiting job
+         * @return uint32_t Merge count
+         */
+        inline uint32_t getMerged() { return _merged; }
+
+        /**
+         * @brief Get number of dropped submissions (queue full)
+         * @return uint32_t Drop count
+         */
+        inline uint32_t getDropped() { return _dropped; }
+
+    private:
+        /**
+         * @brief Queued job
+         */
+        struct Job {
+            uint8_t page;               // Page of a page job, OLED_BUS_PAGES for a command job
+            uint8_t len;                // Command bytes
+            uint8_t cmds[OLED_BUS_CMD_MAX];
+        };
+
+        Job _queue[OLED_BUS_QUEUE_LEN];
+        volatile uint8_t _head;         // Free running write index (producer only)
+        volatile uint8_t _tail;         // Free running read index (consumer: I2C interrupt, poll() masked)
+        volatile bool _busy;            // A transfer is in flight
+        volatile uint16_t _txLen;       // Bytes of the pending transaction in _tx, 0 if none
+        uint8_t _txPage;                // Page of the pending transaction, OLED_BUS_PAGES for commands
+        uint8_t _retries;               // Sends of the pending transaction that failed
+
+        uint8_t _rows[OLED_BUS_PAGES][OLED_BUS_COLUMNS];   // Staging rows of the page jobs
+        uint8_t _spanStart[OLED_BUS_PAGES];                // Waiting span, OLED_BUS_COLUMNS if none
+        uint8_t _spanEnd[OLED_BUS_PAGES];                  // End column, exclusive
+        bool _queued[OLED_BUS_PAGES];                      // A page job of this page is waiting
+
+        uint8_t _tx[OLED_BUS_WINDOW_CMD_LEN * 2 + 1 + OLED_BUS_COLUMNS];    // Pending transaction
+
+        uint32_t _jobs;
+        uint32_t _merged;
+        uint32_t _dropped;
+
+        Job* _push();
+        void _kick();
+        void _startNext();
+
+        friend void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c); // Friend function for interrupt handling
+};
+
+extern OledBus oledBus;
+
+#endif
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "cpp_main.h"
+#include "dwt.h"
 
 #define ADC_PAD_HIT_DEFAULT_THRESHOLD 1000 // Default threshold for pad hit detection
 #define ADC_PAD_DEFAULT_UPPER_LIMIT 4095   // Default upper limit for ADC readings
@@ -144,6 +145,30 @@ class Pad {
          */
         inline void resetMeasurementCplt() { _measurement_cplt = false; }
 
+        /**
+         * @brief Check if a force measurement window is currently open
+         * @return true if the pad is between hit onset and measurement completion
+         */
+        inline bool isMeasuring() { return _adc_measuring; }
+
+        /**
+         * @brief Get the hit onset timestamp of the last/current measurement
+         * @return uint32_t DWT cycle count captured when the hit was detected
+         */
+        inline uint32_t getHitCycles() { return _hit_cycles; }
+
+        /**
+         * @brief Get the peak ADC value of the last completed measurement
+         * @return uint16_t Peak (raw ADC value)
+         */
+        inline uint16_t getLastPeak() { return _last_peak; }
+
+        /**
+         * @brief Get the measuring window length of the last completed measurement
+         * @return uint16_t Window length in ms (onset to completion)
+         */
+        inline uint16_t getLastWindowMs() { return _last_window_ms; }
+
         /**
          * @brief Get the velocity value (same as force)
          * @return uint8_t Velocity value (0-127)
@@ -167,6 +192,36 @@ class Pad {
          */
         inline void setForceCurve(ForceMappingCurve curve) { _force_curve = curve; }
 
+        /**
+         * @brief Get the force mapping curve type
+         * @return ForceMappingCurve Current curve
+         */
+        inline ForceMappingCurve getForceCurve() { return _force_curve; }
+
+        /**
+         * @brief Get the hit detection threshold
+         * @return uint16_t Threshold (raw ADC value)
+         */
+        inline uint16_t getHitThreshold() { return _hit_threshold; }
+
+        /**
+         * @brief Set the hit detection threshold
+         * @param threshold Threshold (raw ADC value, should stay below the upper limit)
+         */
+        inline void setHitThreshold(uint16_t threshold) { _hit_threshold = threshold; }
+
+        /**
+         * @brief Get the upper limit (ADC value mapped to velocity 127)
+         * @return uint16_t Upper limit (raw ADC value)
+         */
+        inline uint16_t getUpperLimit() { return _upper_limit; }
+
+        /**
+         * @brief Set the upper limit (ADC value mapped to velocity 127)
+         * @param limit Upper limit (raw ADC value, 0-4095)
+         */
+        inline void setUpperLimit(uint16_t limit) { _upper_limit = limit; }
+
         /**
          * @brief Set the output pin state
          * @param state GPIO_PinState to set (GPIO_PIN_SET or GPIO_PIN_RESET)
@@ -199,6 +254,15 @@ class Pad {
          */
         static const char* ID2Str(PadID id);
 
+        /**
+         * @brief Copy the current raw ADC value of every pad, straight from the DMA buffers
+         * @param out Destination, PAD_NUM values in PadID order
+         * 
+         * Relies on the pad wiring in cpp_main.cpp following PadID order
+         * (ADC1: 0-3, ADC2: 4-6, ADC3: 7-9).
+         */
+        static void readAll(uint16_t* out);
+
     private:
         ADCGroup _piezo_adc_group;              // ADC group this pad belongs to
         uint8_t _piezo_adc_index;               // Index of this pad in its ADC group
@@ -223,6 +287,9 @@ class Pad {
         bool _measurement_cplt;                 // Flag indicating measurement window completed
         uint32_t _adc_measuring_start_time;     // Timestamp when ADC measuring started
         uint32_t _last_adc_measuring_state;     // Last state of ADC measuring (for timing)
+        uint32_t _hit_cycles;                   // DWT timestamp of hit onset (for ordering simultaneous hits)
+        uint16_t _last_peak;                    // Peak of the last completed measurement
+        uint16_t _last_window_ms;               // Window length of the last completed measurement
 
         /**
          * @brief Map raw ADC value to force value (0-127)
@@ -232,3 +299,5 @@ class Pad {
         uint8_t _force_map(uint16_t val);
 
 };
+
+extern Pad* pads[Pad::PAD_NUM]; // All pad instances, indexed by PadID
@@ -0,0 +1,150 @@
+/**
+ * @file profiler.h
+ * @brief Cycle-accurate scope profiler based on the DWT cycle counter
+ *
+ * This file defines the Profiler class. Code regions are measured with
+ * named scopes:
+ *
+ *     PROF_SCOPE(PAD_SCAN);   // Measures until the end of the enclosing block
+ *
+ * Every sample goes into a fixed-size log-scale histogram (4 buckets per
+ * octave, at most 25% bucket width), which gives min/avg/max exactly
+ * and p99 with bucket resolution, without storing samples.
+ *
+ * With PROFILER_ENABLE set to 0 the PROF_ macros expand to nothing, so
+ * instrumented code carries no overhead at all.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+#include "dwt.h"
+
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE 1               // 0 compiles all PROF_ macros out
+#endif
+
+#define PROF_HIST_MIN_SHIFT 5           // Samples below 2^5 cycles go into bucket 0
+#define PROF_HIST_OCTAVES 20            // Octaves covered (up to 2^25 cycles, ~200 ms at 168 MHz)
+#define PROF_HIST_SUB 4                 // Buckets per octave
+#define PROF_HIST_BUCKETS (1 + PROF_HIST_OCTAVES * PROF_HIST_SUB)
+
+/**
+ * @class Profiler
+ * @brief Per scope cycle histograms
+ */
+class Profiler {
+    public:
+        /**
+         * @brief Profiled scopes
+         */
+        enum Scope {
+            PAD_SCAN,           // Pad scan task (all pads)
+            MEASURE_FORCE,      // One Pad::measureForce() call
+            MIDI_SEND,          // One Note On burst on the wire
+            AUTO_NOTE_OFF,      // Midi::autoNoteOff()
+            UI_SHOW,            // One UI::update() slice
+            OLED_FLUSH,         // One OLED page transfer (clear or frame buffer)
+            SCOPE_NUM
+        };
+
+        /**
+         * @brief Summary of one scope
+         */
+        struct Summary {
+            uint32_t count;     // Samples
+            uint32_t min;       // Cycles
+            uint32_t avg;       // Cycles
+            uint32_t p99;       // Cycles (bucket upper bound, clamped to max)
+            uint32_t max;       // Cycles
+        };
+
+        /**
+         * @brief Construct a new Profiler object
+         */
+        Profiler();
+
+        /**
+         * @brief Record one sample
+         * @param scope Scope
+         * @param cycles Duration in CPU cycles
+         */
+        void record(Scope scope, uint32_t cycles);
+
+        /**
+         * @brief Get min/avg/p99/max of a scope
+         * @param scope Scope
+         * @return Summary Summary (all zero if no sample yet)
+         */
+        Summary getSummary(Scope scope);
+
+        /**
+         * @brief Get a percentile of a scope
+         * @param scope Scope
+         * @param permille Percentile in 1/1000 (990 = p99)
+         * @return uint32_t Cycles (bucket upper bound, clamped to max)
+         */
+        uint32_t getPercentile(Scope scope, uint16_t permille);
+
+        /**
+         * @brief Convert scope to string
+         * @param scope Scope
+         * @return const char* Scope name
+         */
+        static const char* Scope2Str(Scope scope);
+
+        /**
+         * @brief Clear all histograms
+         */
+        void reset();
+
+        /**
+         * @brief Print all scopes to the debug UART (cycles)
+         */
+        void dumpStats();
+
+    private:
+        struct Hist {
+            uint32_t count;
+            uint32_t min;
+            uint32_t max;
+            uint64_t sum;
+            uint32_t bucket[PROF_HIST_BUCKETS];
+        };
+
+        Hist _hist[SCOPE_NUM];
+
+        static uint8_t _bucketOf(uint32_t cycles);
+        static uint32_t _bucketUpper(uint8_t bucket);
+};
+
+/**
+ * @class ProfileScope
+ * @brief Measures from construction to destruction (use PROF_SCOPE)
+ */
+class ProfileScope {
+    public:
+        inline explicit ProfileScope(Profiler::Scope scope) : _scope(scope), _start(DWT_GetCycles()) {}
+        inline ~ProfileScope();
+
+    private:
+        Profiler::Scope _scope;
+        uint32_t _start;
+};
+
+extern Profiler profiler;
+
+inline ProfileScope::~ProfileScope() {
+    profiler.record(_scope, DWT_GetCycles() - _start);
+}
+
+#if PROFILER_ENABLE
+#define PROF_SCOPE(scope) ProfileScope _prof_scope_##scope(Profiler::scope)
+#else
+#define PROF_SCOPE(scope) ((void)0)
+#endif
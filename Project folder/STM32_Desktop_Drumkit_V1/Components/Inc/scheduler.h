@@ -0,0 +1,148 @@
+/**
+ * @file scheduler.h
+ * @brief Prioritised cooperative task scheduler
+ *
+ * This file defines the Scheduler class which replaces the single main loop
+ * with rate-controlled tasks (pad scan, MIDI output, button tick, UI ...).
+ *
+ * - Periodic tasks are released every period_us (DWT timebase)
+ * - Event tasks are released when their ready() predicate returns true
+ * - Among released tasks the lowest priority number runs first
+ * - A task function runs one slice and returns true if its job is not done
+ *   yet; it is called again (still released) until it returns false. Long
+ *   jobs such as an OLED flush are split this way.
+ *
+ * Nothing is preempted, so a slice should stay well below the period of
+ * the fastest task. Per task the scheduler records slice count, worst-case
+ * slice time (WCET) and deadline misses (a periodic job still unfinished at
+ * its next release, or a release more than one period late).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+#include "dwt.h"
+
+#define SCHED_MAX_TASKS 8               // Max registered tasks
+
+/**
+ * @class Scheduler
+ * @brief Cooperative run-to-completion scheduler with resumable tasks
+ */
+class Scheduler {
+    public:
+        typedef bool (*TaskFunc)(void);     // Runs one slice, returns true if more work is pending
+        typedef bool (*ReadyFunc)(void);    // Event task release condition
+
+        /**
+         * @brief Per task runtime statistics
+         */
+        struct TaskStats {
+            uint32_t jobs;              // Completed jobs
+            uint32_t slices;            // Executed slices
+            uint32_t misses;            // Deadline misses
+            uint32_t wcet_cycles;       // Worst-case slice time (CPU cycles)
+            uint32_t last_cycles;       // Last slice time (CPU cycles)
+            uint64_t total_cycles;      // Sum of slice times (CPU cycles)
+        };
+
+        /**
+         * @brief Construct a new Scheduler object
+         */
+        Scheduler();
+
+        /**
+         * @brief Register a periodic task
+         * @param name Task name (for stats output)
+         * @param fn Task function
+         * @param period_us Release period in microseconds
+         * @param priority Priority, 0 is the highest
+         * @return int8_t Task index, -1 if the task table is full
+         */
+        int8_t addPeriodic(const char* name, TaskFunc fn, uint32_t period_us, uint8_t priority);
+
+        /**
+         * @brief Register an event task
+         * @param name Task name (for stats output)
+         * @param fn Task function
+         * @param ready Release condition, polled when the task is idle
+         * @param priority Priority, 0 is the highest
+         * @return int8_t Task index, -1 if the task table is full
+         */
+        int8_t addEvent(const char* name, TaskFunc fn, ReadyFunc ready, uint8_t priority);
+
+        /**
+         * @brief Release due tasks and run one slice of the highest priority one
+         * @return true if a slice was run, false if all tasks were idle
+         *
+         * Call from the main loop as often as possible.
+         */
+        bool runOnce();
+
+        /**
+         * @brief Get number of registered tasks
+         * @return uint8_t Task count
+         */
+        inline uint8_t getTaskCount() { return _task_count; }
+
+        /**
+         * @brief Get task name
+         * @param index Task index
+         * @return const char* Name ("" if out of range)
+         */
+        const char* getTaskName(uint8_t index);
+
+        /**
+         * @brief Get task statistics
+         * @param index Task index (must be < getTaskCount())
+         * @return const TaskStats& Statistics
+         */
+        inline const TaskStats& getTaskStats(uint8_t index) { return _tasks[index].stats; }
+
+        /**
+         * @brief Get CPU cycles spent in runOnce() without running a task
+         * @return uint64_t Idle cycles
+         */
+        inline uint64_t getIdleCycles() { return _idle_cycles; }
+
+        /**
+         * @brief Reset statistics of all tasks
+         */
+        void resetStats();
+
+        /**
+         * @brief Print task statistics to the debug UART
+         */
+        void dumpStats();
+
+    private:
+        /**
+         * @brief Task control block
+         */
+        struct Task {
+            const char* name;
+            TaskFunc fn;
+            ReadyFunc ready;            // nullptr for periodic tasks
+            uint32_t period_cycles;     // 0 for event tasks
+            uint32_t next_release;      // DWT timestamp of the next release
+            uint8_t priority;
+            bool active;                // Released and job not finished
+            TaskStats stats;
+        };
+
+        Task _tasks[SCHED_MAX_TASKS];
+        uint8_t _task_count;
+        uint32_t _idle_since;           // DWT timestamp when the scheduler went idle
+        bool _idle;
+        uint64_t _idle_cycles;
+
+        int8_t _add(const char* name, TaskFunc fn, ReadyFunc ready, uint32_t period_cycles, uint8_t priority);
+        void _release(uint32_t now);
+};
+
+extern Scheduler scheduler;
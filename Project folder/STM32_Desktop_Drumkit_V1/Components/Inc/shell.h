@@ -0,0 +1,99 @@
+/**
+ * @file shell.h
+ * @brief Serial command shell on the debug UART (USART1 RX)
+ *
+ * This file defines the Shell class for live parameter tuning from a
+ * terminal (115200 8N1, no local echo needed, lines end with CR and/or LF).
+ * USART1 RX runs as a circular DMA into a ring buffer, poll() feeds newly
+ * arrived bytes to ShellParser and runs at most one command per call.
+ * Replies are INFO log lines on the same UART, so they are muted like any
+ * other log output while the wave stream is running.
+ *
+ *     help                         List commands
+ *     pad                          Show threshold, limit and curve of all pads
+ *     pad <pad> thr <n>            Set hit threshold (raw ADC, below the limit)
+ *     pad <pad> lim <n>            Set upper limit (raw ADC, 1-4095)
+ *     curve <pad> lin|log|exp      Set force mapping curve
+ *     stats                        Task, log, trace and MIDI counters
+ *     prof [reset]                 Profiler summary (or clear it)
+ *     trace dump                   Dump the hit flight recorder (see hitrec.h)
+ *     stream on|off                Raw ADC wave stream (see wavestream.h)
+ *     capture on|off               Hit waveform capture (see hitcapture.h)
+ *     health [reset]               Loop rate and fault counters (see health.h)
+ *
+ * <pad> is the name shown on the pad page (kick, snare, ophihat, ...), its
+ * index or "all". Keywords are case insensitive. Changes act on the live
+ * Pad objects at once and are not stored.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+#include "shell_parser.h"
+
+#define SHELL_RX_BUF_SIZE 128           // USART1 RX DMA ring size (bytes, ~11 ms at 115200)
+#define SHELL_POLL_BUDGET 32            // Max bytes parsed per poll() call
+
+/**
+ * @class Shell
+ * @brief Command shell on USART1 RX
+ */
+class Shell {
+    public:
+        /**
+         * @brief Construct a new Shell object
+         */
+        Shell();
+
+        /**
+         * @brief Start circular DMA reception on USART1
+         */
+        void begin();
+
+        /**
+         * @brief Parse received bytes and run a complete command (call in main loop)
+         * @param idle true if no hit is in flight, commands are held back otherwise
+         *
+         * Parses at most SHELL_POLL_BUDGET bytes and runs at most one command
+         * per call, so a pasted script cannot hog the loop.
+         */
+        void poll(bool idle);
+
+        /**
+         * @brief Get number of commands run
+         * @return uint32_t Command count
+         */
+        inline uint32_t getCommands() { return _commands; }
+
+        /**
+         * @brief Get number of RX restarts (UART error or baud rate change)
+         * @return uint32_t Restart count
+         */
+        inline uint32_t getRxRestarts() { return _rx_restarts; }
+
+        /**
+         * @brief Get parser statistics
+         * @return const ShellParser::Stats& Statistics
+         */
+        inline const ShellParser::Stats& getParserStats() { return _parser.getStats(); }
+
+    private:
+        uint8_t _rx_buf[SHELL_RX_BUF_SIZE];     // DMA ring buffer (written by DMA only)
+        uint16_t _rx_tail;                      // Next index to parse
+        bool _started;                          // begin() called
+        bool _pending;                          // Complete line waiting for an idle poll
+
+        ShellParser _parser;
+        uint32_t _commands;
+        uint32_t _rx_restarts;
+
+        void _startRx();
+        void _execute(uint8_t argc, const char* const* argv);
+};
+
+extern Shell shell;
@@ -0,0 +1,107 @@
+/**
+ * @file shell_parser.h
+ * @brief Incremental line parser for the serial command shell
+ *
+ * This file defines the ShellParser class which collects bytes into a line
+ * and splits it into whitespace separated words. Lines may arrive split
+ * across any number of feed() calls and end with CR, LF or CR LF.
+ * Backspace / DEL edit the line, other control bytes and non-ASCII bytes
+ * are ignored, a line longer than the buffer is discarded as a whole.
+ *
+ * The parser has no hardware dependency, so it can also be fed on the host.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define SHELL_LINE_MAX 64               // Max line length (bytes, without line ending)
+#define SHELL_ARGS_MAX 6                // Max words per line (extra words are dropped)
+
+/**
+ * @class ShellParser
+ * @brief Byte-by-byte command line parser
+ *
+ * feed() returns true once per complete, non-empty line; the words are
+ * then available through getArgc() / getArgv() until the next feed().
+ */
+class ShellParser {
+    public:
+        /**
+         * @brief Parser statistics
+         */
+        struct Stats {
+            uint32_t lines;             // Complete lines returned
+            uint32_t overflow;          // Lines discarded (longer than SHELL_LINE_MAX)
+            uint32_t ignored;           // Control / non-ASCII bytes ignored
+        };
+
+        /**
+         * @brief Construct a new ShellParser object
+         */
+        ShellParser();
+
+        /**
+         * @brief Parse one byte
+         * @param byte Received byte
+         * @return true if a line is complete (words valid until the next call)
+         */
+        bool feed(uint8_t byte);
+
+        /**
+         * @brief Drop the partial line
+         */
+        void reset();
+
+        /**
+         * @brief Get number of words of the last complete line
+         * @return uint8_t Word count (1 ... SHELL_ARGS_MAX)
+         */
+        inline uint8_t getArgc() { return _argc; }
+
+        /**
+         * @brief Get the words of the last complete line
+         * @return const char* const* Zero terminated words
+         */
+        inline const char* const* getArgv() { return _argv; }
+
+        /**
+         * @brief Get parser statistics
+         * @return const Stats& Statistics since construction
+         */
+        inline const Stats& getStats() { return _stats; }
+
+        /**
+         * @brief Compare a word with a keyword, ignoring case
+         * @param word Word from the line
+         * @param keyword Keyword
+         * @return true if equal
+         */
+        static bool match(const char* word, const char* keyword);
+
+        /**
+         * @brief Parse an unsigned decimal number
+         * @param word Word from the line
+         * @param out Result (untouched on error)
+         * @return true if the whole word is a number up to 65535
+         */
+        static bool toUInt16(const char* word, uint16_t* out);
+
+    private:
+        char _line[SHELL_LINE_MAX + 1]; // Line being collected, split in place on completion
+        uint8_t _len;                   // Bytes collected
+        bool _overflow;                 // Current line did not fit, discard up to the line ending
+        bool _split;                    // _line holds the words of the last line, clear on next byte
+
+        const char* _argv[SHELL_ARGS_MAX];
+        uint8_t _argc;
+
+        Stats _stats;
+
+        bool _endLine();
+};
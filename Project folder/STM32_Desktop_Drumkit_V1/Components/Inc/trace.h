@@ -0,0 +1,170 @@
+/**
+ * @file trace.h
+ * @brief Binary deferred-formatting trace on the debug UART
+ *
+ * This file defines the Tracer class. A trace call does not format
+ * anything on the target: it writes a short binary record (format string
+ * ID, timestamp, raw integer arguments) into the logger ring, and the host
+ * tool Tools/trace_decode.py rebuilds the text from the firmware ELF.
+ *
+ *     TRACE_D("Hit pad %u v%u", id, velocity);  // ~8 bytes instead of ~16
+ *
+ * The format strings are placed in the trace_fmt section, which the linker
+ * script keeps in the ELF as a non-loaded (INFO) section, so they cost no
+ * flash. The ID of a string is its offset from __start_trace_fmt (the
+ * section start, also provided by the linker where no script places the
+ * section), so the same decoder works for the target and the host
+ * simulator, which links the strings among its data.
+ *
+ * Records and text log lines share the USART1 stream. Text is 7-bit ASCII,
+ * records start with a byte >= 0x80 and have a self-describing length:
+ *
+ *     tag   1 byte   bit 7: 1, bit 6: absolute time, bits 5-4: level - 1,
+ *                    bit 3: 0, bits 2-0: argument count (0 ... 7)
+ *     id    2 bytes  Format string offset in trace_fmt (little endian)
+ *     time  4 bytes  DWT cycles (little endian) if absolute,
+ *                    else varint of the cycles since the previous record
+ *     args  varint   One per argument (uint32 bit pattern)
+ *
+ * Varints are LEB128: 7 bits per byte, least significant first, bit 7 set
+ * on all bytes but the last. Records are never split, a dropped record makes
+ * the next one absolute.
+ *
+ * Binary blocks (writeBlock(), e.g. hit captures) use tag 0x88:
+ *
+ *     0x88 | type (1 byte, TRACE_BLOCK_x) | length (2 bytes) | payload
+ *
+ * Only integer (and enum) arguments are supported, "%s" is not: the host
+ * cannot read target memory. Same threading rule as the logger: thread mode only.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+#include "logger.h"
+#include <type_traits>
+
+#define TRACE_MAX_ARGS 7                // Argument count field is 3 bits
+#define TRACE_ABS_EVERY 64              // Absolute timestamp at least every N records (host can join mid-stream)
+#define TRACE_RECORD_MAX (1 + 2 + 5 + TRACE_MAX_ARGS * 5)
+
+#define TRACE_BLOCK_TAG 0x88
+#define TRACE_BLOCK_CAPTURE 0x01        // Hit waveform capture (hitcapture.h)
+
+extern "C" const char __start_trace_fmt[]; // Start of the format strings (linker)
+
+/**
+ * @brief Pack two 12-bit samples into 3 bytes (little endian, as in the wave stream)
+ * @param p Destination (3 bytes)
+ * @param a First sample
+ * @param b Second sample
+ */
+static inline void Trace_Pack12(uint8_t* p, uint16_t a, uint16_t b) {
+    p[0] = (uint8_t)a;
+    p[1] = (uint8_t)(((a >> 8) & 0x0F) | (b << 4));
+    p[2] = (uint8_t)(b >> 4);
+}
+
+/**
+ * @class Tracer
+ * @brief Binary record encoder on top of the logger ring
+ */
+class Tracer {
+    public:
+        /**
+         * @brief Construct a new Tracer object
+         */
+        Tracer();
+
+        /**
+         * @brief Encode and queue one record (use the TRACE_ macros)
+         * @param level LOG_LVL_ERROR ... LOG_LVL_DEBUG
+         * @param fmt Format string placed in trace_fmt (never read on the target)
+         * @param args Integer arguments
+         */
+        template<typename... Args>
+        inline void emit(uint8_t level, const char* fmt, Args... args) {
+            static_assert(sizeof...(Args) <= TRACE_MAX_ARGS, "Too many trace arguments");
+            if (level == LOG_LVL_NONE || level > logger.getLevel()) { return; }
+
+            const uint32_t argv[sizeof...(Args) + 1] = { _arg(args)..., 0 };
+            _emit(level, (uint16_t)((uintptr_t)fmt - (uintptr_t)__start_trace_fmt), argv, sizeof...(Args));
+        }
+
+        /**
+         * @brief Queue a binary block as a whole (header and payload)
+         * @param type TRACE_BLOCK_x
+         * @param payload Payload
+         * @param len Payload length
+         * @return true if queued, false if the ring has no room or the log is muted
+         */
+        bool writeBlock(uint8_t type, const uint8_t* payload, uint16_t len);
+
+        /**
+         * @brief Get number of records written
+         * @return uint32_t Record count
+         */
+        inline uint32_t getRecords() { return _records; }
+
+        /**
+         * @brief Get number of records dropped (logger ring full)
+         * @return uint32_t Dropped record count
+         */
+        inline uint32_t getDropped() { return _dropped; }
+
+    private:
+        uint32_t _last_cycles;      // Timestamp of the previous record
+        uint8_t _since_abs;         // Records since the last absolute timestamp
+        bool _resync;               // Next record carries an absolute timestamp
+
+        uint32_t _records;
+        uint32_t _dropped;
+
+        template<typename T>
+        static inline uint32_t _arg(T value) {
+            static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                          "Trace arguments must be integers");
+            return (uint32_t)value;
+        }
+
+        void _emit(uint8_t level, uint16_t id, const uint32_t* argv, uint8_t argc);
+};
+
+extern Tracer tracer;
+
+/**
+ * @brief Place the format string in trace_fmt and emit a record
+ */
+#define _TRACE(level, fmt, ...) do { \
+    static const char _trace_fmt[] __attribute__((section("trace_fmt"), used)) = fmt; \
+    tracer.emit(level, _trace_fmt, ##__VA_ARGS__); \
+} while (0)
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_ERROR
+#define TRACE_E(fmt, ...) _TRACE(LOG_LVL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define TRACE_E(fmt, ...) ((void)0)
+#endif
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_WARN
+#define TRACE_W(fmt, ...) _TRACE(LOG_LVL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define TRACE_W(fmt, ...) ((void)0)
+#endif
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_INFO
+#define TRACE_I(fmt, ...) _TRACE(LOG_LVL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define TRACE_I(fmt, ...) ((void)0)
+#endif
+
+#if LOG_BUILD_LEVEL >= LOG_LVL_DEBUG
+#define TRACE_D(fmt, ...) _TRACE(LOG_LVL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define TRACE_D(fmt, ...) ((void)0)
+#endif
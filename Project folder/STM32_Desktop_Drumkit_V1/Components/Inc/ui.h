@@ -24,6 +24,19 @@ extern "C" {
 #include "oled_menu.h"
 }
 
+#define UI_PAGE_LINES 4             // Display pages (8 px text lines) on the 32 px OLED, one per update() slice
+
+// Frame rate governor (see UI::update())
+#define UI_MENU_FPS 25              // Menu frame rate (the UI task runs at 25 Hz)
+#define UI_PAGE_FPS 2               // Page mode refresh rate
+#define UI_PLAYING_MENU_FPS 8       // Menu frame rate while the pads are played
+#define UI_PLAYING_PAGE_FPS 1       // Page mode refresh rate while the pads are played
+#define UI_PLAYING_HIT_RATE 6       // Hits per second from which on the pads count as played
+#define UI_HIT_WINDOW_MS 500        // Hit rate measuring window
+#define UI_PLAYING_HOLD_MS 2000     // Keep the low rates this long after the last busy window
+#define UI_CPU_BUDGET_PCT 5         // Max share of CPU time for rendering (frame cost / frame interval)
+#define UI_MENU_SETTLED_MS 250      // Redraw period of a settled menu (values changed outside the menu)
+
 /**
  * @brief UI management class for drumkit
  * 
@@ -50,7 +63,9 @@ class UI {
             MAIN,         ///< Main status page
             PAD_TEST,     ///< Pad test page
             PAD_SETTING,  ///< Pad configuration page
-            STATS         ///< Statistics page
+            STATS,        ///< Statistics page
+            PROFILER,     ///< Profiler page
+            HEALTH        ///< Health counters page
         };
 
         /**
@@ -82,7 +97,7 @@ class UI {
 
         /**
          * @brief Process button input
-         * Should be called periodically
+         * Should be called periodically (1 kHz button task)
          */
         void buttonTick();
 
@@ -110,10 +125,13 @@ class UI {
         void init();
 
         /**
-         * @brief Update display
-         * Should be called periodically
+         * @brief Update display (one slice)
+         * @return true if the current refresh is not finished yet, call again
+         * 
+         * Resumable: a refresh is split into slices of at most one display
+         * page, so it can be interleaved with the pad scan (see Scheduler).
          */
-        void update();
+        bool update();
 
         /**
          * @brief Show welcome screen
@@ -127,39 +145,101 @@ class UI {
          */
         void updatePadStats(Pad::PadID padID, uint32_t hits);
 
-        /**
-         * @brief Update MIDI statistics
-         */
-        void updateMidiStats();
-
         /**
          * @brief Update MIDI connection status
          * @param connected true if connected, false otherwise
          */
         void updateMidiConn(bool connected);
 
+        /**
+         * @brief Get the current target frame rate of the governor (after the CPU budget limit)
+         * @return uint8_t Frames per second
+         */
+        inline uint8_t getFrameRate() { return (uint8_t)(1000 / _frameInterval); }
+
+        /**
+         * @brief Get the CPU time of the last complete frame (all slices)
+         * @return uint32_t Time in us
+         */
+        inline uint32_t getFrameCostUs() { return _frameCostUs; }
+
+        /**
+         * @brief Check whether the governor runs the low (playing) rates
+         * @return true if the hit rate was above UI_PLAYING_HIT_RATE recently
+         */
+        inline bool isPlaying() { return _playing; }
+
+        /**
+         * @brief Get number of rendered frames since boot
+         * @return uint32_t Frame count
+         */
+        inline uint32_t getFrames() { return _frames; }
+
+        /**
+         * @brief Get number of due frames postponed because the OLED bus was still sending
+         * @return uint32_t Postponed frame count
+         */
+        inline uint32_t getBusSkips() { return _busSkips; }
+
+        /**
+         * @brief Get number of due menu frames not drawn because the menu had settled
+         * @return uint32_t Skipped frame count
+         */
+        inline uint32_t getSettledSkips() { return _settledSkips; }
+
         // Pointers to menus
         // Menutypedef* _currentMenu; // This is managed by oled-menu internally
         Menutypedef* _mainMenu;
         Menutypedef* _settingsMenu;
+        Menutypedef* _midiMapMenu;
         Menutypedef* _statsMenu;
         Menutypedef* _aboutMenu;
 
     private:
         OneButtonTiny _button = OneButtonTiny(KEY_PRESS_GPIO_Port, KEY_PRESS_Pin, true);
-        OLED _oled = OLED(&hi2c1, 32); // OLED instance to draw page content
+        OLED _oled;                 // Page content front end of the shared display core
 
         volatile bool _isPowerOn;
 
         bool _midiConnected;
-        bool _ledEffectsEnabled;
-        bool _buzzerEnabled;
-        bool _debugLogEnabled;
+        int _ledEffectsEnabled;         // Settings switches (int because menu switch controls bind int*)
+        int _buzzerEnabled;
+        int _debugLogEnabled;           // Logger level: DEBUG when on, INFO when off
+        int _waveStreamEnabled;         // Raw ADC streaming on the debug UART (mutes the log)
+        int _hitCaptureEnabled;         // Pre-trigger waveform capture of each hit
+        int _waveStreamSynced;          // Switch values at last sync (a difference means the
+        int _hitCaptureSynced;          // user toggled it, otherwise the shell side wins)
 
         DisplayMode _mode;
         DisplayMode _prevMode;
         Page _page;
 
+        /**
+         * @brief Refresh state of the resumable update()
+         */
+        enum class Step : uint8_t {
+            IDLE,   ///< No refresh in progress
+            RENDER, ///< Rendering page mode text lines
+            FLUSH   ///< Sending the menu frame buffer
+        };
+        Step _step;
+        uint8_t _slice;             // Display page handled by the next slice
+
+        // Frame rate governor
+        uint16_t _frameInterval;    // Frame interval of the current mode and load (ms)
+        bool _playing;              // Hit rate above UI_PLAYING_HIT_RATE recently
+        bool _frameForced;          // Render the next frame regardless of the interval (mode change)
+        uint16_t _windowHits;       // Hits in the current measuring window
+        uint32_t _windowStart;      // Tick of the measuring window start
+        uint32_t _playingTick;      // Tick of the last busy window
+        uint32_t _lastFrame;        // Tick of the last frame start
+        uint32_t _frameCycles;      // CPU cycles of the frame in progress
+        uint32_t _frameCostUs;      // CPU time of the last complete frame
+        uint32_t _frames;
+        uint32_t _busSkips;
+        uint32_t _settledSkips;
+        uint32_t _lastMenuDraw;     // Tick of the last drawn menu frame
+
         // Pad数据
         const Pad** _pads;
 
@@ -168,7 +248,6 @@ class UI {
         uint32_t _totalHitsAll;
         // uint32_t _sumForce[Pad::PAD_NUM];
         // uint8_t _avgForce[Pad::PAD_NUM];
-        uint32_t _totalDataSent;
 
         // Pad Settings (not implemented yet)
         uint8_t _selectedPadID;
@@ -176,23 +255,45 @@ class UI {
         uint16_t _padThresholds[Pad::PAD_NUM];
         uint16_t _padUpperLimits[Pad::PAD_NUM];
 
-        void _show();
+        // MIDI note map editor (int because menu slider controls bind int*)
+        int _mapPreset;                 // Selected note map preset
+        int _mapEditPad;                // Pad being edited
+        int _mapEditNote;               // Note of the edited pad
+        int _mapEditChannel;            // Channel of the edited pad
+        int _mapSyncedPreset;           // Editor values at last sync (a difference means the
+        int _mapSyncedPad;              // user changed it in the menu, otherwise the MIDI side
+        int _mapSyncedNote;             // wins, e.g. after a SysEx bulk write)
+        int _mapSyncedChannel;
+
 
         void _initMenuPointers();
         void _createMainMenu();
         void _createSettingsMenu();
+        void _createMidiMapMenu();
+        void _syncNoteMap();
+        void _syncSwitches();
         void _createAboutMenu();
 
-        void _showMainPage();
-        void _showPadTestPage();
-        void _showPadSettingPage();
-        void _showStatsPage();
+        bool _updateSlice();
+        bool _frameDue();
+        void _updateFrameRate(uint32_t now);
+
+        void _showPageLine(uint8_t line);
+        void _showMainPage(uint8_t line);
+        void _showPadTestPage(uint8_t line);
+        void _showPadSettingPage(uint8_t line);
+        void _showStatsPage(uint8_t line);
+        void _showProfilerPage(uint8_t line);
+        void _showHealthPage(uint8_t line);
 
         friend void Callback_HomeMenuItem();
         friend void Callback_PadTestMenuItem();
         friend void Callback_PadSettingMenuItem();
         friend void Callback_StatsMenuItem();
+        friend void Callback_ProfilerMenuItem();
+        friend void Callback_HealthMenuItem();
         friend void Callback_PWROFF();
+        friend void Callback_ResetNoteMap();
 
 };
 
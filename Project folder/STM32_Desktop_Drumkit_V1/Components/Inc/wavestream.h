@@ -0,0 +1,110 @@
+/**
+ * @file wavestream.h
+ * @brief Binary ADC waveform streaming on USART1 (calibration aid)
+ *
+ * This file defines the WaveStream class. While streaming, every pad scan
+ * packs the ten raw 12-bit ADC values straight from the acquisition buffers
+ * into one frame and queues it in the logger ring, which USART1 TX DMA
+ * drains at WAVE_STREAM_BAUD. The host tool Tools/wave_decode.py turns
+ * a capture into CSV or a 10 channel WAV file.
+ *
+ * Frame (18 bytes):
+ *
+ *     0xA5 0x5A   Sync
+ *     seq         Frame counter (uint8), incremented for every sampled
+ *                 frame, also the dropped ones, so gaps show lost frames
+ *                 (up to 255 in a row, the total is logged when streaming stops)
+ *     data        15 bytes: 10 x 12-bit samples in Pad::PadID order,
+ *                 two samples per 3 bytes, little endian:
+ *                 b0 = a[7:0], b1 = a[11:8] | b[3:0] << 4, b2 = b[11:4]
+ *
+ * The UART carries frames only while streaming: text log and trace are
+ * muted (logger level NONE) and the baud rate is switched once the ring
+ * has drained, both are restored when streaming stops. A frame that does
+ * not fit into the ring is dropped and counted, pad detection never waits.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "cpp_main.h"
+
+#define WAVE_STREAM_BAUD 2000000        // Streaming baud rate (84 MHz / 42, exact)
+#define WAVE_STREAM_LOG_BAUD 115200     // Baud rate of the text log (usart.c)
+#define WAVE_STREAM_DIVIDER 1           // Send every Nth pad scan (1: ~10 kHz, 180 kB/s)
+
+#define WAVE_SYNC_0 0xA5
+#define WAVE_SYNC_1 0x5A
+#define WAVE_FRAME_SIZE 18
+
+/**
+ * @class WaveStream
+ * @brief Raw ADC frame streamer
+ */
+class WaveStream {
+    public:
+        /**
+         * @brief Construct a new WaveStream object
+         */
+        WaveStream();
+
+        /**
+         * @brief Request streaming on or off (applied by poll())
+         * @param enabled true to stream
+         */
+        inline void setEnabled(bool enabled) { _request = enabled; }
+
+        /**
+         * @brief Check whether streaming is requested
+         * @return true if on (menu switch or shell)
+         */
+        inline bool isEnabled() { return _request; }
+
+        /**
+         * @brief Check whether the UART is owned by the stream (starting, streaming or stopping)
+         * @return true if the text log must stay muted
+         */
+        inline bool isActive() { return _state != State::OFF; }
+
+        /**
+         * @brief Sample the ADC buffers and queue one frame (call from the pad scan)
+         */
+        void sample();
+
+        /**
+         * @brief Apply on/off requests: mute the log, switch the baud rate (call periodically)
+         */
+        void poll();
+
+        /**
+         * @brief Get number of frames queued
+         * @return uint32_t Frame count
+         */
+        inline uint32_t getFrames() { return _frames; }
+
+        /**
+         * @brief Get number of frames dropped (ring full)
+         * @return uint32_t Dropped frame count
+         */
+        inline uint32_t getDropped() { return _dropped; }
+
+    private:
+        enum class State { OFF, STARTING, STREAMING, STOPPING };
+
+        State _state;
+        bool _request;
+        uint8_t _savedLevel;        // Logger level before streaming
+        uint8_t _seq;
+        uint8_t _divider;
+
+        uint32_t _frames;
+        uint32_t _dropped;
+
+        bool _setBaud(uint32_t baud);
+};
+
+extern WaveStream waveStream;
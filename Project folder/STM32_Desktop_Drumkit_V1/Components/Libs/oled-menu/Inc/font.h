@@ -8,6 +8,12 @@
 #include "stdint.h"
 #include "string.h"
 
+/**
+ * @brief ASCII字体结构体 (字模图集)
+ * @note 收录' '~'~'共95个字符, 每个字模占((h + 7) / 8) * w字节
+ * @note 字模按页排列(与显存相同): 先是第0页的w个列字节, 再是第1页的w个列字节...
+ *       字符在页边界上时可直接整行复制到显存 (见OLED_BlitBlock)
+ */
 typedef struct ASCIIFont {
   uint8_t h;
   uint8_t w;
@@ -19,6 +25,21 @@ extern const ASCIIFont afont12x6;
 extern const ASCIIFont afont16x8;
 extern const ASCIIFont afont24x12;
 
+// CHANGE: The fonts of the OLED class (page mode), moved here from oled.h into the same atlas format (2025.11.11)
+extern const ASCIIFont afontPage8x6;
+extern const ASCIIFont afontPage16x8;
+
+/**
+ * @brief 获取字符的字模
+ * @note 不在' '~'~'范围内的字符显示为空格
+ */
+static inline const uint8_t *OLED_GetGlyph(const ASCIIFont *font, char ch)
+{
+  if (ch < ' ' || ch > '~')
+    ch = ' ';
+  return font->chars + (ch - ' ') * (((font->h + 7) / 8) * font->w);
+}
+
 // CHANGE: Added extern ascii_8x6 and 16x8 font for PrintText() (2025.10.9)
 // CHANGE: Deprecated. Instead, all page content will be done by my own class. (2025.10.11)
 // extern const unsigned char ascii_8x6[][6];
@@ -26,14 +47,19 @@ extern const ASCIIFont afont24x12;
 
 /**
  * @brief 字体结构体
- * @note  字库前4字节存储utf8编码 剩余字节存储字模数据
- * @note 字库数据可以使用波特律动LED取模助手生成(https://led.baud-dance.com)
+ * @note 字模按码点(Unicode)升序排列, codes[i]是第i个字模的码点, 查找用二分法 (见OLED_FindGlyph)
+ * @note 每个字模占((h + 7) / 8) * w字节, 按页排列 (与ASCIIFont相同)
+ * @note 字库数据可以使用波特律动LED取模助手生成(https://led.baud-dance.com),
+ *       再用Tools/font_index.py排序并生成码点表
  */
+// CHANGE: The 4 byte UTF-8 prefix of each glyph replaced by a sorted codepoint table, binary search
+// instead of a linear memcmp scan. len is uint16_t. (2025.11.12)
 typedef struct Font {
   uint8_t h;              // 字高度
   uint8_t w;              // 字宽度
-  const uint8_t *chars;   // 字库 字库前4字节存储utf8编码 剩余字节存储字模数据
-  uint8_t len;            // 字库长度 超过256则请改为uint16_t
+  const uint32_t *codes;  // 码点表 升序
+  const uint8_t *glyphs;  // 字模 与codes同序
+  uint16_t len;           // 字库长度
   const ASCIIFont *ascii; // 缺省ASCII字体 当字库中没有对应字符且需要显示ASCII字符时使用
 } Font;
 
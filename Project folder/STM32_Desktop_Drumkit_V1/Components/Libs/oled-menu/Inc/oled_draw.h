@@ -10,6 +10,14 @@
 #include "main.h"
 #include "string.h"
 
+// CHANGE: OLED参数与显存 moved here from oled_draw.c. This is the one display core of the firmware:
+// the OLED class (oled.h) draws into the same buffer, both send through oled_bus.h. (2025.11.5)
+#define OLED_PAGE 4            // OLED页数  // CHANGE: 8 -> 4
+#define OLED_ROW 8 * OLED_PAGE // OLED行数
+#define OLED_COLUMN 128        // OLED列数
+
+extern uint8_t OLED_GRAM[OLED_PAGE][OLED_COLUMN]; // 显存
+
 typedef enum {
   OLED_COLOR_NORMAL = 0, // 正常模式 黑底白字
   OLED_COLOR_REVERSED    // 反色模式 白底黑字
@@ -21,10 +29,17 @@ void OLED_DisPlay_Off();
 
 void OLED_NewFrame();
 void OLED_ShowFrame();
+uint8_t OLED_ShowFramePage(uint8_t page); // CHANGE: Added for page-sliced refresh, sends only the changed columns
+void OLED_InvalidateFrame();               // CHANGE: Added, the next ShowFrame sends every page in full
+void OLED_InvalidatePage(uint8_t page);    // CHANGE: Added, the next ShowFramePage sends this page in full
 
 void OLED_Disappear(void);
 void OLED_SetPixel(int16_t x, int16_t y, OLED_ColorMode color);
 
+// CHANGE: Added span fills (whole page bytes with masks), REVERSED toggles like OLED_SetPixel
+void OLED_DrawHSpan(int16_t x, int16_t y, int16_t w, OLED_ColorMode color);
+void OLED_DrawVSpan(int16_t x, int16_t y, int16_t h, OLED_ColorMode color);
+void OLED_FillArea(int16_t x, int16_t y, int16_t w, int16_t h, OLED_ColorMode color);
 void OLED_DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, OLED_ColorMode color);
 void OLED_DrawRectangle(int16_t x, int16_t y, uint8_t w, uint8_t h, OLED_ColorMode color);
 void OLED_DrawEmptyRectangle(int16_t x, int16_t y, uint8_t w, uint8_t h);
@@ -37,10 +52,12 @@ void OLED_DrawCircle(uint8_t x, uint8_t y, uint8_t r, OLED_ColorMode color);
 void OLED_DrawFilledCircle(uint8_t x, uint8_t y, uint8_t r, OLED_ColorMode color);
 void OLED_DrawEllipse(uint8_t x, uint8_t y, uint8_t a, uint8_t b, OLED_ColorMode color);
 void OLED_DrawImage(uint8_t x, uint8_t y, const Image *img, OLED_ColorMode color);
+uint8_t OLED_BlitBlock(int16_t x, int16_t y, const uint8_t *data, uint8_t w, uint8_t h, OLED_ColorMode color); // CHANGE: Added, returns 1 if OLED_GRAM changed
 
 void OLED_PrintASCIIChar(int16_t x, int16_t y, char ch, const ASCIIFont *font, OLED_ColorMode color);
 void OLED_PrintASCIIString(int16_t x, int16_t y, char *str, const ASCIIFont *font, OLED_ColorMode color);
 void OLED_PrintString(uint8_t x, uint8_t y, char *str, const Font *font, OLED_ColorMode color);
+const uint8_t *OLED_FindGlyph(const Font *font, uint32_t code); // CHANGE: Added, binary search in the codepoint table
 
 // CHANGE: Added my setCursor and printText methods from oled.cpp to avoid using buffer and improve performance (2025.10.9)
 // CHANGE: Deprecated. Instead, all page content will be done by my own class. (2025.10.11)
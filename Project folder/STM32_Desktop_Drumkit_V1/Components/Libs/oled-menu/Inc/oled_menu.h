@@ -30,6 +30,12 @@
 #define SCROLLBAR_WIDTH    2
 #define SCROLLBAR_MARGIN   3
 
+// CHANGE: Time based Q15 animation, see OLEDUI_Move() (2025.11.14)
+#define UI_MOVE_Q15_ONE       32768 // Q15 的 1.0（动画进度 0 ~ UI_MOVE_Q15_ONE）
+#define UI_MOVE_TIME_MS       240   // 一次过渡动画的时长(ms)，与刷新率无关
+#define UI_MOVE_FIRST_STEP_MS 40    // 静止后第一帧的推进时间（此前的间隔是空闲时间，不是帧间隔）
+#define UI_SWITCH_FRAMES      3     // 菜单切换消失效果的帧数 // CHANGE: Frame stepped, see InterfaceSwitch() (2025.11.14)
+
 // #define LONG_PRESS_THRESHOLD 600 // 长按判定时间(ms)  // CHANGE: Commented out
 
 // // 设置左右键对应的GPIO，默认高电平为按下                 // CHANGE: Commented out
@@ -54,12 +60,14 @@ extern ScreenIndexTypedef screenIndex;
 // extern uint8_t keyID;                               // CHANGE: Commented out
 extern uint8_t menuSwitchFlag;
 extern uint8_t controlSelectionFlag;
+extern uint8_t menuRedrawFlag;                      // CHANGE: Added, set by the menu control interfaces
 
-extern float moveProcess_FrameY;
-extern float moveProcess_FrameWidth;
-extern float moveProcess_Screen;
-extern float moveProcess_ScrollBar;
-extern float moveProcess_SwitchCtrlBar;
+// CHANGE: float -> Q15 (0 ~ UI_MOVE_Q15_ONE)
+extern uint16_t moveProcess_FrameY;
+extern uint16_t moveProcess_FrameWidth;
+extern uint16_t moveProcess_Screen;
+extern uint16_t moveProcess_ScrollBar;
+extern uint16_t moveProcess_SwitchCtrlBar;
 
 Menutypedef *AddMenu(const char *name, ItemTypedef *items, uint16_t itemCount, Menutypedef *parentMenu);
 
@@ -76,8 +84,9 @@ void FunctionForNextMenu(void);
 // CHANGE: Renamed from UI_xxx() to OLEDUI_xxx()
 void OLEDUI_Init(void);
 void OLEDUI_Update(void);
-void OLEDUI_Move(void);
+uint8_t OLEDUI_Move(void); // CHANGE: Returns 1 while an element is still moving
 void OLEDUI_Show(void);
+void OLEDUI_Draw(void); // CHANGE: Added, draws the UI into OLED_GRAM without sending it
 
 // CHANGE: Commented out original button handling functions
 // void KeyShortPress(void);
@@ -86,7 +95,8 @@ void Frame_Update(void);
 void Screen_Update(void);
 void ScrollBar_Update(void);
 void switchCtrlBar_Update(void);
-uint8_t UI_SmoothTransition(UIElemTypedef *elem, float *moveProcess, float moveSpeed);
+void UI_StartTransition(UIElemTypedef *elem, uint16_t *moveProcess, int16_t targetVal); // CHANGE: Added
+uint8_t UI_SmoothTransition(UIElemTypedef *elem, uint16_t *moveProcess, uint16_t moveStep);
 void InterfaceSwitch(void);
 void DrawMenuItems(void);
 void DrawControlSelection(void);
@@ -97,7 +107,7 @@ void DrawScrollBar(void);
 void DrawSwitchControl(ControlTypedef *control);
 void DrawDisplayControl(ControlTypedef *control);
 void DrawSliderControl(ControlTypedef *control);
-float easeInOut(float t);
+uint16_t easeInOut(uint16_t t); // CHANGE: float -> Q15
 
 // CHANGE: Added external menu control interfaces
 // External menu control interfaces
@@ -113,6 +113,10 @@ const unsigned char ascii_8x6[][6] = {
     {0x00, 0x1C, 0xA0, 0xA0, 0xA0, 0x7C}, // y
     {0x00, 0x44, 0x64, 0x54, 0x4C, 0x44}, // z
     {0x14, 0x14, 0x14, 0x14, 0x14, 0x14}, // horiz lines
+    // CHANGE: Added the missing last three glyphs, '|' '}' '~' read past the table (2025.11.11)
+    {0x00, 0x00, 0x00, 0x7F, 0x00, 0x00}, // |
+    {0x00, 0x00, 0x41, 0x7F, 0x08, 0x00}, // }
+    {0x00, 0x08, 0x04, 0x08, 0x10, 0x08}, // ~
 };
 
 // const unsigned char ascii_8x6[][6] = {
@@ -618,13 +622,224 @@ const unsigned char ascii_24x12[][36] = {
 
 const ASCIIFont afont24x12 = {24, 12, (unsigned char *)ascii_24x12};
 
-// const uint8_t zh16x16[][36] = {
-// /* 0 波 */ {0xe6,0xb3,0xa2,0x00,0x10,0x60,0x02,0x0c,0xc0,0x00,0xf8,0x88,0x88,0x88,0xff,0x88,0x88,0xa8,0x18,0x00,0x04,0x04,0x7c,0x03,0x80,0x60,0x1f,0x80,0x43,0x2c,0x10,0x28,0x46,0x81,0x80,0x00,},
-// /* 1 特 */ {0xe7,0x89,0xb9,0x00,0x40,0x3c,0x10,0xff,0x10,0x10,0x40,0x48,0x48,0x48,0x7f,0x48,0xc8,0x48,0x40,0x00,0x02,0x06,0x02,0xff,0x01,0x01,0x00,0x02,0x0a,0x12,0x42,0x82,0x7f,0x02,0x02,0x00,},
-// /* 2 律 */ {0xe5,0xbe,0x8b,0x00,0x00,0x10,0x88,0xc4,0x33,0x10,0x54,0x54,0x54,0xff,0x54,0x54,0x7c,0x10,0x10,0x00,0x02,0x01,0x00,0xff,0x00,0x10,0x12,0x12,0x12,0xff,0x12,0x12,0x12,0x10,0x00,0x00,},
-// /* 3 动 */ {0xe5,0x8a,0xa8,0x00,0x40,0x44,0xc4,0x44,0x44,0x44,0x40,0x10,0x10,0xff,0x10,0x10,0x10,0xf0,0x00,0x00,0x10,0x3c,0x13,0x10,0x14,0xb8,0x40,0x30,0x0e,0x01,0x40,0x80,0x40,0x3f,0x00,0x00,}
+// CHANGE: Fonts of the OLED class (page mode), moved here from oled.h. Same atlas format as the fonts above,
+// so both text paths draw through OLED_BlitBlock. (2025.11.11)
+// 8*6 ASCII (page mode)
+const unsigned char page_8x6[][6] = {
+    { 0x00,0x00,0x00,0x00,0x00,0x00},//   0
+    { 0x00,0x00,0x00,0x2F,0x00,0x00},// ! 1
+    { 0x00,0x00,0x07,0x00,0x07,0x00},// " 2
+    { 0x00,0x14,0x7F,0x14,0x7F,0x14},// # 3
+    { 0x00,0x24,0x2A,0x7F,0x2A,0x12},// $ 4
+    { 0x00,0x23,0x13,0x08,0x64,0x62},// % 5
+    { 0x00,0x36,0x49,0x55,0x22,0x50},// & 6
+    { 0x00,0x00,0x00,0x07,0x00,0x00},// ' 7
+    { 0x00,0x00,0x1C,0x22,0x41,0x00},// ( 8
+    { 0x00,0x00,0x41,0x22,0x1C,0x00},// ) 9
+    { 0x00,0x14,0x08,0x3E,0x08,0x14},// * 10
+    { 0x00,0x08,0x08,0x3E,0x08,0x08},// + 11
+    { 0x00,0x00,0x00,0xA0,0x60,0x00},// , 12
+    { 0x00,0x08,0x08,0x08,0x08,0x08},// - 13
+    { 0x00,0x00,0x60,0x60,0x00,0x00},// . 14
+    { 0x00,0x20,0x10,0x08,0x04,0x02},// / 15
+    { 0x00,0x3E,0x51,0x49,0x45,0x3E},// 0 16
+    { 0x00,0x00,0x42,0x7F,0x40,0x00},// 1 17
+    { 0x00,0x42,0x61,0x51,0x49,0x46},// 2 18
+    { 0x00,0x21,0x41,0x45,0x4B,0x31},// 3 19
+    { 0x00,0x18,0x14,0x12,0x7F,0x10},// 4 20
+    { 0x00,0x27,0x45,0x45,0x45,0x39},// 5 21
+    { 0x00,0x3C,0x4A,0x49,0x49,0x30},// 6 22
+    { 0x00,0x01,0x71,0x09,0x05,0x03},// 7 23
+    { 0x00,0x36,0x49,0x49,0x49,0x36},// 8 24
+    { 0x00,0x06,0x49,0x49,0x29,0x1E},// 9 25
+    { 0x00,0x00,0x36,0x36,0x00,0x00},// : 26
+    { 0x00,0x00,0x56,0x36,0x00,0x00},// ; 27
+    { 0x00,0x08,0x14,0x22,0x41,0x00},// < 28
+    { 0x00,0x14,0x14,0x14,0x14,0x14},// = 29
+    { 0x00,0x00,0x41,0x22,0x14,0x08},// > 30
+    { 0x00,0x02,0x01,0x51,0x09,0x06},// ? 31
+    { 0x00,0x3E,0x49,0x55,0x59,0x2E},// @ 32
+    { 0x00,0x7C,0x12,0x11,0x12,0x7C},// A 33
+    { 0x00,0x7F,0x49,0x49,0x49,0x36},// B 34
+    { 0x00,0x3E,0x41,0x41,0x41,0x22},// C 35
+    { 0x00,0x7F,0x41,0x41,0x22,0x1C},// D 36
+    { 0x00,0x7F,0x49,0x49,0x49,0x41},// E 37
+    { 0x00,0x7F,0x09,0x09,0x09,0x01},// F 38
+    { 0x00,0x3E,0x41,0x49,0x49,0x7A},// G 39
+    { 0x00,0x7F,0x08,0x08,0x08,0x7F},// H 40
+    { 0x00,0x00,0x41,0x7F,0x41,0x00},// I 41
+    { 0x00,0x20,0x40,0x41,0x3F,0x01},// J 42
+    { 0x00,0x7F,0x08,0x14,0x22,0x41},// K 43
+    { 0x00,0x7F,0x40,0x40,0x40,0x40},// L 44
+    { 0x00,0x7F,0x02,0x0C,0x02,0x7F},// M 45
+    { 0x00,0x7F,0x04,0x08,0x10,0x7F},// N 46
+    { 0x00,0x3E,0x41,0x41,0x41,0x3E},// O 47
+    { 0x00,0x7F,0x09,0x09,0x09,0x06},// P 48
+    { 0x00,0x3E,0x41,0x51,0x21,0x5E},// Q 49
+    { 0x00,0x7F,0x09,0x19,0x29,0x46},// R 50
+    { 0x00,0x46,0x49,0x49,0x49,0x31},// S 51
+    { 0x00,0x01,0x01,0x7F,0x01,0x01},// T 52
+    { 0x00,0x3F,0x40,0x40,0x40,0x3F},// U 53
+    { 0x00,0x1F,0x20,0x40,0x20,0x1F},// V 54
+    { 0x00,0x3F,0x40,0x38,0x40,0x3F},// W 55
+    { 0x00,0x63,0x14,0x08,0x14,0x63},// X 56
+    { 0x00,0x07,0x08,0x70,0x08,0x07},// Y 57
+    { 0x00,0x61,0x51,0x49,0x45,0x43},// Z 58
+    { 0x00,0x00,0x7F,0x41,0x41,0x00},// [ 59
+    { 0x00,0x02,0x04,0x08,0x10,0x20},// \ 60
+    { 0x00,0x00,0x41,0x41,0x7F,0x00},// ] 61
+    { 0x00,0x04,0x02,0x01,0x02,0x04},// ^ 62
+    { 0x00,0x40,0x40,0x40,0x40,0x40},// _ 63
+    { 0x00,0x00,0x01,0x02,0x04,0x00},// ` 64
+    { 0x00,0x20,0x54,0x54,0x54,0x78},// a 65
+    { 0x00,0x7F,0x48,0x44,0x44,0x38},// b 66
+    { 0x00,0x38,0x44,0x44,0x44,0x20},// c 67
+    { 0x00,0x38,0x44,0x44,0x48,0x7F},// d 68
+    { 0x00,0x38,0x54,0x54,0x54,0x18},// e 69
+    { 0x00,0x08,0x7E,0x09,0x01,0x02},// f 70
+    { 0x00,0x18,0xA4,0xA4,0xA4,0x7C},// g 71
+    { 0x00,0x7F,0x08,0x04,0x04,0x78},// h 72
+    { 0x00,0x00,0x44,0x7D,0x40,0x00},// i 73
+    { 0x00,0x40,0x80,0x84,0x7D,0x00},// j 74
+    { 0x00,0x7F,0x10,0x28,0x44,0x00},// k 75
+    { 0x00,0x00,0x41,0x7F,0x40,0x00},// l 76
+    { 0x00,0x7C,0x04,0x18,0x04,0x78},// m 77
+    { 0x00,0x7C,0x08,0x04,0x04,0x78},// n 78
+    { 0x00,0x38,0x44,0x44,0x44,0x38},// o 79
+    { 0x00,0xFC,0x24,0x24,0x24,0x18},// p 80
+    { 0x00,0x18,0x24,0x24,0x18,0xFC},// q 81
+    { 0x00,0x7C,0x08,0x04,0x04,0x08},// r 82
+    { 0x00,0x48,0x54,0x54,0x54,0x20},// s 83
+    { 0x00,0x04,0x3F,0x44,0x40,0x20},// t 84
+    { 0x00,0x3C,0x40,0x40,0x20,0x7C},// u 85
+    { 0x00,0x1C,0x20,0x40,0x20,0x1C},// v 86
+    { 0x00,0x3C,0x40,0x30,0x40,0x3C},// w 87
+    { 0x00,0x44,0x28,0x10,0x28,0x44},// x 88
+    { 0x00,0x1C,0xA0,0xA0,0xA0,0x7C},// y 89
+    { 0x00,0x44,0x64,0x54,0x4C,0x44},// z 90
+    { 0x00,0x00,0x08,0x7F,0x41,0x00},// { 91
+    { 0x00,0x00,0x00,0x7F,0x00,0x00},// | 92
+    { 0x00,0x00,0x41,0x7F,0x08,0x00},// } 93
+    { 0x00,0x08,0x04,0x08,0x10,0x08} // ~ 94
+};
+
+const ASCIIFont afontPage8x6 = {8, 6, (unsigned char *)page_8x6};
+
+// 16*8 ASCII (page mode)
+const unsigned char page_16x8[][16] = {
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*" ",0*/
+    {0x00,0x00,0x00,0xF8,0xF8,0x00,0x00,0x00,0x00,0x00,0x00,0x11,0x1B,0x00,0x00,0x00},/*"!",1*/
+    {0x00,0x00,0x78,0x08,0x00,0x78,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*""",2*/
+    {0x00,0x40,0xE0,0x50,0x40,0xF0,0x50,0x40,0x00,0x04,0x1F,0x04,0x04,0x1F,0x04,0x00},/*"#",3*/
+    {0x00,0xE0,0xB0,0x10,0xF8,0x10,0x10,0x00,0x00,0x10,0x10,0x7F,0x11,0x13,0x0E,0x00},/*"$",4*/
+    {0x30,0x58,0x48,0x70,0x80,0x60,0x30,0x08,0x10,0x18,0x04,0x03,0x0C,0x12,0x12,0x0C},/*"%",5*/
+    {0x00,0x60,0xF0,0x90,0x90,0x70,0x00,0x00,0x04,0x1F,0x11,0x11,0x16,0x1C,0x1F,0x10},/*"&",6*/
+    {0x00,0x00,0x00,0x78,0x78,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*"'",7*/
+    {0x00,0x00,0x80,0xE0,0x30,0x08,0x00,0x00,0x00,0x00,0x07,0x3F,0x60,0xC0,0x00,0x00},/*"(",8*/
+    {0x00,0x00,0x08,0x10,0xE0,0x80,0x00,0x00,0x00,0x00,0x80,0x60,0x38,0x0F,0x00,0x00},/*")",9*/
+    {0x00,0x80,0xA0,0x60,0xD8,0x60,0x90,0x00,0x00,0x00,0x00,0x00,0x01,0x00,0x00,0x00},/*"*",10*/
+    {0x00,0x00,0x00,0xC0,0xC0,0x00,0x00,0x00,0x00,0x02,0x02,0x1F,0x1F,0x02,0x02,0x02},/*"+",11*/
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x40,0x58,0x38,0x00,0x00,0x00},/*",",12*/
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x02,0x02,0x02,0x00,0x00},/*"-",13*/
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00},/*".",14*/
+    {0x00,0x00,0x00,0x00,0xC0,0x70,0x18,0x00,0x00,0x20,0x18,0x06,0x01,0x00,0x00,0x00},/*"/",15*/
+    {0x00,0xE0,0x30,0x10,0x10,0xB0,0xE0,0x80,0x00,0x0F,0x1A,0x13,0x11,0x18,0x0F,0x03},/*"0",16*/
+    {0x00,0x60,0x20,0x30,0xF0,0x00,0x00,0x00,0x00,0x10,0x10,0x10,0x1F,0x10,0x10,0x00},/*"1",17*/
+    {0x00,0x20,0x10,0x10,0x10,0xF0,0xE0,0x00,0x00,0x10,0x18,0x14,0x12,0x11,0x10,0x00},/*"2",18*/
+    {0x00,0x10,0x10,0x10,0x10,0xF0,0x60,0x00,0x00,0x10,0x11,0x11,0x11,0x19,0x0E,0x00},/*"3",19*/
+    {0x00,0x00,0x80,0x60,0x30,0xF0,0x00,0x00,0x04,0x07,0x05,0x04,0x04,0x1F,0x04,0x04},/*"4",20*/
+    {0x00,0xF0,0xF0,0x10,0x10,0x10,0x10,0x00,0x00,0x11,0x11,0x11,0x11,0x19,0x0F,0x00},/*"5",21*/
+    {0x00,0xC0,0x60,0x30,0x90,0x10,0x10,0x00,0x00,0x0F,0x19,0x11,0x10,0x11,0x0F,0x00},/*"6",22*/
+    {0x00,0x10,0x10,0x10,0x10,0xD0,0x70,0x00,0x00,0x00,0x10,0x1C,0x07,0x01,0x00,0x00},/*"7",23*/
+    {0x00,0x60,0xB0,0x90,0x10,0x90,0xE0,0x00,0x00,0x0E,0x12,0x11,0x11,0x13,0x0E,0x00},/*"8",24*/
+    {0x00,0xE0,0x30,0x10,0x10,0x30,0xE0,0x00,0x00,0x11,0x11,0x12,0x12,0x09,0x07,0x00},/*"9",25*/
+    {0x00,0x00,0x00,0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00},/*":",26*/
+    {0x00,0x00,0x00,0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0x40,0x58,0x38,0x00,0x00,0x00},/*";",27*/
+    {0x00,0x00,0x00,0x80,0x80,0x40,0x00,0x00,0x00,0x02,0x03,0x05,0x08,0x18,0x10,0x00},/*"<",28*/
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x05,0x05,0x05,0x05,0x05,0x05,0x00},/*"=",29*/
+    {0x00,0x00,0x40,0xC0,0x80,0x00,0x00,0x00,0x00,0x00,0x10,0x08,0x04,0x07,0x02,0x00},/*">",30*/
+    {0x00,0x00,0x08,0x18,0x10,0xF0,0xE0,0x00,0x00,0x00,0x00,0x1B,0x01,0x00,0x00,0x00},/*"?",31*/
+    {0x80,0xE0,0x10,0x88,0x88,0x88,0x10,0xE0,0x3F,0x60,0x8F,0x91,0x88,0x9F,0x08,0x0F},/*"@",32*/
+    {0x00,0x00,0xC0,0x70,0x30,0xE0,0x00,0x00,0x10,0x1E,0x07,0x04,0x04,0x05,0x0F,0x18},/*"A",33*/
+    {0x00,0xF0,0x10,0x10,0x10,0xB0,0xE0,0x00,0x00,0x1F,0x11,0x11,0x11,0x11,0x0E,0x00},/*"B",34*/
+    {0x00,0xC0,0x20,0x10,0x10,0x10,0x10,0x00,0x00,0x0F,0x18,0x10,0x10,0x10,0x10,0x00},/*"C",35*/
+    {0x00,0xF0,0x10,0x10,0x10,0x30,0xE0,0x80,0x00,0x1F,0x10,0x10,0x10,0x08,0x0F,0x03},/*"D",36*/
+    {0x00,0xF0,0xF0,0x10,0x10,0x10,0x10,0x00,0x00,0x1F,0x1F,0x11,0x11,0x11,0x11,0x00},/*"E",37*/
+    {0x00,0xF0,0xF0,0x10,0x10,0x10,0x10,0x00,0x00,0x1F,0x1F,0x01,0x01,0x01,0x01,0x00},/*"F",38*/
+    {0x00,0xE0,0x20,0x10,0x10,0x10,0x10,0x00,0x01,0x0F,0x18,0x10,0x11,0x11,0x1F,0x00},/*"G",39*/
+    {0x00,0xF0,0x00,0x00,0x00,0x00,0xF0,0x00,0x00,0x1F,0x01,0x01,0x01,0x01,0x1F,0x00},/*"H",40*/
+    {0x00,0x10,0x10,0xF0,0xF0,0x10,0x10,0x00,0x00,0x10,0x10,0x1F,0x1F,0x10,0x10,0x00},/*"I",41*/
+    {0x00,0x10,0x10,0x10,0x10,0xF0,0x00,0x00,0x00,0x18,0x10,0x10,0x10,0x0F,0x00,0x00},/*"J",42*/
+    {0x00,0xF0,0x00,0x80,0x40,0x20,0x10,0x00,0x00,0x1F,0x01,0x03,0x06,0x0C,0x10,0x00},/*"K",43*/
+    {0x00,0x00,0xF0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1F,0x10,0x10,0x10,0x10,0x00},/*"L",44*/
+    {0x00,0xF0,0x70,0x80,0x80,0xE0,0xF0,0xC0,0x1C,0x1F,0x00,0x03,0x03,0x00,0x03,0x1F},/*"M",45*/
+    {0x00,0xF0,0x70,0xC0,0x00,0x00,0xF0,0x00,0x00,0x1F,0x00,0x01,0x07,0x1C,0x1F,0x00},/*"N",46*/
+    {0x80,0xE0,0x30,0x10,0x10,0x10,0xE0,0xC0,0x03,0x0F,0x18,0x10,0x10,0x10,0x0F,0x07},/*"O",47*/
+    {0x00,0xF0,0x10,0x10,0x10,0x30,0xE0,0x00,0x00,0x1F,0x02,0x02,0x02,0x01,0x01,0x00},/*"P",48*/
+    {0x80,0xE0,0x30,0x10,0x10,0x10,0xE0,0xC0,0x03,0x0F,0x18,0x30,0x70,0x50,0x4F,0x47},/*"Q",49*/
+    {0x00,0xF0,0xF0,0x10,0x10,0xB0,0xE0,0x00,0x00,0x1F,0x1F,0x01,0x03,0x0F,0x18,0x00},/*"R",50*/
+    {0x00,0xE0,0xB0,0x10,0x10,0x10,0x10,0x00,0x00,0x10,0x10,0x11,0x11,0x13,0x0E,0x00},/*"S",51*/
+    {0x00,0x10,0x10,0xF0,0xF0,0x10,0x10,0x10,0x00,0x00,0x00,0x1F,0x1F,0x00,0x00,0x00},/*"T",52*/
+    {0x00,0xF0,0x00,0x00,0x00,0x00,0xF0,0x00,0x00,0x0F,0x18,0x10,0x10,0x10,0x0F,0x00},/*"U",53*/
+    {0x10,0xF0,0x80,0x00,0x00,0x00,0xE0,0x30,0x00,0x00,0x07,0x1C,0x18,0x0F,0x01,0x00},/*"V",54*/
+    {0x30,0xF0,0x00,0x00,0x80,0x00,0x00,0xF0,0x00,0x1F,0x1C,0x07,0x03,0x1C,0x1F,0x03},/*"W",55*/
+    {0x00,0x30,0x60,0xC0,0x80,0x60,0x30,0x10,0x10,0x18,0x0C,0x03,0x03,0x0E,0x18,0x10},/*"X",56*/
+    {0x10,0x70,0xC0,0x80,0x00,0xC0,0x60,0x10,0x00,0x00,0x00,0x1F,0x1F,0x01,0x00,0x00},/*"Y",57*/
+    {0x00,0x10,0x10,0x10,0x90,0xD0,0x30,0x00,0x00,0x18,0x1C,0x13,0x11,0x10,0x10,0x00},/*"Z",58*/
+    {0x00,0x00,0x00,0xF8,0x08,0x08,0x00,0x00,0x00,0x00,0x00,0xFF,0x80,0x80,0x00,0x00},/*"[",59*/
+    {0x00,0x08,0x30,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x07,0x1C,0x30,0x00},/*"\",60*/
+    {0x00,0x00,0x08,0x08,0xF8,0xF8,0x00,0x00,0x00,0x00,0x80,0x80,0xFF,0xFF,0x00,0x00},/*"]",61*/
+    {0x00,0x80,0xC0,0x30,0x30,0x60,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*"^",62*/
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},/*"_",63*/
+    {0x00,0x00,0x08,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*"`",64*/
+    {0x00,0x00,0x40,0x40,0x40,0xC0,0x80,0x00,0x00,0x1C,0x12,0x12,0x12,0x0A,0x1F,0x00},/*"a",65*/
+    {0x00,0xF8,0x80,0x40,0x40,0x40,0x80,0x00,0x00,0x1F,0x10,0x10,0x10,0x10,0x0F,0x00},/*"b",66*/
+    {0x00,0x00,0x80,0x40,0x40,0x40,0x40,0x00,0x00,0x07,0x1D,0x10,0x10,0x10,0x10,0x00},/*"c",67*/
+    {0x00,0x80,0xC0,0x40,0x40,0x40,0xF8,0x00,0x00,0x0F,0x18,0x10,0x10,0x08,0x1F,0x00},/*"d",68*/
+    {0x00,0x80,0xC0,0x40,0x40,0x40,0x80,0x00,0x00,0x0F,0x1A,0x12,0x12,0x12,0x13,0x00},/*"e",69*/
+    {0x00,0x80,0x80,0xF0,0x98,0x88,0x88,0x08,0x00,0x00,0x00,0x1F,0x00,0x00,0x00,0x00},/*"f",70*/
+    {0x00,0x80,0xC0,0x40,0x40,0xC0,0xC0,0x40,0x00,0x6F,0x92,0x94,0x94,0x92,0x73,0x20},/*"g",71*/
+    {0x00,0xF8,0x80,0x40,0x40,0x40,0x80,0x00,0x00,0x1F,0x00,0x00,0x00,0x00,0x1F,0x00},/*"h",72*/
+    {0x00,0x40,0x40,0x58,0xD8,0x00,0x00,0x00,0x00,0x10,0x10,0x10,0x1F,0x10,0x10,0x00},/*"i",73*/
+    {0x00,0x40,0x40,0x40,0x50,0xD8,0x00,0x00,0x00,0x80,0x80,0x80,0xC0,0x7F,0x00,0x00},/*"j",74*/
+    {0x00,0xF8,0xF8,0x00,0x80,0x80,0x40,0x00,0x00,0x1F,0x1F,0x03,0x05,0x08,0x10,0x00},/*"k",75*/
+    {0x00,0x08,0x08,0x08,0xF8,0x00,0x00,0x00,0x00,0x10,0x10,0x10,0x1F,0x10,0x10,0x00},/*"l",76*/
+    {0x00,0xC0,0x40,0x40,0x80,0x40,0xC0,0x80,0x00,0x1F,0x00,0x00,0x1F,0x00,0x1F,0x1F},/*"m",77*/
+    {0x00,0xC0,0x80,0x40,0x40,0x40,0x80,0x00,0x00,0x1F,0x00,0x00,0x00,0x00,0x1F,0x00},/*"n",78*/
+    {0x00,0x80,0xC0,0x40,0x40,0x40,0x80,0x00,0x00,0x0F,0x18,0x10,0x10,0x10,0x0F,0x02},/*"o",79*/
+    {0x00,0xC0,0x80,0x40,0x40,0x40,0x80,0x00,0x00,0xFF,0x10,0x10,0x10,0x10,0x0F,0x00},/*"p",80*/
+    {0x00,0x80,0xC0,0x40,0x40,0x40,0xC0,0x00,0x00,0x0F,0x18,0x10,0x10,0x08,0xFF,0x00},/*"q",81*/
+    {0x00,0xC0,0xC0,0x80,0x40,0x40,0xC0,0x00,0x00,0x1F,0x1F,0x00,0x00,0x00,0x01,0x01},/*"r",82*/
+    {0x00,0x00,0xC0,0x40,0x40,0x40,0x40,0x00,0x00,0x10,0x13,0x12,0x12,0x16,0x0C,0x00},/*"s",83*/
+    {0x40,0x40,0x40,0xF0,0x40,0x40,0x40,0x00,0x00,0x00,0x00,0x1F,0x10,0x10,0x10,0x00},/*"t",84*/
+    {0x00,0xC0,0x00,0x00,0x00,0x00,0xC0,0x00,0x00,0x0F,0x18,0x10,0x10,0x08,0x1F,0x00},/*"u",85*/
+    {0x00,0xC0,0x00,0x00,0x00,0x00,0xC0,0x40,0x00,0x01,0x07,0x1C,0x18,0x07,0x01,0x00},/*"v",86*/
+    {0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0xC0,0x00,0x1F,0x18,0x07,0x07,0x1C,0x1F,0x01},/*"w",87*/
+    {0x00,0x40,0xC0,0x00,0x00,0x80,0xC0,0x00,0x00,0x10,0x18,0x07,0x07,0x0D,0x18,0x00},/*"x",88*/
+    {0x00,0xC0,0x00,0x00,0x00,0x00,0xC0,0x40,0x80,0x81,0xC7,0x7C,0x38,0x0F,0x01,0x00},/*"y",89*/
+    {0x00,0x40,0x40,0x40,0x40,0xC0,0xC0,0x00,0x00,0x10,0x18,0x16,0x13,0x11,0x10,0x00},/*"z",90*/
+    {0x00,0x00,0x00,0xF0,0x18,0x08,0x08,0x00,0x00,0x02,0x03,0x7F,0xC0,0x80,0x80,0x00},/*"{",91*/
+    {0x00,0x00,0x00,0x00,0xFC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00,0x00},/*"|",92*/
+    {0x00,0x00,0x08,0x18,0xF0,0x00,0x00,0x00,0x00,0x00,0x80,0xC0,0x7F,0x03,0x02,0x00},/*"}",93*/
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x01,0x01,0x02,0x04,0x06,0x03}/*"~",94*/
+};
+
+const ASCIIFont afontPage16x8 = {16, 8, (unsigned char *)page_16x8};
+
+// CHANGE: Indexed font format, generated by Tools/font_index.py from the LED tool output (2025.11.12)
+// const uint32_t font16x16_codes[] = {
+//     0x52A8, // 动
+//     0x5F8B, // 律
+//     0x6CE2, // 波
+//     0x7279, // 特
+// };
+// const uint8_t font16x16_glyphs[][32] = {
+//     /* 动 */ {0x40,0x44,0xc4,0x44,0x44,0x44,0x40,0x10,0x10,0xff,0x10,0x10,0x10,0xf0,0x00,0x00,0x10,0x3c,0x13,0x10,0x14,0xb8,0x40,0x30,0x0e,0x01,0x40,0x80,0x40,0x3f,0x00,0x00},
+//     /* 律 */ {0x00,0x10,0x88,0xc4,0x33,0x10,0x54,0x54,0x54,0xff,0x54,0x54,0x7c,0x10,0x10,0x00,0x02,0x01,0x00,0xff,0x00,0x10,0x12,0x12,0x12,0xff,0x12,0x12,0x12,0x10,0x00,0x00},
+//     /* 波 */ {0x10,0x60,0x02,0x0c,0xc0,0x00,0xf8,0x88,0x88,0x88,0xff,0x88,0x88,0xa8,0x18,0x00,0x04,0x04,0x7c,0x03,0x80,0x60,0x1f,0x80,0x43,0x2c,0x10,0x28,0x46,0x81,0x80,0x00},
+//     /* 特 */ {0x40,0x3c,0x10,0xff,0x10,0x10,0x40,0x48,0x48,0x48,0x7f,0x48,0xc8,0x48,0x40,0x00,0x02,0x06,0x02,0xff,0x01,0x01,0x00,0x02,0x0a,0x12,0x42,0x82,0x7f,0x02,0x02,0x00},
 // };
-// const Font font16x16 = {16, 16, (const uint8_t *)zh16x16, 4, &afont8x6};
+// const Font font16x16 = {16, 16, font16x16_codes, (const uint8_t *)font16x16_glyphs, 4, &afont8x6};
 
 // const uint8_t bilibiliData[] = {
 // 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x86, 0x8f, 0x9f, 0xbf, 0xff, 0xfc, 0xf8, 0xf8, 0xe0, 0xe0, 0xc0, 0x80,
@@ -4,44 +4,33 @@
  */
 
 #include "oled_draw.h"
-#include "i2c.h"
+#include "oled_bus.h"
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
 
-// OLED器件地址
-#define OLED_ADDRESS 0x78
+// 显存
+uint8_t OLED_GRAM[OLED_PAGE][OLED_COLUMN] __attribute__((aligned(4)));
 
-// OLED参数
-#define OLED_PAGE 4            // OLED页数  // CHANGE: 8 -> 4
-#define OLED_ROW 8 * OLED_PAGE // OLED行数
-#define OLED_COLUMN 128        // OLED列数
+// CHANGE: 已发送到屏幕的显存副本 copy of the frame as last queued for the panel, ShowFramePage() sends
+// only the columns that differ from it (2025.11.8)
+static uint8_t OLED_SentGRAM[OLED_PAGE][OLED_COLUMN] __attribute__((aligned(4)));
+static uint8_t OLED_SentValid = 0; // bit n: page n of OLED_SentGRAM matches the panel
 
-// 显存
-uint8_t OLED_GRAM[OLED_PAGE][OLED_COLUMN];
+typedef uint32_t __attribute__((may_alias)) OLED_Word; // 按字比较 word-wide compare of the byte arrays
+#define OLED_PAGE_WORDS (OLED_COLUMN / sizeof(OLED_Word))
 
 // ========================== 底层通信函数 ==========================
 
-/**
- * @brief 向OLED发送数据的函数
- * @param data 要发送的数据
- * @param len 要发送的数据长度
- * @return None
- * @note 此函数是移植本驱动时的重要函数 将本驱动库移植到其他平台时应根据实际情况修改此函数
- */
-void OLED_Send(uint8_t *data, uint8_t len)
-{
-  while(HAL_I2C_Master_Transmit_DMA(&hi2c1, OLED_ADDRESS, data, len) != HAL_OK);
-}
-
 /**
  * @brief 向OLED发送指令
+ * @note 此函数是移植本驱动时的重要函数 将本驱动库移植到其他平台时应根据实际情况修改此函数
+ * @note CHANGE: Queued on the asynchronous OLED bus (oled_bus.h), returns at once. Consecutive
+ *       commands are sent as one transaction. Replaces OLED_Send() and its wait for the DMA. (2025.11.2)
  */
 void OLED_SendCmd(uint8_t cmd)
 {
-  static uint8_t sendBuffer[2] = {0};
-  sendBuffer[1] = cmd;
-  OLED_Send(sendBuffer, 2);
+  OledBus_Cmds(&cmd, 1);
 }
 
 // ========================== OLED驱动函数 ==========================
@@ -97,6 +86,7 @@ void OLED_Init()
   OLED_SendCmd(0x14);
 
   OLED_NewFrame();
+  OLED_InvalidateFrame(); // CHANGE: 上电时屏幕内容随机 panel RAM is random at power on, send the whole frame
   OLED_ShowFrame();
 
   OLED_SendCmd(0xAF); /*开启显示 display ON*/
@@ -155,33 +145,92 @@ void OLED_NewFrame()
  */
 void OLED_ShowFrame()
 {
-  static uint8_t sendBuffer[OLED_COLUMN + 1];
-  sendBuffer[0] = 0x40;
   for (uint8_t i = 0; i < OLED_PAGE; i++)
   {
-    OLED_SendCmd(0xB0 + i); // 设置页地址
-    OLED_SendCmd(0x00);     // 设置列地址低4位
-    OLED_SendCmd(0x10);     // 设置列地址高4位
-    memcpy(sendBuffer + 1, OLED_GRAM[i], OLED_COLUMN);
-    OLED_Send(sendBuffer, OLED_COLUMN + 1);
+    OLED_ShowFramePage(i);
   }
 }
 
 /**
- * @brief 控制界面渐变消失
- * @param moveProcess 移动进度 0-1
+ * @brief 将显存的一页显示到屏幕上
+ * @param page 页号 (0 ~ OLED_PAGE-1)
+ * @return 1 屏幕已与显存一致或已排队 page in sync or queued, 0 OLED总线队列已满 bus queue full (call again)
+ * @note CHANGE: Split out of OLED_ShowFrame() so a frame can be sent one page per scheduler slice (2025.10.20)
+ * @note CHANGE: Only the column range that differs from the last sent frame is queued, found with
+ *       32-bit compares from both ends. An unchanged page sends nothing. (2025.11.8)
+ */
+uint8_t OLED_ShowFramePage(uint8_t page)
+{
+  if (page >= OLED_PAGE) return 1;
+
+  uint8_t x1 = 0;
+  uint8_t x2 = OLED_COLUMN;
+  if (OLED_SentValid & (1 << page))
+  {
+    const OLED_Word *now = (const OLED_Word *)OLED_GRAM[page];
+    const OLED_Word *sent = (const OLED_Word *)OLED_SentGRAM[page];
+    uint8_t first = 0;
+    uint8_t last = OLED_PAGE_WORDS - 1;
+
+    while (first < OLED_PAGE_WORDS && now[first] == sent[first]) first++;
+    if (first == OLED_PAGE_WORDS) return 1; // 无变化 unchanged
+    while (now[last] == sent[last]) last--;
+
+    x1 = first * sizeof(OLED_Word);
+    x2 = (last + 1) * sizeof(OLED_Word);
+    while (OLED_GRAM[page][x1] == OLED_SentGRAM[page][x1]) x1++;
+    while (OLED_GRAM[page][x2 - 1] == OLED_SentGRAM[page][x2 - 1]) x2--;
+  }
+
+  // CHANGE: The OLED bus copies the span and sets the address window itself, a page still waiting is merged (2025.11.2)
+  if (!OledBus_Page(page, x1, x2, OLED_GRAM[page])) return 0;
+
+  memcpy(&OLED_SentGRAM[page][x1], &OLED_GRAM[page][x1], x2 - x1);
+  OLED_SentValid |= (1 << page);
+  return 1;
+}
+
+/**
+ * @brief 使已发送帧失效 下次ShowFrame发送整帧
+ * @note CHANGE: Added for the frame differencing, e.g. after the panel was powered up (2025.11.8)
+ */
+void OLED_InvalidateFrame()
+{
+  OLED_SentValid = 0;
+}
+
+/**
+ * @brief 使已发送帧的一页失效 下次ShowFramePage发送整页
+ * @param page 页号 (0 ~ OLED_PAGE-1)
+ * @note CHANGE: Added, called by the OLED bus when it gave up a transfer of this page: the panel
+ *       does not show what OLED_SentGRAM says (2025.11.20)
+ */
+void OLED_InvalidatePage(uint8_t page)
+{
+  if (page < OLED_PAGE) OLED_SentValid &= ~(1 << page);
+}
+
+// CHANGE: 消失效果的随机掩码 xorshift32 (a 32 bit LFSR), never 0 (2025.11.14)
+static uint32_t OLED_DisappearLFSR = 0x2545F491;
+
+/**
+ * @brief 控制界面渐变消失 每次调用随机熄灭约一半的点亮像素
+ * @note CHANGE: One xorshift32 step masks four bytes, was one rand() per byte. The caller
+ *       sends the frame, one call per frame (2025.11.14)
  */
 void OLED_Disappear(void)
 {
-  srand(HAL_GetTick());
+  OLED_Word *gram = (OLED_Word *)OLED_GRAM;
+  uint32_t lfsr = OLED_DisappearLFSR;
 
-  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  for (uint16_t i = 0; i < OLED_PAGE * OLED_PAGE_WORDS; i++)
   {
-    for (uint8_t j = 0; j < OLED_COLUMN; j++)
-    {
-      OLED_GRAM[i][j] = OLED_GRAM[i][j] & (uint8_t)(rand() % 256);
-    }
+    lfsr ^= lfsr << 13;
+    lfsr ^= lfsr >> 17;
+    lfsr ^= lfsr << 5;
+    gram[i] &= lfsr;
   }
+  OLED_DisappearLFSR = lfsr;
 }
 
 // void OLED_Appear(float moveProcess)
@@ -230,167 +279,190 @@ void OLED_SetPixel(int16_t x, int16_t y, OLED_ColorMode color)
   }
 }
 
+// CHANGE: OLED_SetByte_Fine / OLED_SetByte / OLED_SetBits_Fine / OLED_SetBits / OLED_SetBlock replaced by
+// OLED_BlitBlock: page-aligned blocks are copied row by row, the rest is shifted and masked per column. (2025.11.11)
+
 /**
- * @brief 设置显存中一字节数据的某几位
- * @param page 页地址
+ * @brief 按掩码写入显存中的一字节
+ * @param page 页地址 (可越界, 越界时不写)
  * @param column 列地址
- * @param data 数据
- * @param start 起始位
- * @param end 结束位
- * @param color 颜色
- * @note 此函数将显存中的某一字节的第start位到第end位设置为与data相同
- * @note start和end的范围为0-7, start必须小于等于end
- * @note 此函数与OLED_SetByte_Fine的区别在于此函数只能设置显存中的某一真实字节
+ * @param bits 数据 (已按掩码截取)
+ * @param mask 要写入的位
+ * @return 显存是否改变
  */
-void OLED_SetByte_Fine(uint8_t page, uint8_t column, uint8_t data, uint8_t start, uint8_t end, OLED_ColorMode color)
+static inline uint8_t _OLED_MergeByte(int16_t page, uint8_t column, uint8_t bits, uint8_t mask)
 {
-  static uint8_t temp;
-  if (page >= OLED_PAGE || column >= OLED_COLUMN)
-    return;
-  if (color)
-    data = ~data;
-
-  temp = data | (0xff << (end + 1)) | (0xff >> (8 - start));
-  OLED_GRAM[page][column] &= temp;
-  temp = data & ~(0xff << (end + 1)) & ~(0xff >> (8 - start));
-  OLED_GRAM[page][column] |= temp;
-// 使用OLED_SetPixel实现
-  // for (uint8_t i = start; i <= end; i++) {
-  //   OLED_SetPixel(column, page * 8 + i, !((data >> i) & 0x01));
-  // }
+  if (page < 0 || page >= OLED_PAGE || !mask)
+    return 0;
+  uint8_t old = OLED_GRAM[page][column];
+  uint8_t now = (old & ~mask) | bits;
+  OLED_GRAM[page][column] = now;
+  return now != old;
 }
 
 /**
- * @brief 设置显存中的一字节数据
- * @param page 页地址
- * @param column 列地址
- * @param data 数据
+ * @brief 将一块列行式数据(字模/图片)写入显存
+ * @param x 起始横坐标
+ * @param y 起始纵坐标
+ * @param data 数据的起始地址
+ * @param w 宽度
+ * @param h 高度
  * @param color 颜色
- * @note 此函数将显存中的某一字节设置为data的值
+ * @return 显存是否改变 (1: 改变, 0: 内容相同)
+ * @note data按页排列: 第j行字节(像素行8j~8j+7)为data[j * w] ~ data[j * w + w - 1], 与显存的页格式相同
+ * @note 快速路径: y与h均为8的整数倍且整块在屏幕内时, 每页直接比较并复制一行字节, 不做移位
+ * @note 通用路径: 其余情况逐列将字节移位到两页中并按掩码写入, 屏幕外的部分被裁剪
  */
-void OLED_SetByte(uint8_t page, uint8_t column, uint8_t data, OLED_ColorMode color)
+uint8_t OLED_BlitBlock(int16_t x, int16_t y, const uint8_t *data, uint8_t w, uint8_t h, OLED_ColorMode color)
 {
-  if (page >= OLED_PAGE || column >= OLED_COLUMN)
-    return;
-  if (color)
-    data = ~data;
-  OLED_GRAM[page][column] = data;
+  uint8_t rows = (h + 7) / 8; // 数据的字节行数
+  uint8_t changed = 0;
+  if (w == 0 || h == 0)
+    return 0;
+
+  if (y >= 0 && (y % 8) == 0 && (h % 8) == 0 && x >= 0 && x + w <= OLED_COLUMN && y / 8 + rows <= OLED_PAGE)
+  {
+    uint8_t invert = color ? 0xff : 0x00;
+    uint8_t diff = 0;
+    for (uint8_t j = 0; j < rows; j++, data += w)
+    {
+      uint8_t *dst = &OLED_GRAM[y / 8 + j][x];
+      for (uint8_t i = 0; i < w; i++)
+      {
+        uint8_t b = data[i] ^ invert;
+        diff |= dst[i] ^ b;
+        dst[i] = b;
+      }
+    }
+    return diff != 0;
+  }
+
+  uint8_t shift = y & 7;                                  // 块内第0行在页中的位置 (y为负时同样成立)
+  int16_t page0 = (y - shift) / 8;                        // 第0行字节所在页
+  uint8_t lastMask = (h % 8) ? (0xff >> (8 - h % 8)) : 0xff; // 最后一行字节的有效位
+  for (uint8_t i = 0; i < w; i++)
+  {
+    int16_t column = x + i;
+    if (column < 0 || column >= OLED_COLUMN)
+      continue;
+    for (uint8_t j = 0; j < rows; j++)
+    {
+      uint8_t mask = (j == rows - 1) ? lastMask : 0xff;
+      uint8_t bits = data[j * w + i];
+      if (color)
+        bits = ~bits;
+      uint16_t m = (uint16_t)mask << shift;
+      uint16_t b = (uint16_t)(bits & mask) << shift;
+      changed |= _OLED_MergeByte(page0 + j, column, b & 0xff, m & 0xff);
+      changed |= _OLED_MergeByte(page0 + j + 1, column, b >> 8, m >> 8);
+    }
+  }
+  return changed;
 }
 
+// CHANGE: Span fills. Lines, rectangles and frames work on whole page bytes with a top / bottom mask
+// instead of OLED_SetPixel per pixel. (2025.11.13)
+
+typedef enum {
+  _OLED_SPAN_SET = 0,  // 点亮 (OLED_COLOR_NORMAL)
+  _OLED_SPAN_TOGGLE,   // 取反 (OLED_COLOR_REVERSED, 与OLED_SetPixel相同)
+  _OLED_SPAN_CLEAR     // 熄灭
+} _OLED_SpanOp;
+
 /**
- * @brief 设置显存中的一字节数据的某几位
- * @param x 横坐标
- * @param y 纵坐标
- * @param data 数据
- * @param len 位数
- * @param color 颜色
- * @note 此函数将显存中从(x,y)开始向下数len位设置为与data相同
- * @note len的范围为1-8
- * @note 此函数与OLED_SetByte_Fine的区别在于此函数的横坐标和纵坐标是以像素为单位的, 可能出现跨两个真实字节的情况(跨页)
+ * @brief 以页字节为单位填充一块区域
+ * @param x 起始横坐标
+ * @param y 起始纵坐标
+ * @param w 宽度
+ * @param h 高度
+ * @param op 操作
+ * @note 屏幕外的部分被裁剪. 每页先算好掩码(首页去掉y以上的位, 末页去掉区域以下的位), 再逐列整字节操作
  */
-void OLED_SetBits_Fine(int8_t x, int8_t y, uint8_t data, uint8_t len, OLED_ColorMode color)
+static void _OLED_FillSpan(int16_t x, int16_t y, int16_t w, int16_t h, _OLED_SpanOp op)
 {
-  uint8_t page = 0;
-  uint8_t bit = 0;
-  if (y < 0 && y > -8)
-  {
-    page = 0;
-    bit = y + 8;
-  }
-  else 
+  if (x < 0)
   {
-    page = y / 8;
-    bit = y % 8;
+    w += x;
+    x = 0;
   }
-  
-  if (bit + len > 8)
+  if (y < 0)
   {
-    OLED_SetByte_Fine(page, x, data << bit, bit, 7, color);
-    OLED_SetByte_Fine(page + 1, x, data >> (8 - bit), 0, len + bit - 1 - 8, color);
+    h += y;
+    y = 0;
   }
-  else
+  if (x + w > OLED_COLUMN)
+    w = OLED_COLUMN - x;
+  if (y + h > OLED_ROW)
+    h = OLED_ROW - y;
+  if (w <= 0 || h <= 0)
+    return;
+
+  int16_t y2 = y + h - 1; // 最后一行
+  for (uint8_t page = y / 8; page <= y2 / 8; page++)
   {
-    OLED_SetByte_Fine(page, x, data << bit, bit, bit + len - 1, color);
+    uint8_t mask = 0xff;
+    if (page == y / 8)
+      mask &= 0xff << (y % 8);
+    if (page == y2 / 8)
+      mask &= 0xff >> (7 - y2 % 8);
+
+    uint8_t *p = &OLED_GRAM[page][x];
+    uint8_t *end = p + w;
+    if (op == _OLED_SPAN_SET)
+    {
+      for (; p < end; p++)
+        *p |= mask;
+    }
+    else if (op == _OLED_SPAN_TOGGLE)
+    {
+      for (; p < end; p++)
+        *p ^= mask;
+    }
+    else
+    {
+      mask = ~mask;
+      for (; p < end; p++)
+        *p &= mask;
+    }
   }
-  // 使用OLED_SetPixel实现
-  // for (uint8_t i = 0; i < len; i++) {
-  //   OLED_SetPixel(x, y + i, !((data >> i) & 0x01));
-  // }
 }
 
 /**
- * @brief 设置显存中一字节长度的数据
- * @param x 横坐标
+ * @brief 绘制一条水平线段
+ * @param x 起始横坐标
  * @param y 纵坐标
- * @param data 数据
- * @param color 颜色
- * @note 此函数将显存中从(x,y)开始向下数8位设置为与data相同
- * @note 此函数与OLED_SetByte的区别在于此函数的横坐标和纵坐标是以像素为单位的, 可能出现跨两个真实字节的情况(跨页)
+ * @param w 长度
+ * @param color 颜色 (OLED_COLOR_REVERSED为取反, 与OLED_SetPixel相同)
  */
-void OLED_SetBits(int8_t x, int8_t y, uint8_t data, OLED_ColorMode color)
+void OLED_DrawHSpan(int16_t x, int16_t y, int16_t w, OLED_ColorMode color)
 {
-  uint8_t page;
-  uint8_t bit;
-  // printf("oled: %d, %d\n", x, y);
-  if (y < 0 && y > -8)
-  {
-    page = 0;
-    bit = y + 8;
-    OLED_SetByte_Fine(page, x, data >> (8 - bit), 0, bit - 1, color);
-    return;
-  }
-  else 
-  {
-    page = y / 8;
-    bit = y % 8;
-  }
+  _OLED_FillSpan(x, y, w, 1, color ? _OLED_SPAN_TOGGLE : _OLED_SPAN_SET);
+}
 
-  OLED_SetByte_Fine(page, x, data << bit, bit, 7, color);
-  if (bit)
-  {
-    OLED_SetByte_Fine(page + 1, x, data >> (8 - bit), 0, bit - 1, color);
-  }
+/**
+ * @brief 绘制一条竖直线段
+ * @param x 横坐标
+ * @param y 起始纵坐标
+ * @param h 长度
+ * @param color 颜色 (OLED_COLOR_REVERSED为取反, 与OLED_SetPixel相同)
+ * @note 每页只操作一个字节
+ */
+void OLED_DrawVSpan(int16_t x, int16_t y, int16_t h, OLED_ColorMode color)
+{
+  _OLED_FillSpan(x, y, 1, h, color ? _OLED_SPAN_TOGGLE : _OLED_SPAN_SET);
 }
 
 /**
- * @brief 设置一块显存区域
+ * @brief 填充一块区域
  * @param x 起始横坐标
  * @param y 起始纵坐标
- * @param data 数据的起始地址
  * @param w 宽度
  * @param h 高度
- * @param color 颜色
- * @note 此函数将显存中从(x,y)开始的w*h个像素设置为data中的数据
- * @note data的数据应该采用列行式排列
+ * @param color 颜色 (OLED_COLOR_REVERSED为取反, 与OLED_SetPixel相同)
  */
-void OLED_SetBlock(int8_t x, int8_t y, const uint8_t *data, uint8_t w, uint8_t h, OLED_ColorMode color)
+void OLED_FillArea(int16_t x, int16_t y, int16_t w, int16_t h, OLED_ColorMode color)
 {
-  uint8_t fullRow = h / 8; // 完整的行数
-  uint8_t partBit = h % 8; // 不完整的字节中的有效位数
-  for (uint8_t i = 0; i < w; i++)
-  {
-    for (uint8_t j = 0; j < fullRow; j++)
-    {
-      OLED_SetBits(x + i, y + j * 8, data[i + j * w], color);
-    }
-  }
-  if (partBit)
-  {
-    uint16_t fullNum = w * fullRow; // 完整的字节数
-    for (uint8_t i = 0; i < w; i++)
-    {
-      OLED_SetBits_Fine(x + i, y + (fullRow * 8), data[fullNum + i], partBit, color);
-    }
-  }
-  // 使用OLED_SetPixel实现
-  // for (uint8_t i = 0; i < w; i++) {
-  //   for (uint8_t j = 0; j < h; j++) {
-  //     for (uint8_t k = 0; k < 8; k++) {
-  //       if (j * 8 + k >= h) break; // 防止越界(不完整的字节
-  //       OLED_SetPixel(x + i, y + j * 8 + k, !((data[i + j * w] >> k) & 0x01));
-  //     }
-  //   }
-  // }
+  _OLED_FillSpan(x, y, w, h, color ? _OLED_SPAN_TOGGLE : _OLED_SPAN_SET);
 }
 
 // ========================== 图形绘制函数 ==========================
@@ -405,8 +477,7 @@ void OLED_SetBlock(int8_t x, int8_t y, const uint8_t *data, uint8_t w, uint8_t h
  */
 void OLED_DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, OLED_ColorMode color)
 {
-  
-  static int16_t temp = 0;
+  int16_t temp;
   if (x1 == x2)
   {
     if (y1 > y2)
@@ -415,10 +486,7 @@ void OLED_DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, OLED_ColorMod
       y1 = y2;
       y2 = temp;
     }
-    for (int16_t y = y1; y <= y2; y++)
-    {
-      OLED_SetPixel(x1, y, color);
-    }
+    OLED_DrawVSpan(x1, y1, y2 - y1 + 1, color); // CHANGE: Span instead of OLED_SetPixel per pixel
   }
   else if (y1 == y2)
   {
@@ -428,10 +496,7 @@ void OLED_DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, OLED_ColorMod
       x1 = x2;
       x2 = temp;
     }
-    for (int16_t x = x1; x <= x2; x++)
-    {
-      OLED_SetPixel(x, y1, color);
-    }
+    OLED_DrawHSpan(x1, y1, x2 - x1 + 1, color); // CHANGE: Span instead of OLED_SetPixel per pixel
   }
   else
   {
@@ -482,10 +547,11 @@ void OLED_DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, OLED_ColorMod
  */
 void OLED_DrawRectangle(int16_t x, int16_t y, uint8_t w, uint8_t h, OLED_ColorMode color)
 {
-  OLED_DrawLine(x, y, x + w, y, color);
-  OLED_DrawLine(x, y + h, x + w, y + h, color);
-  OLED_DrawLine(x, y, x, y + h, color);
-  OLED_DrawLine(x + w, y, x + w, y + h, color);
+  // CHANGE: Spans (same pixels as the four lines, corners included in both) (2025.11.13)
+  OLED_DrawHSpan(x, y, w + 1, color);
+  OLED_DrawHSpan(x, y + h, w + 1, color);
+  OLED_DrawVSpan(x, y, h + 1, color);
+  OLED_DrawVSpan(x + w, y, h + 1, color);
 }
 
 /**
@@ -498,10 +564,8 @@ void OLED_DrawRectangle(int16_t x, int16_t y, uint8_t w, uint8_t h, OLED_ColorMo
  */
 void OLED_DrawFilledRectangle(int16_t x, int16_t y, uint8_t w, uint8_t h, OLED_ColorMode color)
 {
-  for (uint8_t i = 0; i < h; i++)
-  {
-    OLED_DrawLine(x, y + i, x + w, y + i, color);
-  }
+  // CHANGE: One area fill instead of h lines (same pixels: h rows of x ~ x+w) (2025.11.13)
+  OLED_FillArea(x, y, w + 1, h, color);
 }
 
 /**
@@ -513,21 +577,9 @@ void OLED_DrawFilledRectangle(int16_t x, int16_t y, uint8_t w, uint8_t h, OLED_C
  */
 void OLED_DrawEmptyRectangle(int16_t x, int16_t y, uint8_t w, uint8_t h)
 {
-  
-
-  for (int16_t i = x; i <= x + w; i++)
-  {
-    for (int16_t j = y; j <= y + h; j++)
-    {
-      OLED_GRAM[j / 8][i] &= ~(1 << (j % 8));
-    }
-  }
-
-  OLED_DrawLine(x, y, x + w, y, OLED_COLOR_NORMAL);
-  OLED_DrawLine(x, y + h, x + w, y + h, OLED_COLOR_NORMAL);
-  OLED_DrawLine(x, y, x, y + h, OLED_COLOR_NORMAL);
-  OLED_DrawLine(x + w, y, x + w, y + h, OLED_COLOR_NORMAL);
-  
+  // CHANGE: Area cleared with a span fill, clipped to the screen (the pixel loop wrote past OLED_GRAM) (2025.11.13)
+  _OLED_FillSpan(x, y, w + 1, h + 1, _OLED_SPAN_CLEAR);
+  OLED_DrawRectangle(x, y, w, h, OLED_COLOR_NORMAL);
 }
 
 
@@ -571,9 +623,9 @@ void OLED_DrawFilledRectangleWithCorners(int16_t x, int16_t y, uint8_t w, uint8_
   {
     OLED_DrawLine(x + 2, y + i, x + w - 2, y + i, color);
   }
-  for (uint8_t i = 2; i < h - 2; i++)
+  if (h > 4)
   {
-    OLED_DrawLine(x, y + i, x + w, y + i, color);
+    OLED_FillArea(x, y + 2, w + 1, h - 4, color); // CHANGE: One area fill for the straight middle rows
   }
   for (uint8_t i = h - 2; i < h; i++)
   {
@@ -770,7 +822,7 @@ void OLED_DrawEllipse(uint8_t x, uint8_t y, uint8_t a, uint8_t b, OLED_ColorMode
  */
 void OLED_DrawImage(uint8_t x, uint8_t y, const Image *img, OLED_ColorMode color)
 {
-  OLED_SetBlock(x, y, img->data, img->w, img->h, color);
+  OLED_BlitBlock(x, y, img->data, img->w, img->h, color);
 }
 
 // ================================ 文字绘制 ================================
@@ -785,7 +837,7 @@ void OLED_DrawImage(uint8_t x, uint8_t y, const Image *img, OLED_ColorMode color
  */
 void OLED_PrintASCIIChar(int16_t x, int16_t y, char ch, const ASCIIFont *font, OLED_ColorMode color)
 {
-  OLED_SetBlock(x, y, font->chars + (ch - ' ') * (((font->h + 7) / 8) * font->w), font->w, font->h, color);
+  OLED_BlitBlock(x, y, OLED_GetGlyph(font, ch), font->w, font->h, color);
 }
 
 /**
@@ -808,27 +860,71 @@ void OLED_PrintASCIIString(int16_t x, int16_t y, char *str, const ASCIIFont *fon
 }
 
 /**
- * @brief 获取UTF-8编码的字符长度
+ * @brief 解码一个UTF-8字符
+ * @param string 字符串
+ * @param code 输出 码点
+ * @return 字符占的字节数, 0为有问题的UTF-8编码
  */
-uint8_t _OLED_GetUTF8Len(char *string)
+// CHANGE: _OLED_GetUTF8Len() now also decodes the codepoint for the font index (2025.11.12)
+uint8_t _OLED_DecodeUTF8(const char *string, uint32_t *code)
 {
-  if ((string[0] & 0x80) == 0x00)
+  const uint8_t *s = (const uint8_t *)string;
+  uint8_t len;
+  if ((s[0] & 0x80) == 0x00)
   {
+    *code = s[0];
     return 1;
   }
-  else if ((string[0] & 0xE0) == 0xC0)
+  else if ((s[0] & 0xE0) == 0xC0)
   {
-    return 2;
+    *code = s[0] & 0x1F;
+    len = 2;
   }
-  else if ((string[0] & 0xF0) == 0xE0)
+  else if ((s[0] & 0xF0) == 0xE0)
   {
-    return 3;
+    *code = s[0] & 0x0F;
+    len = 3;
   }
-  else if ((string[0] & 0xF8) == 0xF0)
+  else if ((s[0] & 0xF8) == 0xF0)
+  {
+    *code = s[0] & 0x07;
+    len = 4;
+  }
+  else
   {
-    return 4;
+    return 0;
   }
-  return 0;
+  for (uint8_t i = 1; i < len; i++)
+  {
+    if ((s[i] & 0xC0) != 0x80) // 后续字节必须为10xxxxxx (字符串结尾的'\0'也会在这里被拦下)
+      return 0;
+    *code = (*code << 6) | (s[i] & 0x3F);
+  }
+  return len;
+}
+
+/**
+ * @brief 查找字模
+ * @param font 字体
+ * @param code 码点
+ * @return 字模的起始地址, 字库中没有时为NULL
+ * @note 码点表升序排列, 二分查找
+ */
+const uint8_t *OLED_FindGlyph(const Font *font, uint32_t code)
+{
+  uint16_t lo = 0;
+  uint16_t hi = font->len;
+  while (lo < hi)
+  {
+    uint16_t mid = (lo + hi) / 2;
+    if (font->codes[mid] < code)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo == font->len || font->codes[lo] != code)
+    return NULL;
+  return font->glyphs + lo * (((font->h + 7) / 8) * font->w);
 }
 
 /**
@@ -841,59 +937,36 @@ uint8_t _OLED_GetUTF8Len(char *string)
  *
  * @note 为保证字符串中的中文会被自动识别并绘制, 需:
  * 1. 编译器字符集设置为UTF-8
- * 2. 使用波特律动LED取模工具生成字模(https://led.baud-dance.com)
+ * 2. 使用波特律动LED取模工具生成字模(https://led.baud-dance.com), 再用Tools/font_index.py生成字库
  */
-
 void OLED_PrintString(uint8_t x, uint8_t y, char *str, const Font *font, OLED_ColorMode color)
 {
-  uint16_t i = 0;                                       // 字符串索引
-  uint8_t oneLen = (((font->h + 7) / 8) * font->w) + 4; // 一个字模占多少字节
-  uint8_t found;                                        // 是否找到字模
-  uint8_t utf8Len;                                      // UTF-8编码长度
-  uint8_t *head;                                        // 字模头指针
+  uint16_t i = 0;       // 字符串索引
+  uint8_t utf8Len;      // UTF-8编码长度
+  uint32_t code;        // 码点
+  const uint8_t *glyph; // 字模
   while (str[i])
   {
-    found = 0;
-    utf8Len = _OLED_GetUTF8Len(str + i);
+    utf8Len = _OLED_DecodeUTF8(str + i, &code);
     if (utf8Len == 0)
       break; // 有问题的UTF-8编码
 
-    // 寻找字符  TODO 优化查找算法, 二分查找或者hash
-    for (uint8_t j = 0; j < font->len; j++)
+    glyph = OLED_FindGlyph(font, code);
+    if (glyph)
     {
-      head = (uint8_t *)(font->chars) + (j * oneLen);
-      if (memcmp(str + i, head, utf8Len) == 0)
-      {
-        OLED_SetBlock(x, y, head + 4, font->w, font->h, color);
-        // 移动光标
-        x += font->w;
-        i += utf8Len;
-        found = 1;
-        break;
-      }
+      OLED_BlitBlock(x, y, glyph, font->w, font->h, color);
+      x += font->w;
     }
-
-    // 若未找到字模,且为ASCII字符, 则缺省显示ASCII字符
-    if (found == 0)
+    else
     {
-      if (utf8Len == 1)
-      {
-        OLED_PrintASCIIChar(x, y, str[i], font->ascii, color);
-        // 移动光标
-        x += font->ascii->w;
-        i += utf8Len;
-      }
-      else
-      {
-        OLED_PrintASCIIChar(x, y, ' ', font->ascii, color);
-        x += font->ascii->w;
-        i += utf8Len;
-      }
+      // 若未找到字模,且为ASCII字符, 则缺省显示ASCII字符, 否则显示空格
+      OLED_PrintASCIIChar(x, y, (utf8Len == 1) ? str[i] : ' ', font->ascii, color);
+      x += font->ascii->w;
     }
+    i += utf8Len;
   }
 }
 
-
 // CHANGE: Added my setCursor and printText methods from oled.cpp to avoid using buffer and improve performance (2025.10.9)
 // CHANGE: Deprecated. Instead, all page content will be done by my own class. (2025.10.11)
 
@@ -159,26 +159,58 @@ uint8_t menuSwitchFlag = 0;
  */
 uint8_t controlSelectionFlag = 0;
 
+/**
+ * @brief 重绘标志。
+ * 
+ * 1 表示菜单状态被外部控制接口改变（光标、控件值、菜单切换），下一帧需要重绘。
+ * 由 `OLEDUI_Draw` 清零。
+ * 
+ * CHANGE: Added, the caller skips the drawing of settled frames (2025.11.14)
+ */
+uint8_t menuRedrawFlag = 1;
+
 /**
  * @brief 动画进度变量，用于平滑过渡 UI 组件的移动效果。
  * 
- * 这些变量的值范围通常为 0.0 到 1.0，表示当前动画的进度。
+ * Q15 定点数，范围为 0 到 UI_MOVE_Q15_ONE（1.0），表示当前动画的进度。
+ * 
+ * CHANGE: float -> Q15, advanced by elapsed time in OLEDUI_Move() (2025.11.14)
  */
 
 /** @brief 框架 Y 方向的移动进度 */
-float moveProcess_FrameY = 0.0;
+uint16_t moveProcess_FrameY = 0;
 
 /** @brief 框架宽度变化的移动进度 */
-float moveProcess_FrameWidth = 0.0;
+uint16_t moveProcess_FrameWidth = 0;
 
 /** @brief 屏幕滚动的移动进度 */
-float moveProcess_Screen = 0.0;
+uint16_t moveProcess_Screen = 0;
 
 /** @brief 滚动条的移动进度 */
-float moveProcess_ScrollBar = 0.0;
+uint16_t moveProcess_ScrollBar = 0;
 
 /** @brief 开关控件滑块的移动进度 */
-float moveProcess_SwitchCtrlBar = 0.0;
+uint16_t moveProcess_SwitchCtrlBar = 0;
+
+/** @brief 菜单切换过渡已显示的帧数 */
+static uint8_t switchFrame = 0;
+
+/** @brief 上一次 OLEDUI_Move() 的时间(ms) */
+static uint32_t moveTick = 0;
+
+/** @brief 上一次 OLEDUI_Move() 时是否仍有元素在移动 */
+static uint8_t moveActive = 0;
+
+/**
+ * @brief Ease-In-Out 缓动表，Q15。
+ * 
+ * 2t² (t < 0.5) / 1 - 2(1-t)² 在 t = i/16 处的值，表项之间线性插值（误差 < 0.2%）。
+ */
+static const uint16_t easeTable[17] =
+{
+  0, 256, 1024, 2304, 4096, 6400, 9216, 12544, 16384,
+  20224, 23552, 26368, 28672, 30464, 31744, 32512, 32768
+};
 
 
 // ------------函数定义------------// 
@@ -590,6 +622,7 @@ void OLEDUI_Update()
 // CHANGE: Added new menu control functions
 // External menu control implementations
 void Menu_MoveRight() {
+	menuRedrawFlag = 1; // CHANGE: Added (2025.11.14)
 	if (controlSelectionFlag == 0) {
 		currentMenu->currentItemIndex++;
 		if (currentMenu->currentItemIndex >= currentMenu->itemCount) {
@@ -606,6 +639,7 @@ void Menu_MoveRight() {
 }
 
 void Menu_MoveLeft() {
+	menuRedrawFlag = 1; // CHANGE: Added (2025.11.14)
 	if (controlSelectionFlag == 0) {
 		if (currentMenu->currentItemIndex == 0) {
 			currentMenu->currentItemIndex = currentMenu->itemCount - 1;
@@ -623,6 +657,7 @@ void Menu_MoveLeft() {
 }
 
 void Menu_Confirm() {
+	menuRedrawFlag = 1; // CHANGE: Added (2025.11.14)
 	if (controlSelectionFlag == 0) {
 		if (currentMenu->items[currentMenu->currentItemIndex].subMenu != NULL) {
 			currentMenu = currentMenu->items[currentMenu->currentItemIndex].subMenu;
@@ -644,6 +679,7 @@ uint8_t Menu_GoBack() {
 	if (currentMenu->parentMenu && controlSelectionFlag == 0) {
 		currentMenu = currentMenu->parentMenu;
 		menuSwitchFlag = 1;
+		menuRedrawFlag = 1; // CHANGE: Added (2025.11.14)
 		return 1;
 	}
 	return 0;
@@ -653,17 +689,15 @@ uint8_t Menu_GoBack() {
  * @brief 更新框架显示目标值。
  * 
  * 根据当前菜单项索引，更新框架的 Y 坐标和宽度的目标值。
+ * 
+ * CHANGE: A transition starts only when the target changes. It was restarted
+ * every frame with lastVal = targetVal, so the frame jumped instead of
+ * moving (2025.11.14)
  */
 void Frame_Update()
 {
-  moveProcess_FrameY = 0.0;
-  moveProcess_FrameWidth = 0.0;
-
-  frameY.lastVal = frameY.targetVal;
-  frameWidth.lastVal = frameWidth.targetVal;
-
-  frameY.targetVal = currentMenu->currentItemIndex * MENU_ITEM_HEIGHT; // 更新 Y 目标值 */
-  frameWidth.targetVal = currentMenu->items[currentMenu->currentItemIndex].len * 6 + 4; // 更新宽度目标值 */
+  UI_StartTransition(&frameY, &moveProcess_FrameY, currentMenu->currentItemIndex * MENU_ITEM_HEIGHT); // 更新 Y 目标值 */
+  UI_StartTransition(&frameWidth, &moveProcess_FrameWidth, currentMenu->items[currentMenu->currentItemIndex].len * 6 + 4); // 更新宽度目标值 */
 }
 
 /**
@@ -688,7 +722,6 @@ void Screen_Update()
 {
   if (currentMenu->currentItemIndex > screenIndex.bottomIndex)
   {
-    moveProcess_Screen = 0.0;
     screenIndex.bottomIndex = currentMenu->currentItemIndex;
       screenIndex.topIndex = screenIndex.bottomIndex - (visibleCount - 1);
       if (screenIndex.topIndex < 0)
@@ -698,7 +731,6 @@ void Screen_Update()
   }
   else if (currentMenu->currentItemIndex < screenIndex.topIndex)
   {
-    moveProcess_Screen = 0.0;
     screenIndex.topIndex = currentMenu->currentItemIndex;
       screenIndex.bottomIndex = screenIndex.topIndex + (visibleCount - 1);
       if (screenIndex.bottomIndex > currentMenu->itemCount - 1)
@@ -708,8 +740,7 @@ void Screen_Update()
     }
   }
 
-  screenTop.lastVal = screenTop.targetVal;
-  screenTop.targetVal = screenIndex.topIndex * MENU_ITEM_HEIGHT; // 更新屏幕顶部目标值 */
+  UI_StartTransition(&screenTop, &moveProcess_Screen, screenIndex.topIndex * MENU_ITEM_HEIGHT); // 更新屏幕顶部目标值 */ // CHANGE: See Frame_Update()
 }
 
 /**
@@ -719,9 +750,7 @@ void Screen_Update()
  */
 void ScrollBar_Update(void)
 {
-  moveProcess_ScrollBar = 0.0;
-  scrollBarY.lastVal = scrollBarY.val;
-
+  int16_t target; // CHANGE: Started as a transition at the end, see Frame_Update()
   int16_t visibleCount = MENU_VISIBLE_ITEM_COUNT;
   if (visibleCount <= 0)
   {
@@ -731,17 +760,10 @@ void ScrollBar_Update(void)
   const int trackMargin = 2;
   const int trackHeight = OLED_SCREEN_HEIGHT - (trackMargin * 2);
 
-  if (currentMenu->itemCount == 0)
-  {
-    scrollBarHeight = trackHeight;
-    scrollBarY.targetVal = trackMargin;
-    return;
-  }
-
-  if (currentMenu->itemCount <= visibleCount)
+  if (currentMenu->itemCount <= visibleCount) // CHANGE: itemCount == 0 included
   {
     scrollBarHeight = trackHeight;
-    scrollBarY.targetVal = trackMargin;
+    target = trackMargin;
   }
   else
   {
@@ -754,13 +776,15 @@ void ScrollBar_Update(void)
 
     int moveRange = trackHeight - scrollBarHeight;
     float step = (currentMenu->itemCount > 1) ? ((float)moveRange / (currentMenu->itemCount - 1)) : 0.0f;
-    scrollBarY.targetVal = trackMargin + (int)(step * currentMenu->currentItemIndex + 0.5f);
+    target = trackMargin + (int)(step * currentMenu->currentItemIndex + 0.5f);
     int maxTarget = trackMargin + moveRange;
-    if (scrollBarY.targetVal > maxTarget)
+    if (target > maxTarget)
     {
-      scrollBarY.targetVal = maxTarget;
+      target = maxTarget;
     }
   }
+
+  UI_StartTransition(&scrollBarY, &moveProcess_ScrollBar, target);
 }
 
 /**
@@ -770,8 +794,7 @@ void ScrollBar_Update(void)
  */
 void switchCtrlBar_Update(void)
 {
-    moveProcess_SwitchCtrlBar = 0.0;
-    switchCtrlBar.lastVal = switchCtrlBar.val;
+    int16_t target; // CHANGE: Started as a transition at the end, see Frame_Update()
 
     // CHANGE: Added outer if-else to avoid accessing uninitialized pointers
     if (currentMenu && 
@@ -782,18 +805,20 @@ void switchCtrlBar_Update(void)
     {
 		if (*(currentMenu->items[currentMenu->currentItemIndex].control->data) == 0)
 		{
-			switchCtrlBar.targetVal = 64 + 2; // 开关关闭位置 */
+			target = 64 + 2; // 开关关闭位置 */
 		}
 		else
 		{
-			switchCtrlBar.targetVal = 64 - 30 + 2; // 开关开启位置 */
+			target = 64 - 30 + 2; // 开关开启位置 */
 		}
     }
     else
     {
 		// Default position if no valid control data
-		switchCtrlBar.targetVal = 64 + 2;
+		target = 64 + 2;
     }
+
+    UI_StartTransition(&switchCtrlBar, &moveProcess_SwitchCtrlBar, target);
 }
 
 // /**
@@ -818,59 +843,94 @@ void switchCtrlBar_Update(void)
  * 
  * 该函数通过 `UI_SmoothTransition` 让多个 UI 组件（如框架、滚动条、开关控件等）平滑移动到目标位置，增强界面动画效果。
  * 
+ * @return uint8_t 返回 1 表示本次有元素移动，0 表示全部静止（调用者可以跳过重绘）。
+ * 
  * @note 
  * - 每个 UI 元素都有一个对应的移动进度变量 (`moveProcess_*`)，用于控制过渡进度。
  * - `UI_SmoothTransition` 采用缓动算法，使动画更加自然。
  * - 该函数应在主循环中定期调用，以维持 UI 的平滑动画。
+ * 
+ * CHANGE: The progress advances by the time since the last call
+ * (UI_MOVE_TIME_MS per transition) instead of 0.1 per call, so the speed no
+ * longer follows the frame rate. Q15 integer math, no float (2025.11.14)
  */
-void OLEDUI_Move(void)
+uint8_t OLEDUI_Move(void)
 {
-  UI_SmoothTransition(&frameY, &moveProcess_FrameY, 0.1);
-  UI_SmoothTransition(&frameWidth, &moveProcess_FrameWidth, 0.1);
-  UI_SmoothTransition(&screenTop, &moveProcess_Screen, 0.1);
-  // UI_SmoothTransition(&scrollBarY, &moveProcess_ScrollBar, 0.1);        // CHANGE: ScrollBar has some display issue
-  // UI_SmoothTransition(&switchCtrlBar, &moveProcess_SwitchCtrlBar, 0.1); // CHANGE: Not used
+  uint32_t now = HAL_GetTick();
+  uint32_t elapsed = moveActive ? (now - moveTick) : UI_MOVE_FIRST_STEP_MS;
+  moveTick = now;
+
+  uint16_t step = (elapsed >= UI_MOVE_TIME_MS) ? UI_MOVE_Q15_ONE
+                                               : (uint16_t)(elapsed * UI_MOVE_Q15_ONE / UI_MOVE_TIME_MS);
+
+  uint8_t done = 1;
+  done &= UI_SmoothTransition(&frameY, &moveProcess_FrameY, step);
+  done &= UI_SmoothTransition(&frameWidth, &moveProcess_FrameWidth, step);
+  done &= UI_SmoothTransition(&screenTop, &moveProcess_Screen, step);
+  // UI_SmoothTransition(&scrollBarY, &moveProcess_ScrollBar, step);        // CHANGE: ScrollBar has some display issue
+  // UI_SmoothTransition(&switchCtrlBar, &moveProcess_SwitchCtrlBar, step); // CHANGE: Not used
+
+  uint8_t moved = moveActive || !done; // 到达目标的这一步也改变了显示
+  moveActive = !done;
+  return moved;
 }
 
+/**
+ * @brief 开始 UI 元素的过渡动画。
+ * 
+ * 目标值改变时，从当前值（可能正处于上一次过渡中）开始向新目标值移动；目标值不变时不做任何事。
+ * 
+ * @param elem         指向需要更新的 UI 元素。
+ * @param moveProcess  移动进度指针（Q15）。
+ * @param targetVal    新的目标值。
+ * 
+ * CHANGE: Added (2025.11.14)
+ */
+void UI_StartTransition(UIElemTypedef *elem, uint16_t *moveProcess, int16_t targetVal)
+{
+  if (elem->targetVal == targetVal)
+  {
+    return;
+  }
+  elem->lastVal = elem->val;
+  elem->targetVal = targetVal;
+  *moveProcess = 0;
+}
 
 /**
  * @brief 更新 UI 元素的移动状态。
  * 
- * 根据当前进度和移动速度，逐步将 UI 元素的值从 `lastVal` 平滑过渡到 `targetVal`。
+ * 根据当前进度和移动步长，逐步将 UI 元素的值从 `lastVal` 平滑过渡到 `targetVal`。
  * 
  * @param elem         指向需要更新的 UI 元素。
- * @param moveProcess  移动进度指针（0.0 到 1.0）。
- * @param moveSpeed    移动速度，每次调用增加的进度量。
+ * @param moveProcess  移动进度指针（Q15，0 到 UI_MOVE_Q15_ONE）。
+ * @param moveStep     本次增加的进度量（Q15）。
  * @return uint8_t     返回 1 表示移动完成，0 表示未完成。
+ * 
+ * CHANGE: float -> Q15 (2025.11.14)
  */
-uint8_t UI_SmoothTransition(UIElemTypedef *elem, float *moveProcess, float moveSpeed)
+uint8_t UI_SmoothTransition(UIElemTypedef *elem, uint16_t *moveProcess, uint16_t moveStep)
 {
   if (elem->val == elem->targetVal)
   {
+    *moveProcess = UI_MOVE_Q15_ONE;
     return 1;
   }
-  if (*moveProcess < 1.0)
-  {
-    *moveProcess += moveSpeed;
-  }
-  if (*moveProcess > 1.0)
-  {
-    *moveProcess = 1.0;
-  } 
-
-  float easedProcess = easeInOut(*moveProcess);
 
-  elem->val = (int16_t)((1.0 - easedProcess) * elem->lastVal + easedProcess * elem->targetVal);
-
-  if (*moveProcess == 1.0)
+  if (UI_MOVE_Q15_ONE - *moveProcess > moveStep)
   {
-    elem->val = elem->targetVal;
-    return 1;
+    *moveProcess += moveStep;
   }
   else
   {
-    return 0;
+    *moveProcess = UI_MOVE_Q15_ONE;
+    elem->val = elem->targetVal;
+    return 1;
   }
+
+  int32_t easedProcess = easeInOut(*moveProcess);
+  elem->val = (int16_t)(elem->lastVal + (int32_t)(elem->targetVal - elem->lastVal) * easedProcess / UI_MOVE_Q15_ONE);
+  return 0;
 }
 
 /**
@@ -883,9 +943,25 @@ uint8_t UI_SmoothTransition(UIElemTypedef *elem, float *moveProcess, float moveS
  */
 void OLEDUI_Show()
 {
+  OLEDUI_Draw();
+  OLED_ShowFrame(); // CHANGE: Moved here from DrawMenuItems() / DrawControlSelection()
+}
+
+/**
+ * @brief 绘制当前 UI 到显存，不发送到屏幕。
+ * 
+ * CHANGE: Split out of OLEDUI_Show(). The caller sends the frame, e.g. one
+ * page per call with OLED_ShowFramePage(), so a long I2C transfer does not
+ * block the pad scan. (2025.10.20)
+ */
+void OLEDUI_Draw()
+{
+  menuRedrawFlag = 0; // CHANGE: Added (2025.11.14)
+
   if (menuSwitchFlag == 1)
   {
     InterfaceSwitch();
+    return; // CHANGE: This frame shows the dissolving old menu (2025.11.14)
   }
 
   if (controlSelectionFlag == 0)
@@ -901,17 +977,21 @@ void OLEDUI_Show()
 /**
  * @brief 菜单切换过渡效果。
  * 
- * 显示菜单切换动画，通过三次快速消失与重绘实现。
+ * 显示菜单切换动画，通过 UI_SWITCH_FRAMES 帧的逐步消失实现，每次调用推进一帧。
+ * 
+ * CHANGE: One dissolve step per frame instead of three steps with
+ * OLED_ShowFrame() and HAL_Delay(50) in one call, which blocked the pad scan
+ * for over 150 ms. The frames are paced by the caller (2025.11.14)
  */
 void InterfaceSwitch()
 {
-  menuSwitchFlag = 0;
-  for (uint8_t i = 0; i < 3; i++)
+  OLED_Disappear();
+  if (++switchFrame >= UI_SWITCH_FRAMES)
   {
-    OLED_Disappear();
-    OLED_ShowFrame();
-    HAL_Delay(50); // 在 FreeRTOS 中使用非阻塞式延时 */
+    switchFrame = 0;
+    menuSwitchFlag = 0;
   }
+  menuRedrawFlag = 1; // 下一帧继续消失或显示新菜单
 }
 
 /**
@@ -956,7 +1036,7 @@ void DrawMenuItems()
   DrawSelectionFrame();
   // DrawScrollBar(); // CHANGE: ScrollBar has some display issue
 
-  OLED_ShowFrame();
+  // OLED_ShowFrame(); // CHANGE: Frame is sent by OLEDUI_Show() or by the caller of OLEDUI_Draw()
 }
 
 /**
@@ -993,7 +1073,7 @@ void DrawControlSelection()
       break;  
   }
 
-  OLED_ShowFrame();
+  // OLED_ShowFrame(); // CHANGE: Frame is sent by OLEDUI_Show() or by the caller of OLEDUI_Draw()
 }
 
 /**
@@ -1167,15 +1247,19 @@ void DrawSliderControl(ControlTypedef *control)
  * 
  * 用于计算缓动效果的进度值，使移动过程更加平滑。
  * 
- * @param t 输入的进度值，范围为 0.0 到 1.0。
- * @return float 返回缓动后的进度值。
+ * @param t 输入的进度值（Q15），范围为 0 到 UI_MOVE_Q15_ONE。
+ * @return uint16_t 返回缓动后的进度值（Q15）。
+ * 
+ * CHANGE: float -> Q15, looked up in easeTable (2025.11.14)
  */
-float easeInOut(float t) 
+uint16_t easeInOut(uint16_t t) 
 {
-  if (t < 0.5)
-    return 2 * t * t;
-  else
-    return -1 + (4 - 2 * t) * t;
+  if (t >= UI_MOVE_Q15_ONE)
+    return UI_MOVE_Q15_ONE;
+
+  uint8_t i = t >> 11;           // 16 段，每段 2048
+  uint16_t frac = t & 0x7FF;
+  return easeTable[i] + (uint16_t)(((uint32_t)(easeTable[i + 1] - easeTable[i]) * frac) >> 11);
 }
 
 /**
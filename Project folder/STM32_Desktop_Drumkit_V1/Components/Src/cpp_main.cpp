@@ -22,7 +22,18 @@
 #include "cpp_main.h"
 #include "pad.h"
 #include "midi.h"
+#include "midi_in.h"
 #include "ui.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "logger.h"
+#include "trace.h"
+#include "wavestream.h"
+#include "hitrec.h"
+#include "hitcapture.h"
+#include "shell.h"
+#include "health.h"
+#include "oled_bus.h"
 
 /**
  * @brief Hit threshold offset value
@@ -33,6 +44,24 @@
  */
 #define HIT_THRESHOLD_OFFSET 310
 
+/**
+ * @brief Scheduler task periods and priorities (0 = highest)
+ * 
+ * Pads are scanned at the ADC sequence rate (480-cycle sampling, ~10 kHz),
+ * MIDI output runs whenever it has something to send, the button is ticked
+ * at 1 kHz and the UI refreshes at 25 Hz, one display page per slice.
+ */
+#define TASK_PADS_PERIOD_US 100
+#define TASK_BUTTON_PERIOD_US 1000
+#define TASK_LINK_PERIOD_US 1000
+#define TASK_UI_PERIOD_US 40000
+
+#define TASK_PADS_PRIO 0
+#define TASK_MIDI_PRIO 1
+#define TASK_BUTTON_PRIO 2
+#define TASK_LINK_PRIO 3
+#define TASK_UI_PRIO 4
+
 /**
  * @brief Initialize all drum pads
  * 
@@ -63,18 +92,167 @@ Pad HighTom		(Pad::ADC_3, 2     , HT_OUT_GPIO_Port		 , HT_OUT_Pin		 , Pad::HighT
  * the sampling time of ADC channels should be set to 480 cycles.
  */
 
+/**
+ * @brief All pad instances, indexed by Pad::PadID
+ */
+Pad* pads[Pad::PAD_NUM] = {
+	&OpenHiHat, &CloseHiHat, &Crash, &Ride,
+	&SideStick, &Kick, &Snare,
+	&MidTom, &LowTom, &HighTom
+};
+
 Midi midi; // MIDI communication handler
 
 bool triggered[Pad::PAD_NUM] = { false }; // Pad trigger state array
 
+static uint8_t padsMeasuring = 0; // Pads with an open measuring window, updated by the pad task
+
 char dbg_buf[128]; // Debug message buffer
 
 /**
- * @brief Send debug message via UART
+ * @brief Queue debug message for USART1 (asynchronous, see Logger)
  * @param str Debug message string
+ * 
+ * Kept for raw strings; new code should use the LOG_x macros.
  */
 void DBG(const char* str) {
-	HAL_UART_Transmit(&huart1, (uint8_t*)str, strlen(str), 1000);
+	logger.write(LOG_LVL_INFO, str);
+}
+
+/**
+ * @brief Pad scan task (periodic, highest priority)
+ * 
+ * Detects hits, measures force and queues finished hits into the MIDI burst.
+ */
+static bool Task_Pads() {
+	PROF_SCOPE(PAD_SCAN);
+
+	uint8_t measuring = 0; // Pads with an open measuring window (keeps the MIDI burst open)
+
+	hitCapture.sample(); // Pre-trigger history, before any trigger of this scan
+
+	for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+		pads[i]->detectHit();
+		if (pads[i]->isTriggered()) {
+			triggered[i] = true;
+			hitCapture.trigger(pads[i]->getID(), pads[i]->getHitCycles(), pads[i]->getHitThreshold());
+		}
+
+		if (triggered[i]) {
+			PROF_SCOPE(MEASURE_FORCE);
+			pads[i]->measureForce();
+		}
+
+		if (pads[i]->isMeasurementCplt()) {
+			TRACE_D("Hit pad %u force %u", pads[i]->getID(), pads[i]->getForce());
+
+			ui.updatePadStats(pads[i]->getID(), 1);
+			
+			// Coalesced with other hits finishing in the same window, sent by the MIDI task.
+			// Queued even while the link is down: MIDI holds it and replays it on reconnect.
+			Midi::QueueResult result = midi.queueNoteOn(pads[i]->getID(), pads[i]->getForce(), pads[i]->getHitCycles());
+
+			HitRecorder::Event ev;
+			uint16_t window = pads[i]->getLastWindowMs();
+			ev.tick = HAL_GetTick();
+			ev.peak = pads[i]->getLastPeak();
+			ev.threshold = pads[i]->getHitThreshold();
+			ev.pad_result = (uint8_t)(pads[i]->getID() | (result << 4));
+			ev.velocity = pads[i]->getForce();
+			ev.window_ms = (window > 255) ? 255 : (uint8_t)window;
+			ev.queue_depth = midi.getBurstPending();
+			hitRecorder.record(ev);
+
+			// This section is for pad insts upper_limit testing. Use MaxF value for reference.
+			// Hit your pads (with large force) multiple times and record the maxF value.
+			// This value differs because of sensor sensitivity, drumpad fastness, and adc sampling speed.
+			// Then set the pad's upper_limit to a value slightly LESS than maxF.
+			//
+			// sprintf(dbg_buf, "Pad %s MIDI force: %d\r\n", pads[i]->ID2Str(pads[i]->getID()), pads[i]->getForce());
+			// DBG(dbg_buf);
+			// static uint16_t maxF[Pad::PAD_NUM] = { 0 };
+			// uint16_t peak_val = pads[i]->getPeak_DBG();
+			// if (peak_val > maxF[i]) {
+			// 	maxF[i] = peak_val;
+			// }
+			// sprintf(dbg_buf, "MaxF for %s: %d\r\n", pads[i]->ID2Str(pads[i]->getID()), maxF[i]);
+			// DBG(dbg_buf);
+
+			pads[i]->resetMeasurementCplt();
+			triggered[i] = false;
+		}
+
+		if (pads[i]->isMeasuring()) { measuring++; }
+	}
+
+	padsMeasuring = measuring;
+
+	// Raw ADC waveform for calibration (settings menu "Wave Stream", see wavestream.h)
+	waveStream.sample();
+
+	return false;
+}
+
+/**
+ * @brief MIDI output task (event, released by Midi::hasWork())
+ * 
+ * Sends a pending SysEx reply in slices, flushes due bursts (held notes
+ * first) and sends due Note Offs.
+ */
+static bool Task_Midi() {
+	uint8_t queued = midi.getBurstPending();
+	uint8_t sent = midi.flushBurst(padsMeasuring);
+	if (queued && !midi.getBurstPending()) {
+		if (sent < queued) {
+			TRACE_W("MIDI link down, %u notes held", midi.getHeldCount());
+		}
+		if (sent) {
+			TRACE_D("MIDI burst sent %u/%u notes", sent, queued);
+		}
+	}
+
+	if (midi.isConnected()) {
+		PROF_SCOPE(AUTO_NOTE_OFF);
+		midi.autoNoteOff();
+	}
+	return false;
+}
+
+static bool Ready_Midi() {
+	return midi.hasWork(padsMeasuring);
+}
+
+/**
+ * @brief Button tick task (1 kHz)
+ */
+static bool Task_Button() {
+	ui.buttonTick();
+	return false;
+}
+
+/**
+ * @brief MIDI link task (1 kHz): connection state, MIDI input, log / OLED DMA restart,
+ *        wave stream switching, hit recorder dump, hit capture shipping, serial shell
+ *        and health counters
+ */
+static bool Task_Link() {
+	logger.poll();
+	oledBus.poll();
+	health.poll();
+	waveStream.poll();
+	hitRecorder.poll();
+	hitCapture.poll();
+	ui.updateMidiConn(midi.isConnected());
+	midiIn.poll(padsMeasuring == 0 && midi.getBurstPending() == 0);
+	shell.poll(padsMeasuring == 0);
+	return false;
+}
+
+/**
+ * @brief UI task (25 Hz, lowest priority), resumable: one display page per slice
+ */
+static bool Task_UI() {
+	return ui.update();
 }
 
 /**
@@ -84,26 +262,29 @@ void DBG(const char* str) {
  * 1. Waits for power on
  * 2. Initializes ADC DMA for pad sensing
  * 3. Initializes UI components
- * 4. Enters main processing loop:
- *    - Updates UI
- *    - Processes pad hits
- *    - Handles MIDI communication
+ * 4. Registers the scheduler tasks and runs them until power off:
+ *    - Pad scan (periodic, highest priority)
+ *    - MIDI output (when there is something to send)
+ *    - Button tick, MIDI link / input
+ *    - UI refresh (resumable, lowest priority)
  * 
  * @return int Application exit status (never returns)
  */
 int cpp_main() {
-	
+
+	DWT_Init(); // Cycle counter for hit timestamps
+
 	ui.buttonInit(12, 400, 600, 900);
 	
 	while (!ui.chkPower()) { ui.buttonTick(); }
 
-	DBG("Power on.\r\n");
+	LOG_I("Power on.");
 
 	HAL_ADC_Start_DMA(&hadc1, (uint32_t*)Pad::adc1_buf, ADC1_PAD_NUMS);
 	HAL_ADC_Start_DMA(&hadc2, (uint32_t*)Pad::adc2_buf, ADC2_PAD_NUMS);
 	HAL_ADC_Start_DMA(&hadc3, (uint32_t*)Pad::adc3_buf, ADC3_PAD_NUMS);
 
-	DBG("OLED init...\r\n");
+	LOG_I("OLED init...");
 	ui.init();
 	ui.welcome();
 
@@ -124,91 +305,29 @@ int cpp_main() {
 	// 	}
 	// }
 
-	midi.isConnected() ? DBG("MIDI connected.\r\n") : DBG("MIDI not connected.\r\n");
+	midi.isConnected() ? LOG_I("MIDI connected.") : LOG_I("MIDI not connected.");
+	midiIn.begin();
+	shell.begin();
 
-	Pad* pads[Pad::PAD_NUM] = {
-		&OpenHiHat, &CloseHiHat, &Crash, &Ride,
-		&SideStick, &Kick, &Snare,
-		&MidTom, &LowTom, &HighTom
-	};
+	if (health.getFatalCount()) {
+		LOG_W("Error_Handler was hit before this reset (%lu since power on, last caller 0x%08lx)",
+			  health.getFatalCount(), health.getFatalCaller());
+	}
 
-	DBG("Setup done, entering main loop.\r\n");
-	while (ui.chkPower()) {
-		ui.update();
-
-		for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
-			pads[i]->detectHit();
-			if (pads[i]->isTriggered()) {
-				triggered[i] = true;
-			}
-
-			if (triggered[i]) {
-				pads[i]->measureForce();
-			}
-
-			if (pads[i]->isMeasurementCplt()) {
-				DBG("--\r\n");
-
-				ui.updatePadStats(pads[i]->getID(), 1);
-				
-				if (midi.isConnected()) {
-					if (!midi.sendNoteOn(pads[i]->getID(), pads[i]->getForce(), 10)) {
-						DBG("MIDI note sending failed!\r\n");
-					} else {
-						sprintf(dbg_buf, "MIDI Note On sent %d\r\n", pads[i]->getForce());
-						DBG(dbg_buf);
-						ui.updateMidiStats();
-					}
-				} else {
-					// DBG("MIDI not connected!\r\n");
-					ui.updateMidiConn(false);
-				}
-
-				// This section is for pad insts upper_limit testing. Use MaxF value for reference.
-				// Hit your pads (with large force) multiple times and record the maxF value.
-				// This value differs because of sensor sensitivity, drumpad fastness, and adc sampling speed.
-				// Then set the pad's upper_limit to a value slightly LESS than maxF.
-				//
-				// sprintf(dbg_buf, "Pad %s MIDI force: %d\r\n", pads[i]->ID2Str(pads[i]->getID()), pads[i]->getForce());
-				// DBG(dbg_buf);
-				// static uint16_t maxF[Pad::PAD_NUM] = { 0 };
-				// uint16_t peak_val = pads[i]->getPeak_DBG();
-				// if (peak_val > maxF[i]) {
-				// 	maxF[i] = peak_val;
-				// }
-				// sprintf(dbg_buf, "MaxF for %s: %d\r\n", pads[i]->ID2Str(pads[i]->getID()), maxF[i]);
-				// DBG(dbg_buf);
-
-				pads[i]->resetMeasurementCplt();
-				triggered[i] = false;
-			}
-		}
+	LOG_I("Setup done, entering main loop.");
 
-		// Below is for ADC value waveform debugging.
-		//
-		// uint16_t opHihat_val, clHihat_val, crash_val, ride_val, kick_val,
-		//  		 snare_val, ssdk_val, htom_val, mtom_val, ltom_val;
-		// opHihat_val = OpenHiHat.getADCVal_DBG();
-		// clHihat_val = CloseHiHat.getADCVal_DBG();
-		// crash_val = Crash.getADCVal_DBG();
-		// ride_val = Ride.getADCVal_DBG();
-		// kick_val = Kick.getADCVal_DBG();
-		// snare_val = Snare.getADCVal_DBG();
-		// ssdk_val = SideStick.getADCVal_DBG();
-		// htom_val = HighTom.getADCVal_DBG();
-		// mtom_val = MidTom.getADCVal_DBG();
-		// ltom_val = LowTom.getADCVal_DBG();
-		// sprintf(dbg_buf, "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\r\n",
-		// 		opHihat_val, clHihat_val, crash_val, ride_val, kick_val,
-		// 		snare_val, ssdk_val, htom_val, mtom_val, ltom_val);
-		// DBG(dbg_buf);
-
-		if (midi.isConnected()) {
-			midi.autoNoteOff();
-		}
-		ui.updateMidiConn(midi.isConnected());
+	scheduler.addPeriodic("pads", Task_Pads, TASK_PADS_PERIOD_US, TASK_PADS_PRIO);
+	scheduler.addEvent("midi", Task_Midi, Ready_Midi, TASK_MIDI_PRIO);
+	scheduler.addPeriodic("button", Task_Button, TASK_BUTTON_PERIOD_US, TASK_BUTTON_PRIO);
+	scheduler.addPeriodic("link", Task_Link, TASK_LINK_PERIOD_US, TASK_LINK_PRIO);
+	scheduler.addPeriodic("ui", Task_UI, TASK_UI_PERIOD_US, TASK_UI_PRIO);
+
+	while (ui.chkPower()) {
+		uint32_t loopStart = DWT_GetCycles();
+		scheduler.runOnce();
+		health.loopTick(DWT_GetCycles() - loopStart);
 
-		// HAL_GPIO_TogglePin(LED_GPIO_Port, LED_Pin);  // This is for debugging, to see how fast the loop runs.
+		// Loop timing: see the profiler / health pages, Profiler::dumpStats() and Health::dump()
 	}
 
 
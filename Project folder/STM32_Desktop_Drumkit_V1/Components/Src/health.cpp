@@ -0,0 +1,206 @@
+/**
+ * @file health.cpp
+ * @brief Runtime health counters (loop rate, ADC/DMA/I2C/UART faults)
+ *
+ * This file implements the Health class, the HAL ADC / I2C error callbacks
+ * and the fatal record written by Error_Handler (see health.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "health.h"
+#include "string.h"
+#include "cpp_main.h"
+#include "dwt.h"
+#include "logger.h"
+#include "pad.h"
+
+#define HEALTH_FATAL_MAGIC 0x4845414CUL // "HEAL", fatal record valid
+
+Health health; // Global health instance
+
+/**
+ * @brief Error_Handler record, kept over a reset (CCMRAM, not zeroed by the startup code)
+ */
+struct FatalRecord {
+    uint32_t magic;
+    uint32_t count;                     // Error_Handler calls since power on
+    uint32_t caller;                    // Caller of the last one
+};
+
+static FatalRecord fatalRecord __attribute__((section(".ccmbss")));
+
+/**
+ * @brief Construct a new Health object
+ *
+ * Runs before main(), so the fatal record is valid before the first
+ * MX_xxx_Init() can fail.
+ */
+Health::Health() :
+    _loops(0),
+    _loops_at_rate(0),
+    _loop_rate(0),
+    _loop_max_cycles(0),
+    _rate_tick(0),
+    _adc_restart(0) {
+    memset((void*)_counters, 0, sizeof(_counters));
+    if (fatalRecord.magic != HEALTH_FATAL_MAGIC) { // Power on: CCMRAM content is random
+        fatalRecord.magic = HEALTH_FATAL_MAGIC;
+        fatalRecord.count = 0;
+        fatalRecord.caller = 0;
+    }
+}
+
+/**
+ * @brief Update the loop rate and restart stopped ADC DMAs
+ *
+ * An overrun stops the ADC DMA requests; the stream is restarted here
+ * rather than in the interrupt since HAL_ADC_Stop_DMA() waits for the
+ * DMA to disable.
+ */
+void Health::poll() {
+    uint32_t now = HAL_GetTick();
+    if (now - _rate_tick >= HEALTH_RATE_PERIOD_MS) {
+        uint32_t loops = _loops;
+        _loop_rate = (loops - _loops_at_rate) * 1000UL / (now - _rate_tick);
+        _loops_at_rate = loops;
+        _rate_tick = now;
+    }
+
+    if (_adc_restart) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint8_t restart = _adc_restart;
+        _adc_restart = 0;
+        __set_PRIMASK(primask);
+
+        if (restart & 0x01) {
+            HAL_ADC_Stop_DMA(&hadc1);
+            HAL_ADC_Start_DMA(&hadc1, (uint32_t*)Pad::adc1_buf, ADC1_PAD_NUMS);
+        }
+        if (restart & 0x02) {
+            HAL_ADC_Stop_DMA(&hadc2);
+            HAL_ADC_Start_DMA(&hadc2, (uint32_t*)Pad::adc2_buf, ADC2_PAD_NUMS);
+        }
+        if (restart & 0x04) {
+            HAL_ADC_Stop_DMA(&hadc3);
+            HAL_ADC_Start_DMA(&hadc3, (uint32_t*)Pad::adc3_buf, ADC3_PAD_NUMS);
+        }
+    }
+}
+
+/**
+ * @brief Clear all counters (the fatal record is kept)
+ */
+void Health::reset() {
+    memset((void*)_counters, 0, sizeof(_counters));
+    _loop_max_cycles = 0;
+}
+
+/**
+ * @brief Get the longest main loop iteration
+ * @return uint32_t Time in us
+ */
+uint32_t Health::getLoopMaxUs() {
+    return DWT_CyclesToUs(_loop_max_cycles);
+}
+
+/**
+ * @brief Get number of Error_Handler calls since power on
+ * @return uint32_t Call count
+ */
+uint32_t Health::getFatalCount() {
+    return fatalRecord.count;
+}
+
+/**
+ * @brief Get the caller of the last Error_Handler
+ * @return uint32_t Code address (0 if none)
+ */
+uint32_t Health::getFatalCaller() {
+    return fatalRecord.caller;
+}
+
+/**
+ * @brief Log all counters (INFO)
+ */
+void Health::dump() {
+    LOG_I("Health: loop %lu/s max %luus, fatal errors %lu (last caller 0x%08lx)",
+          _loop_rate, getLoopMaxUs(), fatalRecord.count, fatalRecord.caller);
+    for (uint8_t i = 0; i < HEALTH_COUNTER_NUM; i++) {
+        LOG_I("  %-13s %lu", Counter2Str(static_cast<HealthCounter>(i)), _counters[i]);
+    }
+}
+
+/**
+ * @brief Convert a counter to a short name
+ * @param counter HealthCounter
+ * @return const char* Name (max 13 characters)
+ */
+const char* Health::Counter2Str(HealthCounter counter) {
+    switch (counter) {
+        case HEALTH_ADC_OVERRUN:      return "ADC overrun";
+        case HEALTH_DMA_ERROR:        return "DMA error";
+        case HEALTH_I2C_BUSY:         return "I2C busy";
+        case HEALTH_I2C_RETRY:        return "I2C retry";
+        case HEALTH_I2C_TIMEOUT:      return "I2C timeout";
+        case HEALTH_I2C_ERROR:        return "I2C error";
+        case HEALTH_OLED_DROP:        return "OLED dropped";
+        case HEALTH_UART_TX_TIMEOUT:  return "UART TX fail";
+        case HEALTH_MIDI_ACK_TIMEOUT: return "MIDI ACK T/O";
+        default:                      return "Unknown";
+    }
+}
+
+extern "C" {
+
+/**
+ * @brief Increment a health counter (C entry)
+ * @param counter HealthCounter
+ */
+void Health_Count(uint8_t counter) {
+    if (counter < HEALTH_COUNTER_NUM) { health.count(static_cast<HealthCounter>(counter)); }
+}
+
+/**
+ * @brief Record a fatal error
+ * @param caller Return address of Error_Handler
+ */
+void Health_Fatal(uint32_t caller) {
+    if (fatalRecord.magic != HEALTH_FATAL_MAGIC) {
+        fatalRecord.magic = HEALTH_FATAL_MAGIC;
+        fatalRecord.count = 0;
+    }
+    fatalRecord.count++;
+    fatalRecord.caller = caller;
+#if HEALTH_FATAL_RESET
+    NVIC_SystemReset();
+#endif
+}
+
+/**
+ * @brief ADC error callback (overrun or DMA error)
+ * @param hadc ADC handle
+ */
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc) {
+    if (hadc->ErrorCode & HAL_ADC_ERROR_OVR) { health.count(HEALTH_ADC_OVERRUN); }
+    if (hadc->ErrorCode & HAL_ADC_ERROR_DMA) { health.count(HEALTH_DMA_ERROR); }
+
+    if (hadc->Instance == ADC1) { health._adc_restart |= 0x01; }
+    else if (hadc->Instance == ADC2) { health._adc_restart |= 0x02; }
+    else if (hadc->Instance == ADC3) { health._adc_restart |= 0x04; }
+}
+
+/**
+ * @brief I2C error callback (OLED)
+ * @param hi2c I2C handle
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    health.count(HEALTH_I2C_ERROR);
+    if (hi2c->ErrorCode & HAL_I2C_ERROR_DMA) { health.count(HEALTH_DMA_ERROR); }
+}
+
+} // extern "C"
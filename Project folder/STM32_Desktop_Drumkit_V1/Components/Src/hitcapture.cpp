@@ -0,0 +1,162 @@
+/**
+ * @file hitcapture.cpp
+ * @brief Pre-trigger waveform capture of each hit
+ *
+ * This file implements the HitCapture class: history rings, capture pool
+ * and block encoding (see hitcapture.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "hitcapture.h"
+#include "string.h"
+#include "trace.h"
+#include "logger.h"
+
+HitCapture hitCapture; // Global hit capture instance
+
+// CCMRAM, cleared by the constructor (see STM32F405XX_FLASH.ld, .ccmbss)
+static uint16_t capHistory[Pad::PAD_NUM][CAP_PRE_SAMPLES] __attribute__((section(".ccmbss")));
+static HitCapture::Capture capPool[CAP_SLOTS] __attribute__((section(".ccmbss")));
+
+static uint8_t capTxBuf[CAP_PAYLOAD_SIZE]; // Encoded block (SRAM)
+
+static_assert(CAP_SAMPLES % 2 == 0 && CAP_PRE_SAMPLES < CAP_SAMPLES, "Samples are packed in pairs");
+
+/**
+ * @brief Construct a new HitCapture object
+ */
+HitCapture::HitCapture() :
+    _enabled(false),
+    _histPos(0),
+    _seq(0),
+    _sent(0),
+    _dropped(0) {
+    _reset();
+}
+
+/**
+ * @brief Clear the history rings and free all slots
+ */
+void HitCapture::_reset() {
+    memset(capHistory, 0, sizeof(capHistory));
+    memset(capPool, 0, sizeof(capPool)); // SLOT_FREE
+    memset(_active, -1, sizeof(_active));
+    _histPos = 0;
+}
+
+/**
+ * @brief Store the current ADC values
+ *
+ * Appends to the history rings and to every capture being recorded.
+ * A few stores per pad, nothing at all while disabled.
+ */
+void HitCapture::sample() {
+    if (!_enabled) {
+        for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+            if (_active[i] >= 0) { capPool[_active[i]].state = SLOT_FREE; }
+            _active[i] = -1;
+        }
+        return;
+    }
+
+    uint16_t val[Pad::PAD_NUM];
+    Pad::readAll(val);
+
+    for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+        capHistory[i][_histPos] = val[i];
+
+        if (_active[i] >= 0) {
+            Capture& c = capPool[_active[i]];
+            c.samples[c.len++] = val[i];
+            if (c.len >= CAP_SAMPLES) {
+                c.state = SLOT_READY;
+                _active[i] = -1;
+            }
+        }
+    }
+
+    if (++_histPos >= CAP_PRE_SAMPLES) { _histPos = 0; }
+}
+
+/**
+ * @brief Start a capture for a pad
+ * @param pad Pad identifier
+ * @param hit_cycles Hit onset (DWT cycles)
+ * @param threshold Hit threshold at the time
+ *
+ * The pre-trigger part is the history ring, oldest first; its last sample
+ * is the one stored by sample() in this scan.
+ */
+void HitCapture::trigger(Pad::PadID pad, uint32_t hit_cycles, uint16_t threshold) {
+    if (!_enabled || pad >= Pad::PAD_NUM || _active[pad] >= 0) { return; }
+
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < CAP_SLOTS; i++) {
+        if (capPool[i].state == SLOT_FREE) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        _dropped++;
+        _seq++; // Gap in the sequence tells the host
+        return;
+    }
+
+    Capture& c = capPool[slot];
+    c.hit_cycles = hit_cycles;
+    c.threshold = threshold;
+    c.pad = pad;
+    c.seq = _seq++;
+    c.state = SLOT_RECORDING;
+
+    uint8_t pos = _histPos; // Oldest history entry
+    for (uint8_t k = 0; k < CAP_PRE_SAMPLES; k++) {
+        c.samples[k] = capHistory[pad][pos];
+        if (++pos >= CAP_PRE_SAMPLES) { pos = 0; }
+    }
+    c.len = CAP_PRE_SAMPLES;
+    _active[pad] = slot;
+}
+
+/**
+ * @brief Send the oldest finished capture if the log ring has room
+ */
+void HitCapture::poll() {
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < CAP_SLOTS; i++) {
+        if (capPool[i].state != SLOT_READY) { continue; }
+        if (slot < 0 || (int8_t)(capPool[i].seq - capPool[slot].seq) < 0) { slot = i; }
+    }
+    if (slot < 0) { return; }
+    if (logger.getLevel() == LOG_LVL_NONE || logger.getFree() < 4 + CAP_PAYLOAD_SIZE) { return; } // Retry later
+
+    const Capture& c = capPool[slot];
+    uint8_t* p = capTxBuf;
+    *p++ = c.pad;
+    *p++ = c.seq;
+    *p++ = (uint8_t)c.hit_cycles;
+    *p++ = (uint8_t)(c.hit_cycles >> 8);
+    *p++ = (uint8_t)(c.hit_cycles >> 16);
+    *p++ = (uint8_t)(c.hit_cycles >> 24);
+    *p++ = (uint8_t)c.threshold;
+    *p++ = (uint8_t)(c.threshold >> 8);
+    *p++ = (uint8_t)CAP_PERIOD_US;
+    *p++ = (uint8_t)(CAP_PERIOD_US >> 8);
+    *p++ = CAP_PRE_SAMPLES;
+    *p++ = (uint8_t)CAP_SAMPLES;
+    *p++ = (uint8_t)(CAP_SAMPLES >> 8);
+    for (uint16_t i = 0; i < CAP_SAMPLES; i += 2) {
+        Trace_Pack12(p, c.samples[i], c.samples[i + 1]);
+        p += 3;
+    }
+
+    if (tracer.writeBlock(TRACE_BLOCK_CAPTURE, capTxBuf, CAP_PAYLOAD_SIZE)) {
+        capPool[slot].state = SLOT_FREE;
+        _sent++;
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file hitrec.cpp
+ * @brief Hit event flight recorder
+ *
+ * This file implements the HitRecorder dump (see hitrec.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "hitrec.h"
+#include "string.h"
+#include "logger.h"
+
+HitRecorder hitRecorder; // Global hit recorder instance
+
+static_assert(sizeof(HitRecorder::Event) == 12, "Event layout is shared with the host decoder");
+
+/**
+ * @brief Construct a new HitRecorder object
+ */
+HitRecorder::HitRecorder() :
+    _total(0),
+    _dumping(false),
+    _headerSent(false),
+    _dumpNext(0),
+    _dumpEnd(0) {
+    memset(_events, 0, sizeof(_events));
+}
+
+/**
+ * @brief Start a dump (ignored if one is running)
+ *
+ * The dump covers the events present now; hits recorded during the dump
+ * are not included.
+ */
+void HitRecorder::requestDump() {
+    if (_dumping) { return; }
+
+    _dumpEnd = _total;
+    _dumpNext = (_total > HITREC_SIZE) ? _total - HITREC_SIZE : 0;
+    _headerSent = false;
+    _dumping = true;
+}
+
+/**
+ * @brief Send pending dump lines as the log ring has room
+ */
+void HitRecorder::poll() {
+    if (!_dumping) { return; }
+    if (logger.getLevel() < LOG_LVL_INFO) { return; } // Muted (wave stream), wait
+
+    if (!_headerSent) {
+        if (logger.getFree() < LOG_LINE_MAX) { return; }
+        LOG_I("#HREC BEGIN n=%lu total=%lu now=%lu", _dumpEnd - _dumpNext, _total, HAL_GetTick());
+        _headerSent = true;
+    }
+
+    while (_dumpNext != _dumpEnd && logger.getFree() >= HITREC_LINE_LEN) {
+        if (_total - _dumpNext <= HITREC_SIZE) { // Skip events overwritten since the dump started
+            _sendEvent(_events[_dumpNext & (HITREC_SIZE - 1)]);
+        }
+        _dumpNext++;
+    }
+
+    if (_dumpNext == _dumpEnd && logger.getFree() >= LOG_LINE_MAX) {
+        LOG_I("#HREC END");
+        _dumping = false;
+    }
+}
+
+/**
+ * @brief Send one event as a hex line
+ * @param ev Event
+ */
+void HitRecorder::_sendEvent(const Event& ev) {
+    static const char hex[] = "0123456789abcdef";
+    char line[HITREC_LINE_LEN + 1];
+    const uint8_t* bytes = (const uint8_t*)&ev;
+
+    memcpy(line, "#HREC ", 6);
+    for (uint8_t i = 0; i < sizeof(Event); i++) {
+        line[6 + i * 2] = hex[bytes[i] >> 4];
+        line[7 + i * 2] = hex[bytes[i] & 0x0F];
+    }
+    line[30] = '\r';
+    line[31] = '\n';
+    line[32] = '\0';
+
+    logger.write(LOG_LVL_INFO, line);
+}
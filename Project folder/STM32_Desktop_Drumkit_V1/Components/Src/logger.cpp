@@ -0,0 +1,180 @@
+/**
+ * @file logger.cpp
+ * @brief Asynchronous debug log on USART1 (TX DMA)
+ *
+ * This file implements the Logger class: line formatting, the single
+ * producer / single consumer ring and the DMA chaining in the TX complete
+ * callback (see logger.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "logger.h"
+#include "health.h"
+#include "string.h"
+#include "stdio.h"
+#include "stdarg.h"
+
+Logger logger; // Global logger instance
+
+/**
+ * @brief Construct a new Logger object
+ */
+Logger::Logger() :
+    _head(0),
+    _tail(0),
+    _dma_len(0),
+    _level(LOG_LVL_INFO),
+    _dropped(0),
+    _written(0),
+    _tx_errors(0) {}
+
+/**
+ * @brief Format and queue one log line
+ * @param level LOG_LVL_ERROR ... LOG_LVL_DEBUG
+ * @param fmt printf format (without line ending)
+ */
+void Logger::print(uint8_t level, const char* fmt, ...) {
+    if (level == LOG_LVL_NONE || level > _level) { return; }
+
+    char line[LOG_LINE_MAX];
+    uint16_t len = 0;
+
+    if (level <= LOG_LVL_WARN) {
+        line[len++] = (level == LOG_LVL_ERROR) ? 'E' : 'W';
+        line[len++] = ':';
+        line[len++] = ' ';
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(&line[len], LOG_LINE_MAX - 2 - len, fmt, args); // Room left for "\r\n"
+    va_end(args);
+    if (n < 0) { return; }
+
+    uint16_t room = LOG_LINE_MAX - 3 - len; // vsnprintf keeps one byte for the terminator
+    len += ((uint16_t)n > room) ? room : (uint16_t)n;
+    line[len++] = '\r';
+    line[len++] = '\n';
+
+    _push(line, len);
+}
+
+/**
+ * @brief Queue a raw string as is
+ * @param level Log level
+ * @param str String (line ending included by the caller)
+ */
+void Logger::write(uint8_t level, const char* str) {
+    if (level == LOG_LVL_NONE || level > _level) { return; }
+    _push(str, strlen(str));
+}
+
+/**
+ * @brief Queue binary bytes as is
+ * @param data Bytes
+ * @param len Length
+ * @return true if queued, false if dropped (ring full)
+ */
+bool Logger::writeRaw(const uint8_t* data, uint16_t len) {
+    return _push((const char*)data, len);
+}
+
+/**
+ * @brief Copy bytes into the ring and start the DMA if it is idle
+ * @param data Bytes
+ * @param len Length
+ * @return true if queued, false if dropped
+ *
+ * A line that does not fit as a whole is dropped (never split).
+ */
+bool Logger::_push(const char* data, uint16_t len) {
+    uint16_t head = _head;
+    uint16_t used = (uint16_t)(head - _tail);
+    if (len == 0) { return true; }
+    if (len > LOG_BUF_SIZE - used) {
+        _dropped++;
+        return false;
+    }
+
+    uint16_t start = head & (LOG_BUF_SIZE - 1);
+    uint16_t first = LOG_BUF_SIZE - start; // Contiguous room up to the wrap
+    if (first > len) { first = len; }
+    memcpy(&_buf[start], data, first);
+    memcpy(&_buf[0], data + first, len - first);
+
+    __DMB(); // Data visible before the index moves
+    _head = head + len;
+    _written += len;
+
+    _kick();
+    return true;
+}
+
+/**
+ * @brief Start the DMA unless a transfer is in flight
+ *
+ * The check and the start run with interrupts masked, otherwise a TX
+ * complete between the two could leave queued data behind.
+ */
+void Logger::_kick() {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (_dma_len == 0) { _startDma(); }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Send the next contiguous chunk of the ring (DMA idle, interrupts masked)
+ */
+void Logger::_startDma() {
+    uint16_t used = (uint16_t)(_head - _tail);
+    if (used == 0) { return; }
+
+    uint16_t start = _tail & (LOG_BUF_SIZE - 1);
+    uint16_t len = LOG_BUF_SIZE - start;
+    if (len > used) { len = used; }
+
+    if (HAL_UART_Transmit_DMA(&huart1, (uint8_t*)&_buf[start], len) == HAL_OK) {
+        _dma_len = len;
+    } // else: UART busy (e.g. a blocking transmit), poll() retries
+}
+
+/**
+ * @brief Restart the DMA after a failed start or a transfer error
+ *
+ * The UART returns to READY without a TX complete callback only on error;
+ * the chunk in flight is sent again.
+ */
+void Logger::poll() {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (_dma_len != 0 && huart1.gState == HAL_UART_STATE_READY) {
+        _tx_errors++;
+        health.count(HEALTH_UART_TX_TIMEOUT);
+        _dma_len = 0;
+    }
+    if (_dma_len == 0) { _startDma(); }
+    __set_PRIMASK(primask);
+}
+
+extern "C" {
+
+/**
+ * @brief UART TX complete callback
+ * @param huart UART handle
+ *
+ * Releases the sent chunk and chains the next one.
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart->Instance == USART1) {
+        logger._tail = logger._tail + logger._dma_len;
+        logger._dma_len = 0;
+        logger._startDma();
+    }
+}
+
+} // extern "C"
@@ -12,10 +12,34 @@
  */
 
 #include "midi.h"
-// #include "stdio.h" // For debugging
+#include "profiler.h"
+#include "logger.h"
+#include "health.h"
+#include "string.h"
+#include "stdio.h"
 
-// Definition of static [pad - midi-note] map
-constexpr uint8_t Midi::_PAD_MIDI_NOTE_MAP[MIDI_CHANNELS_NUM];
+/**
+ * @brief Built-in note map presets (copied to RAM at construction)
+ * 
+ * Pad order: OpenHiHat, CloseHiHat, Crash, Ride, SideStick, Kick, Snare, MidTom, LowTom, HighTom
+ */
+const Midi::NoteMap Midi::_NOTE_MAP_PRESETS[MIDI_NOTE_MAP_PRESET_NUM] = {
+    // General MIDI percussion key map
+    { "GM",
+      { OPEN_HI_HAT, CLOSED_HI_HAT, CRASH_CYMBAL_1, RIDE_CYMBAL_1, SIDESTICK,
+        ACOUSTIC_BASS_DRUM, ACOUSTIC_SNARE, HIGH_MID_TOM, LOW_TOM, HIGH_TOM },
+      { 10, 10, 10, 10, 10, 10, 10, 10, 10, 10 } },
+
+    // Drum VST layout (Bass Drum 1 kick, floor tom on 43, listens on channel 1)
+    { "VST",
+      { 46, 42, 49, 51, 37, 36, 38, 47, 43, 48 },
+      { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 } },
+
+    // E-drum module layout (hi-hat on its own channel for pedal/CC handling)
+    { "Module",
+      { 46, 42, 49, 51, 37, 36, 38, 45, 43, 48 },
+      { 11, 11, 10, 10, 10, 10, 10, 10, 10, 10 } }
+};
 
 static Midi* _midi_inst = nullptr; // Global instance pointer for interrupt handling
 
@@ -27,13 +51,21 @@ static Midi* _midi_inst = nullptr; // Global instance pointer for interrupt hand
  * - Connection status false
  * - Channel states initialized with default values
  */
-Midi::Midi() : _ack(true), _connected(false) {
+Midi::Midi() : _ack(true), _connected(false), _burst_len(0), _burst_window_us(MIDI_BURST_WINDOW_US),
+    _hold_head(0), _hold_len(0), _stale_cutoff_ms(MIDI_STALE_CUTOFF_MS), _sysex_len(0), _sysex_pos(0) {
     _midi_inst = this; // Set global instance for interrupt callbacks
+    resetBurstStats();
+    resetTxStats();
+    for (uint8_t i = 0; i < MIDI_NOTE_MAP_PRESET_NUM; i++) {
+        resetNoteMap(static_cast<NoteMapPreset>(i));
+    }
+    _activeMap = &_noteMaps[MAP_GM];
+
     for (uint8_t i = 0; i < MIDI_CHANNELS_NUM; i++) {
         _channel_states[i].noteOn_sent = false;
         _channel_states[i].noteOn_timestamp = 0;
-        _channel_states[i].note = _PAD_MIDI_NOTE_MAP[i];
-        _channel_states[i].channel = MIDI_CHANNEL_ID;
+        _channel_states[i].note = _activeMap->note[i];
+        _channel_states[i].channel = _activeMap->channel[i];
     }
 }
 
@@ -41,18 +73,20 @@ Midi::Midi() : _ack(true), _connected(false) {
  * @brief Send a MIDI Note On message with error handling
  * @param padID Pad identifier
  * @param velocity MIDI velocity (0-127)
- * @param channel MIDI channel (1-16)
  * 
- * Constructs and sends a 3-byte MIDI Note On message with timeout and error handling
+ * Constructs and sends a 3-byte MIDI Note On message with timeout and error handling.
+ * Note and channel come from the active note map.
  * @return true if sent successful, false if failed
  */
-bool Midi::sendNoteOn(Pad::PadID padID, uint8_t velocity, uint8_t channel) {
+bool Midi::sendNoteOn(Pad::PadID padID, uint8_t velocity) {
     // sprintf(dbg_buf, "sendNoteOn called for pad %d (current noteOn_sent=%d)\r\n", 
     //        padID, _channel_states[padID].noteOn_sent);
     // DBG(dbg_buf);
-    if (!_connected) return false;
+    if (!_connected || padID >= MIDI_CHANNELS_NUM) return false;
     
-    uint8_t note = _PAD_MIDI_NOTE_MAP[padID];
+    const NoteMap* map = _activeMap;
+    uint8_t note = map->note[padID];
+    uint8_t channel = map->channel[padID];
     
     uint8_t midi_msg[3];
     midi_msg[0] = 0x90 | ((channel - 1) & 0x0F); // Note On status + channel
@@ -66,6 +100,8 @@ bool Midi::sendNoteOn(Pad::PadID padID, uint8_t velocity, uint8_t channel) {
         }
     }
 
+    _tx_stats.note_on++;
+
     // Update channel state
     _channel_states[padID].noteOn_sent = true;
     _channel_states[padID].noteOn_timestamp = HAL_GetTick();
@@ -93,9 +129,11 @@ void Midi::sendNoteOff(uint8_t note, uint8_t channel) {
     midi_msg[1] = note & 0x7F;                   // Note number
     midi_msg[2] = 0x00;                         // Zero velocity
     
-    for (uint8_t i = 0; i < 3; i++) {
-        _sendByte(midi_msg[i]);
+    bool ok = true;
+    for (uint8_t i = 0; i < 3 && ok; i++) {
+        ok = _sendByte(midi_msg[i]);
     }
+    if (ok) { _tx_stats.note_off++; }
 }
 
 /**
@@ -104,23 +142,35 @@ void Midi::sendNoteOff(uint8_t note, uint8_t channel) {
  * 
  * Sends Note Off using the pad's stored note and channel values
  * Only sends if a Note On was previously sent for this pad
+ * 
+ * If the message breaks off the Note Off stays pending and is sent again,
+ * in full, by autoNoteOff() once the link is back (no hung note).
  */
 void Midi::sendNoteOff(Pad::PadID padID) {
     // sprintf(dbg_buf, "Entering Midi::sendNoteOff(Pad::PadID padID) for pad %d\r\n", padID);
     // DBG(dbg_buf);
 
     if (padID >= MIDI_CHANNELS_NUM || !_channel_states[padID].noteOn_sent)  { return; }
+    if (!_connected) { return; } // Stays pending until the link is back
     
     uint8_t midi_msg[3];
     midi_msg[0] = 0x80 | ((_channel_states[padID].channel - 1) & 0x0F); // Note Off status + channel
     midi_msg[1] = _channel_states[padID].note & 0x7F;                   // Note number
     midi_msg[2] = 0x00;                                                 // Zero velocity
     
-    for (uint8_t i = 0; i < 3; i++) {
+    bool ok = true;
+    uint32_t bytes_before = _tx_stats.bytes;
+    for (uint8_t i = 0; i < 3 && ok; i++) {
         // sprintf(dbg_buf, "Sending MIDI byte %d: 0x%02X\r\n", i, midi_msg[i]);
         // DBG(dbg_buf);
-        _sendByte(midi_msg[i]);
+        ok = _sendByte(midi_msg[i]);
+    }
+    if (!ok) {
+        if (_tx_stats.bytes != bytes_before) { _hold_stats.aborted++; } // Partial message on the wire
+        _connected = false;
+        return;
     }
+    _tx_stats.note_off++;
 
     // sprintf(dbg_buf, "Resetting noteOn_sent for pad %d\r\n", padID);
     // DBG(dbg_buf);
@@ -139,6 +189,48 @@ void Midi::sendNoteOff(Pad::PadID padID) {
     // DBG(dbg_buf);
 }
 
+/**
+ * @brief Queue a System Exclusive message
+ * @param data Payload without the 0xF0/0xF7 framing (7-bit bytes)
+ * @param len Payload length (up to MIDI_SYSEX_TX_SIZE)
+ * @return true if queued, false if the link is down, another frame is pending or it is too long
+ */
+bool Midi::queueSysEx(const uint8_t* data, uint16_t len) {
+    if (!_connected || _sysex_len || len > MIDI_SYSEX_TX_SIZE) { return false; }
+
+    _sysex[0] = 0xF0;
+    for (uint16_t i = 0; i < len; i++) {
+        _sysex[1 + i] = data[i] & 0x7F;
+    }
+    _sysex[1 + len] = 0xF7;
+    _sysex_pos = 0;
+    _sysex_len = len + 2;
+    return true;
+}
+
+/**
+ * @brief Send the next part of the pending SysEx frame
+ * @return true if the frame is complete (or dropped), false if bytes are left
+ * 
+ * A frame broken off by a link failure is dropped; the next message starts
+ * with a status byte, which ends the incomplete frame at the receiver.
+ */
+bool Midi::_sendSysExSlice() {
+    for (uint8_t n = 0; n < MIDI_SYSEX_SLICE_BYTES && _sysex_pos < _sysex_len; n++) {
+        if (!_connected || !_sendByte(_sysex[_sysex_pos])) {
+            _connected = false;
+            _sysex_len = 0;
+            return true;
+        }
+        _sysex_pos++;
+    }
+
+    if (_sysex_pos < _sysex_len) { return false; }
+    _tx_stats.sysex++;
+    _sysex_len = 0;
+    return true;
+}
+
 /**
  * @brief Handle automatic note off events
  * 
@@ -146,6 +238,8 @@ void Midi::sendNoteOff(Pad::PadID padID) {
  * the NOTEOFF_DELAY_MS duration since their Note On
  */
 void Midi::autoNoteOff() {
+    if (_sysex_len) { return; } // After the pending SysEx frame
+
     uint32_t now = HAL_GetTick();
 
     for (uint8_t id = 0; id < MIDI_CHANNELS_NUM; id++) {
@@ -169,6 +263,294 @@ void Midi::autoNoteOff() {
     }
 }
 
+/**
+ * @brief Queue a Note On into the coalescing stage
+ * @param padID Pad identifier
+ * @param velocity MIDI velocity (0-127)
+ * @param hit_cycles Hit onset timestamp (DWT cycles)
+ * @return QueueResult What happened to the note (for the hit recorder)
+ * 
+ * The queue holds one slot per pad. If it is somehow full the pending
+ * burst is sent first so no hit is lost. While a SysEx frame is open the
+ * burst cannot go out, then the oldest event moves to the hold buffer and
+ * is replayed ahead of the rest.
+ */
+Midi::QueueResult Midi::queueNoteOn(Pad::PadID padID, uint8_t velocity, uint32_t hit_cycles) {
+    if (padID >= MIDI_CHANNELS_NUM) { return REJECTED; }
+
+    QueueResult result = _connected ? QUEUED : QUEUED_HELD;
+    if (_burst_len >= MIDI_CHANNELS_NUM) {
+        flushBurst(0);
+        result = QUEUED_FLUSHED;
+    }
+    if (_burst_len >= MIDI_CHANNELS_NUM) { // Not flushed (SysEx frame pending)
+        _holdEvent(_burst[0]);
+        memmove(&_burst[0], &_burst[1], (MIDI_CHANNELS_NUM - 1) * sizeof(BurstEvent));
+        _burst_len--;
+    }
+
+    BurstEvent& ev = _burst[_burst_len++];
+    ev.padID = padID;
+    ev.velocity = velocity;
+    ev.hit_cycles = hit_cycles;
+    ev.queued_cycles = DWT_GetCycles();
+    ev.hit_tick = HAL_GetTick() - DWT_CyclesToUs(ev.queued_cycles - hit_cycles) / 1000;
+
+    if (_burst_len > _tx_stats.queue_depth_max) { _tx_stats.queue_depth_max = _burst_len; }
+    return result;
+}
+
+/**
+ * @brief Check if flushBurst() or autoNoteOff() has something to send
+ * @param active_pads Number of pads still measuring
+ * @return true if a burst is due, held notes can be replayed or a Note Off is due
+ * 
+ * Mirrors the conditions of flushBurst() and autoNoteOff() without sending,
+ * so an open coalescing window or a pending Note Off does not keep the
+ * MIDI task busy.
+ */
+bool Midi::hasWork(uint8_t active_pads) {
+    if (_sysex_len) { return true; }
+    if (_hold_len && _connected) { return true; }
+
+    if (_burst_len) {
+        if (active_pads == 0) { return true; }
+        if ((DWT_GetCycles() - _burst[0].queued_cycles) >= DWT_UsToCycles(_burst_window_us)) { return true; }
+    }
+
+    if (!_connected) { return false; } // Note Offs wait for the link (autoNoteOff() only runs while connected)
+
+    uint32_t now = HAL_GetTick();
+    for (uint8_t id = 0; id < MIDI_CHANNELS_NUM; id++) {
+        if (_channel_states[id].noteOn_sent && (now - _channel_states[id].noteOn_timestamp) > NOTEOFF_DELAY_MS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Send queued Note On messages as a single running-status burst
+ * @param active_pads Number of pads whose measuring window is still open
+ * @return uint8_t Number of notes of this burst sent (0 if nothing was flushed)
+ * 
+ * The burst stays open for the coalescing window after the first event was
+ * queued, but only while other pads are still measuring; with no other pad
+ * active the window adapts to 0 and the burst goes out at once.
+ * 
+ * Events are sorted by hit onset and sent back to back. The status byte is
+ * only sent when it changes (running status), so N notes on one channel
+ * cost 1 + 2N bytes instead of 3N.
+ * 
+ * While the link is down, notes are moved to the hold buffer instead. Held
+ * notes are replayed (before any new burst) once the link is back.
+ * 
+ * A pending SysEx frame is sent first, one slice per call; nothing else is
+ * sent until it is complete.
+ */
+uint8_t Midi::flushBurst(uint8_t active_pads) {
+    if (_sysex_len && !_sendSysExSlice()) { return 0; } // Notes would end the frame
+
+    if (_hold_len && _connected) {
+        _replayHeld();
+    }
+
+    if (_burst_len == 0) { return 0; }
+
+    uint32_t now = DWT_GetCycles();
+    uint32_t oldest = _burst[0].queued_cycles; // Queue is filled in arrival order
+    if (active_pads > 0 && (now - oldest) < DWT_UsToCycles(_burst_window_us)) {
+        return 0; // Window still open, more hits may join
+    }
+
+    // Order by hit onset (insertion sort, at most PAD_NUM entries, wrap-safe compare)
+    for (uint8_t i = 1; i < _burst_len; i++) {
+        BurstEvent ev = _burst[i];
+        uint8_t j = i;
+        while (j > 0 && (int32_t)(_burst[j - 1].hit_cycles - ev.hit_cycles) > 0) {
+            _burst[j] = _burst[j - 1];
+            j--;
+        }
+        _burst[j] = ev;
+    }
+
+    uint8_t sent = (_hold_len == 0) ? _sendNoteOns(_burst, _burst_len) : 0; // Keep order behind held notes
+    for (uint8_t i = 0; i < sent; i++) {
+        uint32_t latency = DWT_CyclesToUs(now - _burst[i].queued_cycles);
+        _burst_stats.latency_sum_us += latency;
+        if (latency > _burst_stats.latency_max_us) { _burst_stats.latency_max_us = latency; }
+    }
+    for (uint8_t i = sent; i < _burst_len; i++) {
+        _holdEvent(_burst[i]);
+    }
+
+    _burst_stats.bursts++;
+    _burst_stats.notes += sent;
+    _burst_stats.size_hist[_burst_len - 1]++;
+    if (_burst_len > _burst_stats.max_size) { _burst_stats.max_size = _burst_len; }
+
+    _burst_len = 0;
+    return sent;
+}
+
+/**
+ * @brief Send Note On messages back to back with running status
+ * @param events Events in send order
+ * @param count Number of events
+ * @return uint8_t Number of complete messages sent (stops at the first failure)
+ * 
+ * Every call starts with a full status byte. If a message breaks off
+ * (ACK timeout after its first bytes) its first bytes are already on the
+ * wire and cannot be taken back, so a half-sent message is possible. It
+ * is never completed: the next send always begins with a status byte,
+ * which per MIDI spec makes the receiver discard the incomplete message.
+ * The broken-off event itself is not lost, the caller holds it (flushBurst()
+ * moves it to the hold buffer, _replayHeld() keeps it at the head), so it
+ * is replayed in full on reconnect.
+ */
+uint8_t Midi::_sendNoteOns(const BurstEvent* events, uint8_t count) {
+    PROF_SCOPE(MIDI_SEND);
+
+    uint8_t sent = 0;
+    uint8_t running_status = 0; // 0 is never a valid status byte, so the first note carries it
+    const NoteMap* map = _activeMap; // One map for the whole burst, even if switched meanwhile
+
+    for (uint8_t i = 0; i < count && _connected; i++) {
+        const BurstEvent& ev = events[i];
+        uint8_t note = map->note[ev.padID];
+        uint8_t channel = map->channel[ev.padID];
+        uint8_t status = 0x90 | ((channel - 1) & 0x0F);
+
+        bool ok = true;
+        uint32_t bytes_before = _tx_stats.bytes;
+        if (status != running_status) {
+            ok = _sendByte(status);
+            running_status = status;
+        }
+        ok = ok && _sendByte(note & 0x7F) && _sendByte(ev.velocity & 0x7F);
+        if (!ok) {
+            if (_tx_stats.bytes != bytes_before) { _hold_stats.aborted++; } // Partial message on the wire
+            _connected = false;
+            break;
+        }
+
+        _channel_states[ev.padID].noteOn_sent = true;
+        _channel_states[ev.padID].noteOn_timestamp = HAL_GetTick();
+        _channel_states[ev.padID].note = note;
+        _channel_states[ev.padID].channel = channel;
+        _tx_stats.note_on++;
+        sent++;
+    }
+    return sent;
+}
+
+/**
+ * @brief Put an unsent note into the hold buffer
+ * @param ev Event to hold
+ * 
+ * The buffer is bounded; when full the oldest held note is dropped, it
+ * would be the first to go stale anyway.
+ */
+void Midi::_holdEvent(const BurstEvent& ev) {
+    if (_hold_len >= MIDI_HOLD_BUF_SIZE) {
+        _hold_head = (_hold_head + 1) % MIDI_HOLD_BUF_SIZE;
+        _hold_len--;
+        _hold_stats.overflow++;
+    }
+    _hold[(_hold_head + _hold_len) % MIDI_HOLD_BUF_SIZE] = ev;
+    _hold_len++;
+    _hold_stats.held++;
+}
+
+/**
+ * @brief Replay held notes after the link came back
+ * 
+ * Notes older than the stale cutoff (measured from the hit) are dropped
+ * rather than played out of time. Replay stops at the first failure and
+ * keeps the rest for the next attempt.
+ */
+void Midi::_replayHeld() {
+    uint32_t now_tick = HAL_GetTick();
+
+    while (_hold_len && _connected) {
+        BurstEvent& ev = _hold[_hold_head];
+        if (now_tick - ev.hit_tick > _stale_cutoff_ms) {
+            _hold_stats.stale++;
+        } else if (_sendNoteOns(&ev, 1) == 1) {
+            _hold_stats.replayed++;
+        } else {
+            break; // Link went down again
+        }
+        _hold_head = (_hold_head + 1) % MIDI_HOLD_BUF_SIZE;
+        _hold_len--;
+    }
+}
+
+/**
+ * @brief Set the stale cutoff for held notes
+ * @param cutoff_ms Max age of a held note in milliseconds (0 drops everything held)
+ */
+void Midi::setStaleCutoff(uint16_t cutoff_ms) {
+    _stale_cutoff_ms = cutoff_ms;
+}
+
+/**
+ * @brief Set the coalescing window
+ * @param window_us Window in microseconds (0 disables coalescing)
+ */
+void Midi::setBurstWindow(uint16_t window_us) {
+    _burst_window_us = (window_us > MIDI_BURST_WINDOW_MAX_US) ? MIDI_BURST_WINDOW_MAX_US : window_us;
+}
+
+/**
+ * @brief Reset burst statistics
+ */
+void Midi::resetBurstStats() {
+    memset(&_burst_stats, 0, sizeof(_burst_stats));
+    memset(&_hold_stats, 0, sizeof(_hold_stats));
+}
+
+/**
+ * @brief Switch the active note map
+ * @param preset Preset to activate
+ * 
+ * Only the table pointer is swapped (a single word write), so a hit being
+ * sent in the meantime sees either the old or the new table, never a mix.
+ */
+void Midi::selectNoteMap(NoteMapPreset preset) {
+    if (preset >= MIDI_NOTE_MAP_PRESET_NUM) { return; }
+    _activeMap = &_noteMaps[preset];
+}
+
+/**
+ * @brief Restore a preset table to its built-in values
+ * @param preset Preset to restore
+ */
+void Midi::resetNoteMap(NoteMapPreset preset) {
+    if (preset >= MIDI_NOTE_MAP_PRESET_NUM) { return; }
+    memcpy(&_noteMaps[preset], &_NOTE_MAP_PRESETS[preset], sizeof(NoteMap));
+}
+
+/**
+ * @brief Override the note of a pad in the active map
+ * @param padID Pad identifier
+ * @param note MIDI note number (0-127)
+ */
+void Midi::setPadNote(Pad::PadID padID, uint8_t note) {
+    if (padID >= MIDI_CHANNELS_NUM) { return; }
+    _activeMap->note[padID] = note & 0x7F;
+}
+
+/**
+ * @brief Override the channel of a pad in the active map
+ * @param padID Pad identifier
+ * @param channel MIDI channel (1-16)
+ */
+void Midi::setPadChannel(Pad::PadID padID, uint8_t channel) {
+    if (padID >= MIDI_CHANNELS_NUM || channel < 1 || channel > 16) { return; }
+    _activeMap->channel[padID] = channel;
+}
+
 /**
  * @brief Send a single MIDI byte with flow control and timeout
  * @param byte MIDI byte to send
@@ -179,17 +561,104 @@ void Midi::autoNoteOff() {
  */
 bool Midi::_sendByte(uint8_t byte) {
     uint32_t start = HAL_GetTick();
+    uint32_t wait_start = DWT_GetCycles();
     while (!_ack) {
         if (HAL_GetTick() - start > MIDI_SEND_TIMEOUT_MS) {
+            _tx_stats.timeouts++;
+            health.count(HEALTH_MIDI_ACK_TIMEOUT);
             _connected = false;
+            _ack = true; // That ACK is lost, the next byte after reconnect must not wait for it
             return false;
         }
     }
+
+    uint32_t wait_us = DWT_CyclesToUs(DWT_GetCycles() - wait_start);
+    _tx_stats.ack_wait_sum_us += wait_us;
+    if (wait_us > _tx_stats.ack_wait_max_us) { _tx_stats.ack_wait_max_us = wait_us; }
+
     _ack = false;
-    HAL_UART_Transmit(&huart2, &byte, 1, 10);
+    HAL_StatusTypeDef status = HAL_UART_Transmit(&huart2, &byte, 1, 10);
+    if (status == HAL_BUSY) {
+        // Handle was busy and nothing was written, so one repeat cannot duplicate the byte
+        _tx_stats.retries++;
+        status = HAL_UART_Transmit(&huart2, &byte, 1, 10);
+    }
+    if (status != HAL_OK) {
+        _tx_stats.tx_errors++;
+        health.count(HEALTH_UART_TX_TIMEOUT);
+        if (status == HAL_BUSY) { _ack = true; } // Nothing sent, so no ACK will come
+        return false;
+    }
+
+    _tx_stats.bytes++;
+    _countUtilization();
     return true;
 }
 
+/**
+ * @brief Account a byte in the utilization meter
+ * 
+ * Bytes are summed into MIDI_UTIL_BUCKETS buckets of MIDI_UTIL_BUCKET_MS.
+ * A bucket is cleared when it is reused for a new time slot.
+ */
+void Midi::_countUtilization() {
+    uint32_t slot = HAL_GetTick() / MIDI_UTIL_BUCKET_MS;
+    uint8_t idx = slot % MIDI_UTIL_BUCKETS;
+    if (_util_slot[idx] != slot) {
+        _util_slot[idx] = slot;
+        _util_bytes[idx] = 0;
+    }
+    _util_bytes[idx]++;
+
+    uint8_t util = getLinkUtilization();
+    if (util > _util_peak) { _util_peak = util; }
+}
+
+/**
+ * @brief Get link utilization over the last second
+ * @return uint8_t Percent of the 31250 baud budget (0-100)
+ */
+uint8_t Midi::getLinkUtilization() {
+    uint32_t now_slot = HAL_GetTick() / MIDI_UTIL_BUCKET_MS;
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < MIDI_UTIL_BUCKETS; i++) {
+        if (now_slot - _util_slot[i] < MIDI_UTIL_BUCKETS) { bytes += _util_bytes[i]; }
+    }
+
+    uint32_t budget = (uint32_t)MIDI_LINK_BYTES_PER_SEC * MIDI_UTIL_BUCKETS * MIDI_UTIL_BUCKET_MS / 1000;
+    uint32_t pct = bytes * 100 / budget;
+    return (pct > 100) ? 100 : (uint8_t)pct;
+}
+
+/**
+ * @brief Reset transport statistics and utilization meter
+ */
+void Midi::resetTxStats() {
+    memset(&_tx_stats, 0, sizeof(_tx_stats));
+    memset(_util_bytes, 0, sizeof(_util_bytes));
+    memset(_util_slot, 0, sizeof(_util_slot));
+    _util_peak = 0;
+}
+
+/**
+ * @brief Print transport and burst statistics over the debug UART
+ */
+void Midi::dumpStats() {
+    uint32_t avg_wait = _tx_stats.bytes ? (_tx_stats.ack_wait_sum_us / _tx_stats.bytes) : 0;
+    uint32_t avg_lat = _burst_stats.notes ? (_burst_stats.latency_sum_us / _burst_stats.notes) : 0;
+
+    LOG_I("MIDI TX: %lu B, on %lu, off %lu, sysex %lu",
+          _tx_stats.bytes, _tx_stats.note_on, _tx_stats.note_off, _tx_stats.sysex);
+    LOG_I("MIDI link: %u%% (peak %u%%), retries %lu, timeouts %lu, errors %lu",
+          getLinkUtilization(), _util_peak, _tx_stats.retries, _tx_stats.timeouts, _tx_stats.tx_errors);
+    LOG_I("MIDI ACK wait: avg %lu us, max %lu us, queue max %u",
+          avg_wait, _tx_stats.ack_wait_max_us, _tx_stats.queue_depth_max);
+    LOG_I("MIDI bursts: %lu, max size %u, latency avg %lu us, max %lu us",
+          _burst_stats.bursts, _burst_stats.max_size, avg_lat, _burst_stats.latency_max_us);
+    LOG_I("MIDI hold: %lu held, %lu replayed, %lu stale, %lu overflow, %lu aborted",
+          _hold_stats.held, _hold_stats.replayed, _hold_stats.stale, _hold_stats.overflow, _hold_stats.aborted);
+}
+
 /**
  * @brief Check if MIDI interface is connected
  * @return true if connected, false otherwise
@@ -0,0 +1,301 @@
+/**
+ * @file midi_in.cpp
+ * @brief MIDI input (USART2 RX) and SysEx configuration protocol
+ *
+ * This file implements the MidiIn class: circular DMA reception, in-place
+ * parsing of the DMA ring, host clock/transport tracking and the SysEx
+ * parameter dump/bulk write protocol (see midi_in.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "midi_in.h"
+#include "health.h"
+
+MidiIn midiIn; // Global MIDI input instance
+
+static MidiIn* _midi_in_inst = nullptr; // Global instance pointer for parser/interrupt callbacks
+
+/**
+ * @brief Construct a new MidiIn object
+ */
+MidiIn::MidiIn() :
+    _rx_tail(0),
+    _rx_bytes(0),
+    _rx_errors(0),
+    _parser(_sysex_buf, MIDI_IN_SYSEX_BUF_SIZE),
+    _reply_len(0),
+    _transport_running(false),
+    _clock_count(0),
+    _last_clock_cycles(0),
+    _clock_interval_us(0) {
+    _midi_in_inst = this;
+    _parser.attachMessage(_onMessage);
+    _parser.attachRealtime(_onRealtime);
+    _parser.attachSysEx(_onSysEx);
+}
+
+/**
+ * @brief Start circular DMA reception on USART2
+ */
+void MidiIn::begin() {
+    _startRx();
+}
+
+/**
+ * @brief (Re)start circular DMA reception from the start of the ring
+ */
+void MidiIn::_startRx() {
+    _rx_tail = 0;
+    _parser.reset();
+    HAL_UART_Receive_DMA(&huart2, _rx_buf, MIDI_IN_RX_BUF_SIZE);
+}
+
+/**
+ * @brief Parse received bytes (call in main loop)
+ * @param idle true if no hit is in flight, allows pending SysEx replies to be sent
+ *
+ * The DMA write position is derived from the stream's remaining transfer
+ * count. Bytes between the last parsed position and the write position are
+ * fed to the parser directly from the ring (split in two at the wrap).
+ */
+void MidiIn::poll(bool idle) {
+    // An overrun/framing error stops the HAL DMA reception, restart it
+    if (huart2.RxState == HAL_UART_STATE_READY) {
+        _startRx();
+    }
+
+    uint16_t head = MIDI_IN_RX_BUF_SIZE - __HAL_DMA_GET_COUNTER(huart2.hdmarx);
+    if (head >= MIDI_IN_RX_BUF_SIZE) { head = 0; } // Counter reload at wrap
+
+    uint16_t budget = MIDI_IN_POLL_BUDGET;
+    while (_rx_tail != head && budget > 0) {
+        uint16_t end = (head > _rx_tail) ? head : MIDI_IN_RX_BUF_SIZE; // Contiguous segment
+        uint16_t len = end - _rx_tail;
+        if (len > budget) { len = budget; }
+
+        _parser.feed(&_rx_buf[_rx_tail], len);
+        _rx_bytes += len;
+        budget -= len;
+        _rx_tail = (_rx_tail + len) % MIDI_IN_RX_BUF_SIZE;
+    }
+
+    if (_reply_len && idle && !midi.isSysExPending()) {
+        midi.queueSysEx(_reply, _reply_len); // Sent by the MIDI task a few bytes per slice
+        _reply_len = 0; // Dropped if the interface went away, host can ask again
+    }
+}
+
+/**
+ * @brief Get host tempo derived from MIDI clock
+ * @return uint16_t Tempo in 0.1 BPM (0 if no clock received)
+ *
+ * 24 clocks per quarter note: BPM = 60e6 / (24 * interval_us)
+ */
+uint16_t MidiIn::getTempoBPMx10() {
+    if (_clock_interval_us == 0) { return 0; }
+    return (uint16_t)(25000000UL / _clock_interval_us);
+}
+
+/**
+ * @brief Parser callback for channel / system common messages
+ *
+ * Not used by the drumkit yet, messages are only counted by the parser.
+ */
+void MidiIn::_onMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+    (void)status;
+    (void)data1;
+    (void)data2;
+}
+
+/**
+ * @brief Parser callback for realtime bytes (host transport and clock)
+ * @param byte Realtime byte (0xF8-0xFF)
+ *
+ * Clock interval is measured with the DWT counter when the byte is parsed,
+ * so it carries the poll latency as jitter; the moving average hides most of it.
+ */
+void MidiIn::_onRealtime(uint8_t byte) {
+    MidiIn* self = _midi_in_inst;
+    if (!self) { return; }
+
+    switch (byte) {
+        case 0xF8: { // Timing Clock
+            uint32_t now = DWT_GetCycles();
+            if (self->_clock_count > 0) {
+                uint32_t interval = DWT_CyclesToUs(now - self->_last_clock_cycles);
+                self->_clock_interval_us = (self->_clock_interval_us == 0) ? interval
+                    : (self->_clock_interval_us * 7 + interval) / 8;
+            }
+            self->_last_clock_cycles = now;
+            self->_clock_count++;
+            break;
+        }
+        case 0xFA: // Start
+            self->_clock_count = 0;
+            self->_transport_running = true;
+            break;
+        case 0xFB: // Continue
+            self->_transport_running = true;
+            break;
+        case 0xFC: // Stop
+            self->_transport_running = false;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Parser callback for complete SysEx frames
+ */
+void MidiIn::_onSysEx(const uint8_t* data, uint16_t len) {
+    if (_midi_in_inst) { _midi_in_inst->_handleSysEx(data, len); }
+}
+
+/**
+ * @brief Handle a SysEx frame addressed to this device
+ * @param data Payload between F0 and F7
+ * @param len Payload length
+ *
+ * Replies (dump, ACK, NAK) are ignored without an answer: they may be our
+ * own replies coming back through a loopback, a NAK to them would bounce
+ * back and forth forever. Only unknown commands get a NAK.
+ */
+void MidiIn::_handleSysEx(const uint8_t* data, uint16_t len) {
+    if (len < SYSEX_HEADER_LEN) { return; }
+    if (data[0] != SYSEX_MANUFACTURER_ID || data[1] != SYSEX_DEVICE_ID) { return; } // Not for us
+
+    uint8_t cmd = data[2];
+    const uint8_t* body = &data[SYSEX_HEADER_LEN];
+    uint16_t body_len = len - SYSEX_HEADER_LEN;
+
+    switch (cmd) {
+        case CMD_DUMP_REQUEST:
+            _buildDump();
+            break;
+
+        case CMD_BULK_WRITE: {
+            if (body_len != SYSEX_CONFIG_LEN) {
+                _replyNak(cmd, ERR_LENGTH);
+                break;
+            }
+            uint8_t err = _applyConfig(body);
+            err ? _replyNak(cmd, err) : _replyAck(cmd);
+            break;
+        }
+
+        case CMD_DUMP:
+        case CMD_ACK:
+        case CMD_NAK:
+            break; // Replies are never answered
+
+        default:
+            _replyNak(cmd, ERR_UNKNOWN_CMD);
+            break;
+    }
+}
+
+/**
+ * @brief Build a dump of all pad parameters into the reply buffer
+ */
+void MidiIn::_buildDump() {
+    uint8_t* p = _reply;
+    *p++ = SYSEX_MANUFACTURER_ID;
+    *p++ = SYSEX_DEVICE_ID;
+    *p++ = CMD_DUMP;
+    *p++ = (uint8_t)midi.getNoteMapPreset();
+
+    for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+        Pad::PadID id = static_cast<Pad::PadID>(i);
+        uint16_t thr = pads[i]->getHitThreshold();
+        uint16_t lim = pads[i]->getUpperLimit();
+        *p++ = (thr >> 7) & 0x1F;
+        *p++ = thr & 0x7F;
+        *p++ = (lim >> 7) & 0x1F;
+        *p++ = lim & 0x7F;
+        *p++ = (uint8_t)pads[i]->getForceCurve();
+        *p++ = midi.getPadNote(id);
+        *p++ = midi.getPadChannel(id) - 1;
+    }
+
+    _reply_len = p - _reply;
+}
+
+/**
+ * @brief Validate and apply a config block
+ * @param block Config block (SYSEX_CONFIG_LEN bytes)
+ * @return uint8_t 0 on success, SysExError otherwise
+ *
+ * The whole block is validated first, so a bad block changes nothing.
+ */
+uint8_t MidiIn::_applyConfig(const uint8_t* block) {
+    if (block[0] >= MIDI_NOTE_MAP_PRESET_NUM) { return ERR_RANGE; }
+
+    for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+        const uint8_t* b = &block[1 + i * SYSEX_PAD_BLOCK_LEN];
+        uint16_t thr = ((uint16_t)b[0] << 7) | b[1];
+        uint16_t lim = ((uint16_t)b[2] << 7) | b[3];
+        if (thr >= lim || lim > 4095) { return ERR_RANGE; }
+        if (b[4] > Pad::CURVE_EXP || b[6] > 15) { return ERR_RANGE; }
+    }
+
+    midi.selectNoteMap(static_cast<Midi::NoteMapPreset>(block[0]));
+    for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+        const uint8_t* b = &block[1 + i * SYSEX_PAD_BLOCK_LEN];
+        Pad::PadID id = static_cast<Pad::PadID>(i);
+        pads[i]->setHitThreshold(((uint16_t)b[0] << 7) | b[1]);
+        pads[i]->setUpperLimit(((uint16_t)b[2] << 7) | b[3]);
+        pads[i]->setForceCurve(static_cast<Pad::ForceMappingCurve>(b[4]));
+        midi.setPadNote(id, b[5]);
+        midi.setPadChannel(id, b[6] + 1);
+    }
+    return 0;
+}
+
+/**
+ * @brief Queue an ACK reply
+ * @param cmd Acknowledged command
+ */
+void MidiIn::_replyAck(uint8_t cmd) {
+    _reply[0] = SYSEX_MANUFACTURER_ID;
+    _reply[1] = SYSEX_DEVICE_ID;
+    _reply[2] = CMD_ACK;
+    _reply[3] = cmd & 0x7F;
+    _reply_len = 4;
+}
+
+/**
+ * @brief Queue a NAK reply
+ * @param cmd Rejected command
+ * @param error SysExError code
+ */
+void MidiIn::_replyNak(uint8_t cmd, uint8_t error) {
+    _reply[0] = SYSEX_MANUFACTURER_ID;
+    _reply[1] = SYSEX_DEVICE_ID;
+    _reply[2] = CMD_NAK;
+    _reply[3] = cmd & 0x7F;
+    _reply[4] = error;
+    _reply_len = 5;
+}
+
+extern "C" {
+
+/**
+ * @brief UART error callback
+ * @param huart UART handle
+ *
+ * Counts USART2 receive errors and DMA errors of any UART. HAL stops the
+ * DMA reception on overrun, poll() notices the idle receiver and restarts it.
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+    if (huart->Instance == USART2 && _midi_in_inst) {
+        _midi_in_inst->_rx_errors++;
+    }
+    if (huart->ErrorCode & HAL_UART_ERROR_DMA) { health.count(HEALTH_DMA_ERROR); }
+}
+
+} // extern "C"
@@ -0,0 +1,177 @@
+/**
+ * @file midi_parser.cpp
+ * @brief Streaming MIDI byte parser
+ *
+ * This file implements the MidiParser class (running status, interleaved
+ * realtime bytes and SysEx framing).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "midi_parser.h"
+#include "string.h"
+
+/**
+ * @brief Construct a new MidiParser object
+ * @param sysex_buf Buffer for SysEx payload
+ * @param sysex_size Size of sysex_buf in bytes
+ */
+MidiParser::MidiParser(uint8_t* sysex_buf, uint16_t sysex_size) :
+    _onMessage(nullptr),
+    _onRealtime(nullptr),
+    _onSysEx(nullptr),
+    _sysex_buf(sysex_buf),
+    _sysex_size(sysex_size) {
+    memset(&_stats, 0, sizeof(_stats));
+    reset();
+}
+
+/**
+ * @brief Drop any partial message and running status
+ */
+void MidiParser::reset() {
+    _sysex_len = 0;
+    _in_sysex = false;
+    _sysex_overflow = false;
+    _status = 0;
+    _data_count = 0;
+    _data_needed = 0;
+}
+
+/**
+ * @brief Parse a block of bytes
+ * @param data Received bytes
+ * @param len Number of bytes
+ */
+void MidiParser::feed(const uint8_t* data, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        feed(data[i]);
+    }
+}
+
+/**
+ * @brief Parse one byte
+ * @param byte Received MIDI byte
+ *
+ * - 0xF8-0xFF (realtime): dispatched at once, parser state untouched
+ * - 0xF0: starts a SysEx frame, 0xF7 ends it
+ * - 0x80-0xEF: new running status
+ * - 0xF1-0xF6 (system common): cancels running status
+ * - Any other status byte inside a SysEx frame aborts the frame
+ */
+void MidiParser::feed(uint8_t byte) {
+    // Realtime bytes may appear anywhere, even between data bytes
+    if (byte >= 0xF8) {
+        _stats.realtime++;
+        if (_onRealtime) { _onRealtime(byte); }
+        return;
+    }
+
+    if (byte < 0x80) { // Data byte
+        if (_in_sysex) {
+            if (_sysex_len < _sysex_size) {
+                _sysex_buf[_sysex_len++] = byte;
+            } else {
+                _sysex_overflow = true;
+            }
+            return;
+        }
+
+        if (_status == 0) {
+            _stats.stray++;
+            return;
+        }
+
+        _data[_data_count++] = byte;
+        if (_data_count >= _data_needed) {
+            _dispatch();
+        }
+        return;
+    }
+
+    // Status byte
+    if (byte == 0xF7) {
+        if (_in_sysex) { _endSysEx(true); }
+        return;
+    }
+
+    if (_in_sysex) { _endSysEx(false); }
+
+    if (byte == 0xF0) {
+        _in_sysex = true;
+        _sysex_len = 0;
+        _sysex_overflow = false;
+        _status = 0; // SysEx cancels running status
+        return;
+    }
+
+    _status = byte;
+    _data_count = 0;
+    _data_needed = _dataLength(byte);
+    if (_data_needed == 0) { // e.g. Tune Request, or undefined 0xF4/0xF5
+        _dispatch();
+    }
+}
+
+/**
+ * @brief Dispatch the completed message
+ */
+void MidiParser::_dispatch() {
+    uint8_t status = _status;
+    _data_count = 0;
+
+    if (status >= 0xF0) {
+        _status = 0; // System common never establishes running status
+        if (status == 0xF4 || status == 0xF5) { return; } // Undefined
+    }
+
+    _stats.messages++;
+    if (_onMessage) {
+        _onMessage(status, (_data_needed > 0) ? _data[0] : 0, (_data_needed > 1) ? _data[1] : 0);
+    }
+}
+
+/**
+ * @brief Close the current SysEx frame
+ * @param complete true if terminated by 0xF7, false if cut off
+ */
+void MidiParser::_endSysEx(bool complete) {
+    _in_sysex = false;
+
+    if (!complete) {
+        _stats.sysex_aborted++;
+    } else if (_sysex_overflow) {
+        _stats.sysex_overflow++;
+    } else {
+        _stats.sysex++;
+        if (_onSysEx) { _onSysEx(_sysex_buf, _sysex_len); }
+    }
+
+    _sysex_len = 0;
+    _sysex_overflow = false;
+}
+
+/**
+ * @brief Number of data bytes following a status byte
+ * @param status Status byte (0x80-0xF7)
+ * @return uint8_t 0-2
+ */
+uint8_t MidiParser::_dataLength(uint8_t status) {
+    switch (status & 0xF0) {
+        case 0xC0: // Program Change
+        case 0xD0: // Channel Pressure
+            return 1;
+        case 0xF0:
+            switch (status) {
+                case 0xF1: return 1; // MTC Quarter Frame
+                case 0xF2: return 2; // Song Position Pointer
+                case 0xF3: return 1; // Song Select
+                default:   return 0;
+            }
+        default:   // Note Off/On, Poly Pressure, Control Change, Pitch Bend
+            return 2;
+    }
+}
@@ -15,116 +15,153 @@
  */
 
 #include "oled.h"
+#include "oled_bus.h"
+
+constexpr uint8_t OLED::ST[160];
 
 /**
  * @brief Construct a new OLED object
- * @param hi2c Pointer to I2C handle
- * @param height OLED display height in pixel rows
  */
-OLED::OLED(I2C_HandleTypeDef* hi2c, uint8_t height)
-    : _hi2c(hi2c), _height(height) {
-    memset(displayBuffer, 0, sizeof(displayBuffer));
+OLED::OLED() {
+    memset(_dirtyStart, OLED_COLUMN, sizeof(_dirtyStart));
+    memset(_dirtyEnd, 0, sizeof(_dirtyEnd));
 }
 
 /**
  * @brief Initialize OLED display
- * @return true if initialization succeeded, false otherwise
+ * @return true if the init sequence was queued
  * 
- * Performs the following initialization sequence:
- * 1. Display off command
- * 2. Set display clock divide ratio/oscillator frequency
- * 3. Set multiplex ratio
- * 4. Set display offset
- * 5. Set display start line
- * 6. Charge pump setting
- * 7. Set memory addressing mode
- * 8. Set segment re-map
- * 9. Set COM pins hardware configuration
- * 10. Set contrast control
- * 11. Set pre-charge period
- * 12. Set VCOMH deselect level
- * 13. Entire display on
- * 14. Set normal display
- * 15. Display on command
+ * Runs the display core's init sequence (OLED_Init(), also called by
+ * OLEDUI_Init()): configuration, a cleared frame, display on. The frame
+ * buffer then matches the panel, nothing is dirty.
  */
 bool OLED::begin() {
-	bool status = true;
-    HAL_Delay(20);
-
-    _wCmd(0xAE); // Display off
-    _wCmd(0xD5); _wCmd(0x80); // Set display clock divide ratio/oscillator frequency
-    _wCmd(0xA8); _wCmd(_height == 32 ? 0x1F : 0x3F); // Set multiplex ratio
-    _wCmd(0xD3); _wCmd(0x00); // Set display offset
-    _wCmd(0x40); // Set display start line
-    _wCmd(0x8D); _wCmd(0x14); // Charge pump setting
-    _wCmd(0x20); _wCmd(0x00); // Set memory addressing mode
-    _wCmd(0xA1); _wCmd(0xC8); // Set segment re-map
-    _wCmd(0xDA); _wCmd(_height == 32 ? 0x02 : 0x12); // Set COM pins hardware configuration
-    _wCmd(0x81); _wCmd(0xCF); // Set contrast control
-    _wCmd(0xD9); _wCmd(0xF1); // Set pre-charge period
-    _wCmd(0xDB); _wCmd(0x40); // Set VCOMH deselect level
-    _wCmd(0xA4); // Entire display on
-    _wCmd(0xA6); // Set normal display
-    status = _wCmd(0xAF); // Display on
-
-    HAL_Delay(10);
-
-    clear();
-    return status;
+    uint32_t dropped = oledBus.getDropped();
+    OLED_Init();
+    memset(_dirtyStart, OLED_COLUMN, sizeof(_dirtyStart));
+    memset(_dirtyEnd, 0, sizeof(_dirtyEnd));
+    return oledBus.getDropped() == dropped;
 }
 
 /**
- * @brief Send command to OLED display
- * @param command Command byte to send
- * @return true if command sent successfully, false otherwise
+ * @brief Queue a command sequence on the OLED bus
+ * @param commands Command bytes (with their arguments)
+ * @param len Number of bytes
+ * @return true if queued, false if dropped (OLED bus queue full)
+ */
+bool OLED::_wCmds(const uint8_t* commands, uint8_t len) {
+    return oledBus.cmds(commands, len);
+}
+
+/**
+ * @brief Widen the dirty span of a page
+ * @param page Page
+ * @param x1 First column
+ * @param x2 End column, exclusive
+ */
+void OLED::_markDirty(uint8_t page, uint8_t x1, uint8_t x2) {
+    if (x1 < _dirtyStart[page]) { _dirtyStart[page] = x1; }
+    if (x2 > _dirtyEnd[page]) { _dirtyEnd[page] = x2; }
+}
+
+/**
+ * @brief Draw a page-format block (glyph / image) into the frame buffer
+ * @param x Column (0-127)
+ * @param page First page
+ * @param data Block data, page by page (font.h atlas format)
+ * @param width Width in columns
+ * @param pages Height in pages
  * 
- * Writes a command byte to the OLED's command register (0x00)
- * using I2C memory write operation.
+ * Page aligned, so the display core copies whole column rows. Clipped at
+ * the edges; the dirty span only grows if the buffer changes.
  */
-bool OLED::_wCmd(uint8_t command) {
-	bool status = true;
-    // 0x00: command register
-    if (HAL_I2C_Mem_Write(_hi2c, OLED_ADDR, 0x00, I2C_MEMADD_SIZE_8BIT, &command, 1, 10) != HAL_OK) {
-		status = false;
-	}
-
-	return status;
+void OLED::_blit(uint8_t x, uint8_t page, const uint8_t* data, uint8_t width, uint8_t pages) {
+    if (page >= OLED_PAGE || x >= OLED_COLUMN) { return; }
+    if (!OLED_BlitBlock(x, page * 8, data, width, pages * 8, OLED_COLOR_NORMAL)) { return; }
+
+    uint8_t x2 = (x + width > OLED_COLUMN) ? OLED_COLUMN : x + width;
+    for (uint8_t i = page; i < page + pages && i < OLED_PAGE; i++) {
+        _markDirty(i, x, x2);
+    }
+}
+
+/**
+ * @brief Write a byte into the frame buffer
+ * @param page Page (0 ~ OLED_PAGE-1)
+ * @param x Column (0-127)
+ * @param data Column byte
+ * 
+ * Out of range writes are dropped. The dirty span only grows if the byte changes.
+ */
+void OLED::_write(uint8_t page, uint8_t x, uint8_t data) {
+    if (page >= OLED_PAGE || x >= OLED_COLUMN) { return; }
+    if (OLED_GRAM[page][x] == data) { return; }
+
+    OLED_GRAM[page][x] = data;
+    _markDirty(page, x, x + 1);
+}
+
+/**
+ * @brief Queue the dirty pages of the frame buffer on the OLED bus
+ * @return true if all pages were queued, false if the bus queue was full (retry later)
+ * 
+ * The display core (OLED_ShowFramePage()) compares each dirty page with the
+ * last sent frame and queues only the changed columns; the bus sets the
+ * address window itself. Returns at once, the transfers run in the background.
+ */
+bool OLED::flush() {
+    for (uint8_t page = 0; page < OLED_PAGE; page++) {
+        if (_dirtyStart[page] >= _dirtyEnd[page]) { continue; }
+
+        if (!OLED_ShowFramePage(page)) { return false; }
+
+        _dirtyStart[page] = OLED_COLUMN;
+        _dirtyEnd[page] = 0;
+    }
+    return true;
 }
 
 /**
- * @brief Send data to OLED display
- * @param data Data byte to send
+ * @brief Mark the whole display dirty
  * 
- * Writes a data byte to the OLED's data register (0x40)
- * using I2C memory write operation.
+ * For when the panel content may no longer match the buffer (e.g. after a power cycle of the panel).
  */
-void OLED::_wData(uint8_t data) {
-    // 0x40: data register
-    HAL_I2C_Mem_Write(_hi2c, OLED_ADDR, 0x40, I2C_MEMADD_SIZE_8BIT, &data, 1, 10);
+void OLED::invalidate() {
+    OLED_InvalidateFrame();
+    for (uint8_t page = 0; page < OLED_PAGE; page++) {
+        _markDirty(page, 0, OLED_COLUMN);
+    }
 }
 
 /**
- * @brief Set a single pixel on/off on OLED display
+ * @brief Check for unsent changes
+ * @return true if a page has a dirty span
+ */
+bool OLED::isDirty() {
+    for (uint8_t page = 0; page < OLED_PAGE; page++) {
+        if (_dirtyStart[page] < _dirtyEnd[page]) { return true; }
+    }
+    return false;
+}
+
+/**
+ * @brief Set a single pixel on/off in the display buffer
  * @param x Column position (0-127)
  * @param y Row position (0-height-1)
  * @param state true to turn pixel on, false to turn off
  * 
- * Updates the display buffer and immediately writes the change to OLED.
- * Handles coordinate bounds checking.
+ * Handles coordinate bounds checking. Shown by the next flush().
  */
 void OLED::setPixel(uint8_t x, uint8_t y, bool state) {
-    if (x >= 128 || y >= _height) return;
+    if (x >= OLED_COLUMN || y >= OLED_ROW) return;
     uint8_t page = y / 8;
     uint8_t bit = y % 8;
 
     if (state) {
-        displayBuffer[page][x] |= (1 << bit);
+        _write(page, x, OLED_GRAM[page][x] | (1 << bit));
     } else {
-        displayBuffer[page][x] &= ~(1 << bit);
+        _write(page, x, OLED_GRAM[page][x] & ~(1 << bit));
     }
-
-    setCursor(x, page);
-    _wData(displayBuffer[page][x]);
 }
 
 /**
@@ -132,89 +169,59 @@ void OLED::setPixel(uint8_t x, uint8_t y, bool state) {
  * @param x Column position (0-127)
  * @param y Page position (0-7 for 64px height, 0-3 for 32px height)
  * 
- * Sets the display start position by:
+ * Sets the display start position (page addressing commands) by:
  * 1. Setting page address (0xB0 + y)
  * 2. Setting lower column address (x & 0x0F)
  * 3. Setting higher column address ((x & 0xF0) >> 4)
+ * 
+ * Not needed for drawing, flush() sets its own window.
  */
 void OLED::setCursor(uint8_t x, uint8_t y) {
-    uint8_t lines = _height == 32 ? 3 : 7;
-    if (y > lines) y = lines;
+    if (y > OLED_PAGE - 1) y = OLED_PAGE - 1;
     if (x > 127) x = 127;
-    
-    _wCmd(0xB0 + y); // Set page address
-    _wCmd(0x00 | (x & 0x0F)); // Set lower column address
-    _wCmd(0x10 | ((x & 0xF0) >> 4)); // Set higher column address
+
+    const uint8_t cursor[] = { (uint8_t)(0xB0 + y), (uint8_t)(0x00 | (x & 0x0F)), (uint8_t)(0x10 | ((x & 0xF0) >> 4)) };
+    _wCmds(cursor, sizeof(cursor));
 }
 
 /**
  * @brief Update the entire display buffer to OLED
  * 
- * Writes the entire display buffer (8 pages x 128 columns) to the OLED
- * by iterating through each page and column, sending the buffer data.
+ * Marks the whole buffer dirty and flushes it.
  */
 void OLED::updateBufferArea() {
-    for (uint8_t page = 0; page < 8; page++) {
-        setCursor(0, page);
-        for (uint8_t col = 0; col < 128; col++) {
-            _wData(displayBuffer[page][col]);
-        }
-    }
+    invalidate();
+    flush();
 }
 
 /**
- * @brief Clear the entire OLED display
+ * @brief Clear the entire display buffer
  * 
- * Fills the display buffer with zeros and updates the OLED.
- * Automatically adjusts for display height (32 or 64 pixels).
- * Resets cursor to (0,0) position after clearing.
+ * All OLED_PAGE pages, shown by the next flush().
  */
 void OLED::clear() {
-    uint8_t i, j;
-    uint8_t lines = 8;
-
-    if (_height == 32) {
-        lines = 4;
-    }
-
-    for (i = 0; i < lines; i++) {
-        setCursor(0, i);
-        for (j = 0; j < 128; j++) {
-            _wData(0x00);
-            displayBuffer[i][j] = 0;
-        }
-    }
-    setCursor(0, 0);
+    clearPart(0, 0, OLED_COLUMN, OLED_PAGE);
 }
 
 /**
- * @brief Clear a specific area of the OLED display
+ * @brief Clear a specific area of the display buffer
  * @param x1 Starting column (0-127)
  * @param page1 Starting page (0-7)
- * @param x2 Ending column (0-127)
- * @param page2 Ending page (0-7)
- * 
- * Clears the specified rectangular area by:
- * 1. Bounds checking the input parameters
- * 2. Filling the specified area with zeros
- * 3. Updating both display buffer and OLED
- * 4. Resetting cursor to (x1,page1) after clearing
+ * @param x2 Ending column, exclusive (1-128)
+ * @param page2 Ending page, exclusive (1-8)
  */
 void OLED::clearPart(uint8_t x1, uint8_t page1, uint8_t x2, uint8_t page2) {
-    if (x1 >= 128 || x2 >= 128 || page1 >= 8 || page2 >= 8) return;
-    
+    if (x1 >= OLED_COLUMN || x2 > OLED_COLUMN || page1 >= OLED_PAGE || page2 > OLED_PAGE) return;
+
     for (uint8_t i = page1; i < page2; i++) {
-        setCursor(x1, i);
         for (uint8_t j = x1; j < x2; j++) {
-            _wData(0x00);
-            displayBuffer[i][j] = 0;
+            _write(i, j, 0x00);
         }
     }
-    setCursor(x1, page1);
 }
 
 /**
- * @brief Print text on OLED display
+ * @brief Print text into the display buffer
  * @param x Starting column position (0-127)
  * @param y Starting row position (0-3/7)
  * @param str String to display
@@ -224,39 +231,27 @@ void OLED::clearPart(uint8_t x1, uint8_t page1, uint8_t x2, uint8_t page2) {
  * - Newline characters (\n)
  * - Automatic line wrapping when reaching display edge
  * - Character range 0x20-0x7E (printable ASCII)
- * - Two font sizes: 6x8 and 8x16
+ * - Two font sizes: 6x8 and 8x16 (afontPage8x6 / afontPage16x8 of font.h)
+ * 
+ * Glyphs are page aligned: each is a row copy per page (_blit()).
  */
 void OLED::printText(uint8_t x, uint8_t y, const char* str, uint8_t size) {
+    const ASCIIFont* font = (size == 8) ? &afontPage8x6 : (size == 16) ? &afontPage16x8 : nullptr;
+    if (!font) return;
+
     while (*str) {
         if (*str == '\n') {
             x = 0;
             y += size;
-            if (y >= _height) y = 0;
-            setCursor(x, y);
+            if (y >= OLED_ROW) y = 0;
         } else if (*str >= 0x20 && *str <= 0x7E) {
-            uint8_t charIndex = *str - 0x20;
-            if (size == 8) {
-                // 6x8 font
-                setCursor(x, y);
-                for (uint8_t i = 0; i < 6; i++) {
-                    _wData(_font6x8[charIndex][i]);
-                }
-                x += 6;
-            } else if (size == 16) {
-                // 8x16 font (spans two pages)
-                for (uint8_t row = 0; row < 2; row++) {
-                    setCursor(x, y + row);
-                    for (uint8_t i = 0; i < 8; i++) {
-                        _wData(_font8x16[charIndex][row*8 + i]);
-                    }
-                }
-                x += 8;
-            }
+            _blit(x, y, OLED_GetGlyph(font, *str), font->w, font->h / 8);
+            x += font->w;
             
             if (x >= 128) {
                 x = 0;
                 y += size;
-                if (y >= _height) y = 0;
+                if (y >= OLED_ROW) y = 0;
             }
         }
         str++;
@@ -264,7 +259,7 @@ void OLED::printText(uint8_t x, uint8_t y, const char* str, uint8_t size) {
 }
 
 /**
- * @brief Print an image on OLED display
+ * @brief Print an image into the display buffer
  * @param x Starting column position (0-127)
  * @param y Starting row position (0-3/7)
  * @param width Image width in pixels
@@ -272,16 +267,11 @@ void OLED::printText(uint8_t x, uint8_t y, const char* str, uint8_t size) {
  * @param image Pointer to image data array
  * 
  * The image data should be organized as a 2D array in row-major order:
- * image[height][width]
+ * image[height / 8][width]
  * Each byte represents 8 vertical pixels (1 bit per pixel)
  */
 void OLED::printImage(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t* image) {
-    for (uint8_t i = 0; i < _height; i++) {
-        setCursor(x, y + i);
-        for (uint8_t j = 0; j < width; j++) {
-            _wData(image[i * width + j]);
-        }
-    }
+    _blit(x, y, image, width, (height + 7) / 8);
 }
 
 /**
@@ -387,7 +377,7 @@ void OLED::printVar(uint8_t x, uint8_t y, float num, const char* type, uint8_t l
 }
 
 /**
- * @brief Draw a horizontal line on OLED display
+ * @brief Draw a horizontal line into the display buffer
  * @param x Starting column position (0-127)
  * @param y Row position (0-3/7)
  * @param width Line width in pixels
@@ -395,9 +385,8 @@ void OLED::printVar(uint8_t x, uint8_t y, float num, const char* type, uint8_t l
  * Draws a solid horizontal line by filling pixels with 1s.
  */
 void OLED::printHLine(uint8_t x, uint8_t y, uint8_t width) {
-    setCursor(x, y);
     for (uint8_t i = 0; i < width; i++) {
-        _wData(0xFF);
+        _write(y, x + i, 0xFF);
     }
 }
 
@@ -415,8 +404,8 @@ void OLED::printHLine(uint8_t x, uint8_t y, uint8_t width) {
  * Controls display contrast by sending appropriate commands.
  */
 void OLED::lowBrightness(bool enable) {
-    _wCmd(0x81);
-    _wCmd(enable ? 0x10 : 0xCF);
+    const uint8_t contrast[] = { 0x81, (uint8_t)(enable ? 0x10 : 0xCF) };
+    _wCmds(contrast, sizeof(contrast));
 }
 
 /**
@@ -426,7 +415,9 @@ void OLED::lowBrightness(bool enable) {
  * Sends display on/off command (0xAF/0xAE) to control power state.
  */
 void OLED::power(bool state) {
-	_wCmd(0x8D);
-	_wCmd(state ? 0x14 : 0x10); // Enable/disable charge pump
-    _wCmd(state ? 0xAF : 0xAE);
+    const uint8_t power[] = {
+        0x8D, (uint8_t)(state ? 0x14 : 0x10),   // Enable/disable charge pump
+        (uint8_t)(state ? 0xAF : 0xAE)
+    };
+    _wCmds(power, sizeof(power));
 }
@@ -0,0 +1,245 @@
+/**
+ * @file oled_bus.cpp
+ * @brief Asynchronous OLED transport (I2C1 DMA job queue)
+ *
+ * See oled_bus.h for the job types and the merging rules.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "oled_bus.h"
+#include "i2c.h"
+#include "health.h"
+#include <string.h>
+
+#define OLED_BUS_RETRIES 3              // Sends of one transaction before it is given up
+
+OledBus oledBus;
+
+/**
+ * @brief Construct a new OledBus object
+ */
+OledBus::OledBus()
+    : _head(0), _tail(0), _busy(false), _txLen(0), _txPage(OLED_BUS_PAGES), _retries(0),
+      _jobs(0), _merged(0), _dropped(0) {
+    memset(_rows, 0, sizeof(_rows));
+    memset(_spanStart, OLED_BUS_COLUMNS, sizeof(_spanStart));
+    memset(_spanEnd, 0, sizeof(_spanEnd));
+    memset(_queued, 0, sizeof(_queued));
+}
+
+/**
+ * @brief Reserve the next queue slot (interrupts masked)
+ * @return Job* Slot to fill before _head is advanced, nullptr if the queue is full
+ */
+OledBus::Job* OledBus::_push() {
+    if ((uint8_t)(_head - _tail) >= OLED_BUS_QUEUE_LEN) {
+        _dropped++;
+        health.count(HEALTH_OLED_DROP);
+        return nullptr;
+    }
+    return &_queue[_head & (OLED_BUS_QUEUE_LEN - 1)];
+}
+
+/**
+ * @brief Queue a command sequence
+ * @param cmds Command bytes (with their arguments)
+ * @param len Number of bytes (1 ~ OLED_BUS_CMD_MAX)
+ * @return true if queued, false if dropped (queue full)
+ *
+ * Appended to the last job if that is a waiting command job with room left.
+ */
+bool OledBus::cmds(const uint8_t* cmds, uint8_t len) {
+    if (len == 0 || len > OLED_BUS_CMD_MAX) { return false; }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    bool queued = true;
+    Job* last = (_head != _tail) ? &_queue[(uint8_t)(_head - 1) & (OLED_BUS_QUEUE_LEN - 1)] : nullptr;
+    if (last && last->page == OLED_BUS_PAGES && last->len + len <= OLED_BUS_CMD_MAX) {
+        memcpy(&last->cmds[last->len], cmds, len);
+        last->len += len;
+    } else if (Job* job = _push()) {
+        job->page = OLED_BUS_PAGES;
+        job->len = len;
+        memcpy(job->cmds, cmds, len);
+        _head = _head + 1;
+    } else {
+        queued = false;
+    }
+
+    _kick();
+    __set_PRIMASK(primask);
+    return queued;
+}
+
+/**
+ * @brief Queue a column span of a display page
+ * @param page Page (0 ~ OLED_BUS_PAGES-1)
+ * @param x1 First column
+ * @param x2 End column, exclusive
+ * @param row The whole page row, only the (merged) span is read
+ * @return true if queued or merged, false if dropped (queue full)
+ *
+ * The copy runs with interrupts masked: at most one row, well below 1 us.
+ */
+bool OledBus::page(uint8_t page, uint8_t x1, uint8_t x2, const uint8_t* row) {
+    if (page >= OLED_BUS_PAGES || x1 >= x2 || x2 > OLED_BUS_COLUMNS) { return false; }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    bool queued = true;
+    if (_queued[page]) {
+        _merged++;
+    } else if (Job* job = _push()) {
+        job->page = page;
+        job->len = 0;
+        _head = _head + 1;
+        _queued[page] = true;
+    } else {
+        queued = false;
+    }
+
+    if (queued) {
+        if (x1 < _spanStart[page]) { _spanStart[page] = x1; }
+        if (x2 > _spanEnd[page]) { _spanEnd[page] = x2; }
+        memcpy(&_rows[page][_spanStart[page]], &row[_spanStart[page]], _spanEnd[page] - _spanStart[page]);
+    }
+
+    _kick();
+    __set_PRIMASK(primask);
+    return queued;
+}
+
+/**
+ * @brief Start the next transfer unless one is in flight (interrupts masked)
+ */
+void OledBus::_kick() {
+    if (!_busy) { _startNext(); }
+}
+
+/**
+ * @brief Build the next transaction if none is pending and start its DMA (bus idle, interrupts masked)
+ *
+ * A transaction stays in _tx until it completes, a failed start or a
+ * transfer error sends it again (up to OLED_BUS_RETRIES times).
+ */
+void OledBus::_startNext() {
+    if (_txLen == 0) {
+        if (_head == _tail) { return; }
+
+        Job& job = _queue[_tail & (OLED_BUS_QUEUE_LEN - 1)];
+        uint8_t* p = _tx;
+
+        if (job.page < OLED_BUS_PAGES) {
+            uint8_t page = job.page;
+            uint8_t x1 = _spanStart[page];
+            uint8_t len = _spanEnd[page] - x1;
+            const uint8_t window[OLED_BUS_WINDOW_CMD_LEN] = { 0x21, x1, (uint8_t)(x1 + len - 1), 0x22, page, page };
+
+            for (uint8_t i = 0; i < OLED_BUS_WINDOW_CMD_LEN; i++) {
+                *p++ = 0x80; // Co = 1: one command byte, then another control byte
+                *p++ = window[i];
+            }
+            *p++ = 0x40;
+            memcpy(p, &_rows[page][x1], len);
+            p += len;
+
+            _spanStart[page] = OLED_BUS_COLUMNS;
+            _spanEnd[page] = 0;
+            _queued[page] = false;
+            _txPage = page;
+        } else {
+            *p++ = 0x00; // Co = 0, D/C# = 0: all following bytes are commands
+            memcpy(p, job.cmds, job.len);
+            p += job.len;
+            _txPage = OLED_BUS_PAGES;
+        }
+
+        _tail = _tail + 1;
+        _txLen = (uint16_t)(p - _tx);
+        _retries = 0;
+    }
+
+    if (HAL_I2C_Master_Transmit_DMA(&hi2c1, OLED_BUS_ADDR, _tx, _txLen) == HAL_OK) {
+        _busy = true;
+    } else {
+        health.count(HEALTH_I2C_RETRY); // poll() tries again
+    }
+}
+
+/**
+ * @brief Check whether all jobs are sent
+ * @return true if the queue is empty and the bus idle
+ */
+bool OledBus::isIdle() {
+    return _head == _tail && _txLen == 0;
+}
+
+/**
+ * @brief Wait until all jobs are sent
+ * @param timeout_ms Max wait
+ * @return true if idle, false on timeout
+ */
+bool OledBus::wait(uint32_t timeout_ms) {
+    uint32_t start = HAL_GetTick();
+    while (!isIdle()) {
+        if (HAL_GetTick() - start > timeout_ms) { return false; }
+        poll();
+    }
+    return true;
+}
+
+/**
+ * @brief Restart the queue after a failed start or a transfer error
+ *
+ * The I2C returns to READY without a TX complete callback only on error
+ * (counted by HAL_I2C_ErrorCallback); the transaction is sent again. A page
+ * transaction given up invalidates its page in the display core.
+ */
+void OledBus::poll() {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (_busy && hi2c1.State == HAL_I2C_STATE_READY) {
+        _busy = false;
+        if (++_retries > OLED_BUS_RETRIES) {
+            health.count(HEALTH_I2C_TIMEOUT);
+            if (_txPage < OLED_BUS_PAGES) { OLED_InvalidatePage(_txPage); } // Resent in full by the next refresh
+            _txLen = 0; // Given up, go on with the next job
+        }
+    }
+    if (!_busy) { _startNext(); }
+    __set_PRIMASK(primask);
+}
+
+extern "C" {
+
+bool OledBus_Cmds(const uint8_t* cmds, uint8_t len) {
+    return oledBus.cmds(cmds, len);
+}
+
+bool OledBus_Page(uint8_t page, uint8_t x1, uint8_t x2, const uint8_t* row) {
+    return oledBus.page(page, x1, x2, row);
+}
+
+/**
+ * @brief I2C master TX complete callback
+ * @param hi2c I2C handle
+ *
+ * Releases the sent transaction and chains the next one.
+ */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    if (hi2c->Instance == I2C1) {
+        oledBus._busy = false;
+        oledBus._txLen = 0;
+        oledBus._jobs++;
+        oledBus._startNext();
+    }
+}
+
+} // extern "C"
@@ -43,6 +43,16 @@ const char* Pad::ID2Str(PadID id) {
     }
 }
 
+/**
+ * @brief Copy the current raw ADC value of every pad (PadID order)
+ * @param out Destination, PAD_NUM values
+ */
+void Pad::readAll(uint16_t* out) {
+    for (uint8_t i = 0; i < ADC1_PAD_NUMS; i++) { *out++ = adc1_buf[i]; }
+    for (uint8_t i = 0; i < ADC2_PAD_NUMS; i++) { *out++ = adc2_buf[i]; }
+    for (uint8_t i = 0; i < ADC3_PAD_NUMS; i++) { *out++ = adc3_buf[i]; }
+}
+
 /**
  * @brief Construct a new Pad object
  * @param piezo_adc_group ADC group the pad is connected to
@@ -71,7 +81,10 @@ Pad::Pad(ADCGroup piezo_adc_group, uint8_t piezo_adc_index, GPIO_TypeDef* out_po
     _adc_measuring(false),
     _measurement_cplt(false),
     _adc_measuring_start_time(0),
-    _last_adc_measuring_state(0) {}
+    _last_adc_measuring_state(0),
+    _hit_cycles(0),
+    _last_peak(0),
+    _last_window_ms(0) {}
 
 /**
  * @brief Detect hit and start force measurement window (call in main loop)
@@ -85,6 +98,7 @@ void Pad::detectHit() {
     if (current_hit && !_adc_measuring) {
         _adc_measuring = true;
         _peak_val = 0;
+        _hit_cycles = DWT_GetCycles();
     }
 }
 
@@ -137,6 +151,8 @@ void Pad::measureForce() {
             } else {
                 _force = _force_map(_peak_val);
             }
+            _last_peak = _peak_val;
+            _last_window_ms = (uint16_t)(now - _adc_measuring_start_time);
 
             #ifndef PEAK_CHK_DBG
             _peak_val = 0;
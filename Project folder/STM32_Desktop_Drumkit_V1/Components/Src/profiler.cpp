@@ -0,0 +1,157 @@
+/**
+ * @file profiler.cpp
+ * @brief Cycle-accurate scope profiler based on the DWT cycle counter
+ *
+ * This file implements the Profiler class (log-scale histograms and
+ * percentile lookup, see profiler.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "profiler.h"
+#include "string.h"
+#include "logger.h"
+
+Profiler profiler; // Global profiler instance
+
+/**
+ * @brief Construct a new Profiler object
+ */
+Profiler::Profiler() {
+    reset();
+}
+
+/**
+ * @brief Clear all histograms
+ */
+void Profiler::reset() {
+    memset(_hist, 0, sizeof(_hist));
+    for (uint8_t i = 0; i < SCOPE_NUM; i++) {
+        _hist[i].min = 0xFFFFFFFF;
+    }
+}
+
+/**
+ * @brief Map a sample to its histogram bucket
+ * @param cycles Duration in CPU cycles
+ * @return uint8_t Bucket index
+ *
+ * Bucket = octave (position of the top bit) and the next two bits below it.
+ */
+uint8_t Profiler::_bucketOf(uint32_t cycles) {
+    if (cycles < (1UL << PROF_HIST_MIN_SHIFT)) { return 0; }
+
+    uint8_t msb = 31 - __CLZ(cycles);
+    uint8_t octave = msb - PROF_HIST_MIN_SHIFT;
+    if (octave >= PROF_HIST_OCTAVES) { return PROF_HIST_BUCKETS - 1; }
+
+    uint8_t sub = (cycles >> (msb - 2)) & (PROF_HIST_SUB - 1);
+    return 1 + octave * PROF_HIST_SUB + sub;
+}
+
+/**
+ * @brief Largest sample that falls into a bucket
+ * @param bucket Bucket index
+ * @return uint32_t Cycles
+ */
+uint32_t Profiler::_bucketUpper(uint8_t bucket) {
+    if (bucket == 0) { return (1UL << PROF_HIST_MIN_SHIFT) - 1; }
+    if (bucket >= PROF_HIST_BUCKETS - 1) { return 0xFFFFFFFF; }
+
+    uint8_t octave = (bucket - 1) / PROF_HIST_SUB;
+    uint8_t sub = (bucket - 1) % PROF_HIST_SUB;
+    uint32_t step = 1UL << (octave + PROF_HIST_MIN_SHIFT - 2);
+    return (1UL << (octave + PROF_HIST_MIN_SHIFT)) + (sub + 1) * step - 1;
+}
+
+/**
+ * @brief Record one sample
+ * @param scope Scope
+ * @param cycles Duration in CPU cycles
+ */
+void Profiler::record(Scope scope, uint32_t cycles) {
+    if (scope >= SCOPE_NUM) { return; }
+
+    Hist& h = _hist[scope];
+    h.count++;
+    h.sum += cycles;
+    if (cycles < h.min) { h.min = cycles; }
+    if (cycles > h.max) { h.max = cycles; }
+    h.bucket[_bucketOf(cycles)]++;
+}
+
+/**
+ * @brief Get a percentile of a scope
+ * @param scope Scope
+ * @param permille Percentile in 1/1000 (990 = p99)
+ * @return uint32_t Cycles (bucket upper bound, clamped to max)
+ */
+uint32_t Profiler::getPercentile(Scope scope, uint16_t permille) {
+    if (scope >= SCOPE_NUM || _hist[scope].count == 0) { return 0; }
+
+    const Hist& h = _hist[scope];
+    uint64_t rank = ((uint64_t)h.count * permille + 999) / 1000; // Samples at or below the percentile
+    uint32_t seen = 0;
+
+    for (uint8_t b = 0; b < PROF_HIST_BUCKETS; b++) {
+        seen += h.bucket[b];
+        if (seen >= rank) {
+            uint32_t upper = _bucketUpper(b);
+            return (upper < h.max) ? upper : h.max;
+        }
+    }
+    return h.max;
+}
+
+/**
+ * @brief Get min/avg/p99/max of a scope
+ * @param scope Scope
+ * @return Summary Summary (all zero if no sample yet)
+ */
+Profiler::Summary Profiler::getSummary(Scope scope) {
+    Summary s;
+    memset(&s, 0, sizeof(s));
+    if (scope >= SCOPE_NUM || _hist[scope].count == 0) { return s; }
+
+    const Hist& h = _hist[scope];
+    s.count = h.count;
+    s.min = h.min;
+    s.avg = (uint32_t)(h.sum / h.count);
+    s.p99 = getPercentile(scope, 990);
+    s.max = h.max;
+    return s;
+}
+
+/**
+ * @brief Convert scope to string
+ * @param scope Scope
+ * @return const char* Scope name
+ */
+const char* Profiler::Scope2Str(Scope scope) {
+    switch (scope) {
+        case PAD_SCAN:      return "PadScan";
+        case MEASURE_FORCE: return "MeasForce";
+        case MIDI_SEND:     return "MidiSend";
+        case AUTO_NOTE_OFF: return "NoteOff";
+        case UI_SHOW:       return "UIShow";
+        case OLED_FLUSH:    return "OLEDFlush";
+        default:            return "Unknown";
+    }
+}
+
+/**
+ * @brief Print all scopes to the debug UART (cycles)
+ */
+void Profiler::dumpStats() {
+    LOG_I("Profiler (cycles @ %lu MHz):", SystemCoreClock / 1000000UL);
+
+    for (uint8_t i = 0; i < SCOPE_NUM; i++) {
+        Scope scope = static_cast<Scope>(i);
+        Summary s = getSummary(scope);
+        LOG_I("  %-9s n:%lu min:%lu avg:%lu p99:%lu max:%lu",
+              Scope2Str(scope), s.count, s.min, s.avg, s.p99, s.max);
+    }
+}
@@ -0,0 +1,180 @@
+/**
+ * @file scheduler.cpp
+ * @brief Prioritised cooperative task scheduler
+ *
+ * This file implements the Scheduler class (task release, priority
+ * selection and per task timing statistics, see scheduler.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "scheduler.h"
+#include "string.h"
+#include "logger.h"
+
+Scheduler scheduler; // Global scheduler instance
+
+/**
+ * @brief Construct a new Scheduler object
+ */
+Scheduler::Scheduler() :
+    _task_count(0),
+    _idle_since(0),
+    _idle(false),
+    _idle_cycles(0) {
+    memset(_tasks, 0, sizeof(_tasks));
+}
+
+/**
+ * @brief Register a periodic task
+ * @param name Task name (for stats output)
+ * @param fn Task function
+ * @param period_us Release period in microseconds
+ * @param priority Priority, 0 is the highest
+ * @return int8_t Task index, -1 if the task table is full
+ *
+ * The first release is immediate.
+ */
+int8_t Scheduler::addPeriodic(const char* name, TaskFunc fn, uint32_t period_us, uint8_t priority) {
+    return _add(name, fn, nullptr, DWT_UsToCycles(period_us ? period_us : 1), priority);
+}
+
+/**
+ * @brief Register an event task
+ * @param name Task name (for stats output)
+ * @param fn Task function
+ * @param ready Release condition, polled when the task is idle
+ * @param priority Priority, 0 is the highest
+ * @return int8_t Task index, -1 if the task table is full
+ */
+int8_t Scheduler::addEvent(const char* name, TaskFunc fn, ReadyFunc ready, uint8_t priority) {
+    return _add(name, fn, ready, 0, priority);
+}
+
+int8_t Scheduler::_add(const char* name, TaskFunc fn, ReadyFunc ready, uint32_t period_cycles, uint8_t priority) {
+    if (_task_count >= SCHED_MAX_TASKS || !fn) { return -1; }
+
+    Task& t = _tasks[_task_count];
+    memset(&t, 0, sizeof(t));
+    t.name = name;
+    t.fn = fn;
+    t.ready = ready;
+    t.period_cycles = period_cycles;
+    t.next_release = DWT_GetCycles();
+    t.priority = priority;
+    return _task_count++;
+}
+
+/**
+ * @brief Release due tasks
+ * @param now Current DWT timestamp
+ *
+ * A periodic job that is still active at its next release missed its
+ * deadline, it keeps running and the new release merges into it. A release
+ * found more than one period late (the CPU was busy elsewhere) is a miss as
+ * well; the skipped periods are dropped instead of being run back to back.
+ */
+void Scheduler::_release(uint32_t now) {
+    for (uint8_t i = 0; i < _task_count; i++) {
+        Task& t = _tasks[i];
+
+        if (t.period_cycles == 0) {
+            if (!t.active && t.ready()) { t.active = true; }
+            continue;
+        }
+
+        if ((int32_t)(now - t.next_release) < 0) { continue; }
+
+        if (t.active) { t.stats.misses++; }
+        t.active = true;
+        t.next_release += t.period_cycles;
+
+        if ((int32_t)(now - t.next_release) >= 0) {
+            t.stats.misses++;
+            t.next_release = now + t.period_cycles;
+        }
+    }
+}
+
+/**
+ * @brief Release due tasks and run one slice of the highest priority one
+ * @return true if a slice was run, false if all tasks were idle
+ */
+bool Scheduler::runOnce() {
+    uint32_t now = DWT_GetCycles();
+    _release(now);
+
+    Task* next = nullptr;
+    for (uint8_t i = 0; i < _task_count; i++) {
+        if (_tasks[i].active && (!next || _tasks[i].priority < next->priority)) {
+            next = &_tasks[i];
+        }
+    }
+
+    if (!next) {
+        if (!_idle) {
+            _idle = true;
+            _idle_since = now;
+        }
+        return false;
+    }
+
+    if (_idle) {
+        _idle_cycles += now - _idle_since;
+        _idle = false;
+    }
+
+    uint32_t start = DWT_GetCycles();
+    bool more = next->fn();
+    uint32_t elapsed = DWT_GetCycles() - start;
+
+    TaskStats& s = next->stats;
+    s.slices++;
+    s.last_cycles = elapsed;
+    s.total_cycles += elapsed;
+    if (elapsed > s.wcet_cycles) { s.wcet_cycles = elapsed; }
+
+    if (!more) {
+        next->active = false;
+        s.jobs++;
+    }
+    return true;
+}
+
+/**
+ * @brief Get task name
+ * @param index Task index
+ * @return const char* Name ("" if out of range)
+ */
+const char* Scheduler::getTaskName(uint8_t index) {
+    return (index < _task_count) ? _tasks[index].name : "";
+}
+
+/**
+ * @brief Reset statistics of all tasks
+ */
+void Scheduler::resetStats() {
+    for (uint8_t i = 0; i < _task_count; i++) {
+        memset(&_tasks[i].stats, 0, sizeof(TaskStats));
+    }
+    _idle_cycles = 0;
+}
+
+/**
+ * @brief Print task statistics to the debug UART
+ *
+ * One line per task: jobs, slices, deadline misses, WCET and average slice
+ * time in microseconds.
+ */
+void Scheduler::dumpStats() {
+    for (uint8_t i = 0; i < _task_count; i++) {
+        const TaskStats& s = _tasks[i].stats;
+        uint32_t avg = s.slices ? (uint32_t)(s.total_cycles / s.slices) : 0;
+        LOG_I("Task %-6s jobs:%lu slices:%lu miss:%lu wcet:%luus avg:%luus",
+              _tasks[i].name, s.jobs, s.slices, s.misses,
+              DWT_CyclesToUs(s.wcet_cycles), DWT_CyclesToUs(avg));
+    }
+}
@@ -0,0 +1,368 @@
+/**
+ * @file shell.cpp
+ * @brief Serial command shell on the debug UART (USART1 RX)
+ *
+ * This file implements the Shell class: circular DMA reception, feeding
+ * the line parser from the ring and the command table (see shell.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "shell.h"
+#include "pad.h"
+#include "midi.h"
+#include "midi_in.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "logger.h"
+#include "trace.h"
+#include "wavestream.h"
+#include "hitrec.h"
+#include "hitcapture.h"
+#include "health.h"
+#include "ui.h"
+#include "oled_bus.h"
+
+Shell shell; // Global shell instance
+
+typedef void (*CommandFunc)(uint8_t argc, const char* const* argv);
+
+/**
+ * @brief Command table entry
+ */
+struct Command {
+    const char* name;
+    const char* usage;
+    CommandFunc fn;
+};
+
+static void cmdHelp(uint8_t argc, const char* const* argv);
+static void cmdPad(uint8_t argc, const char* const* argv);
+static void cmdCurve(uint8_t argc, const char* const* argv);
+static void cmdStats(uint8_t argc, const char* const* argv);
+static void cmdProf(uint8_t argc, const char* const* argv);
+static void cmdTrace(uint8_t argc, const char* const* argv);
+static void cmdStream(uint8_t argc, const char* const* argv);
+static void cmdCapture(uint8_t argc, const char* const* argv);
+static void cmdHealth(uint8_t argc, const char* const* argv);
+
+static const Command commands[] = {
+    { "help",    "",                          cmdHelp    },
+    { "pad",     "[<pad> thr|lim <n>]",       cmdPad     },
+    { "curve",   "<pad> lin|log|exp",         cmdCurve   },
+    { "stats",   "",                          cmdStats   },
+    { "prof",    "[reset]",                   cmdProf    },
+    { "trace",   "dump",                      cmdTrace   },
+    { "stream",  "on|off",                    cmdStream  },
+    { "capture", "on|off",                    cmdCapture },
+    { "health",  "[reset]",                   cmdHealth  },
+};
+
+static const char* const curveNames[] = { "lin", "log", "exp" }; // ForceMappingCurve order
+
+#define PAD_ALL Pad::PAD_NUM // parsePad() result for "all"
+
+/**
+ * @brief Construct a new Shell object
+ */
+Shell::Shell() :
+    _rx_tail(0),
+    _started(false),
+    _pending(false),
+    _commands(0),
+    _rx_restarts(0) {}
+
+/**
+ * @brief Start circular DMA reception on USART1
+ */
+void Shell::begin() {
+    _started = true;
+    _startRx();
+}
+
+/**
+ * @brief (Re)start circular DMA reception from the start of the ring
+ *
+ * The abort also stops a DMA stream left running by a HAL_UART_Init()
+ * (baud rate change), otherwise the restart would fail with HAL_BUSY.
+ */
+void Shell::_startRx() {
+    HAL_UART_AbortReceive(&huart1);
+    _rx_tail = 0;
+    _pending = false;
+    _parser.reset();
+    HAL_UART_Receive_DMA(&huart1, _rx_buf, SHELL_RX_BUF_SIZE);
+}
+
+/**
+ * @brief Parse received bytes and run a complete command (call in main loop)
+ * @param idle true if no hit is in flight
+ *
+ * Same ring handling as MidiIn::poll(). A complete line stops parsing, the
+ * parser keeps its words until the next byte is fed.
+ */
+void Shell::poll(bool idle) {
+    if (!_started) { return; }
+
+    // An UART error or a baud rate change (wave stream) ends the HAL reception, restart it
+    if (huart1.RxState == HAL_UART_STATE_READY) {
+        _rx_restarts++;
+        _startRx();
+    }
+
+    uint16_t head = SHELL_RX_BUF_SIZE - __HAL_DMA_GET_COUNTER(huart1.hdmarx);
+    if (head >= SHELL_RX_BUF_SIZE) { head = 0; } // Counter reload at wrap
+
+    uint16_t budget = SHELL_POLL_BUDGET;
+    while (!_pending && _rx_tail != head && budget > 0) {
+        _pending = _parser.feed(_rx_buf[_rx_tail]);
+        _rx_tail = (_rx_tail + 1) % SHELL_RX_BUF_SIZE;
+        budget--;
+    }
+
+    if (_pending && idle) {
+        _pending = false;
+        _execute(_parser.getArgc(), _parser.getArgv());
+    }
+}
+
+/**
+ * @brief Look up and run one command
+ * @param argc Word count
+ * @param argv Words, argv[0] is the command
+ */
+void Shell::_execute(uint8_t argc, const char* const* argv) {
+    _commands++;
+
+    for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if (ShellParser::match(argv[0], commands[i].name)) {
+            commands[i].fn(argc, argv);
+            return;
+        }
+    }
+    LOG_I("? %s (try help)", argv[0]);
+}
+
+/**
+ * @brief Print the usage of a command
+ * @param name Command name
+ */
+static void printUsage(const char* name) {
+    for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if (ShellParser::match(name, commands[i].name)) {
+            LOG_I("usage: %s %s", commands[i].name, commands[i].usage);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Parse a pad name, index or "all"
+ * @param word Word from the line
+ * @param out PadID, or PAD_ALL
+ * @return true if valid
+ */
+static bool parsePad(const char* word, uint8_t* out) {
+    uint16_t index;
+    if (ShellParser::match(word, "all")) {
+        *out = PAD_ALL;
+        return true;
+    }
+    if (ShellParser::toUInt16(word, &index)) {
+        if (index >= Pad::PAD_NUM) { return false; }
+        *out = (uint8_t)index;
+        return true;
+    }
+    for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+        if (ShellParser::match(word, Pad::ID2Str(static_cast<Pad::PadID>(i)))) {
+            *out = i;
+            return true;
+        }
+    }
+    LOG_I("unknown pad %s", word);
+    return false;
+}
+
+/**
+ * @brief Parse "on" / "off"
+ * @param word Word from the line
+ * @param out Result
+ * @return true if valid
+ */
+static bool parseOnOff(const char* word, bool* out) {
+    if (ShellParser::match(word, "on")) { *out = true; return true; }
+    if (ShellParser::match(word, "off")) { *out = false; return true; }
+    return false;
+}
+
+/**
+ * @brief Print the settings of one pad
+ * @param id PadID
+ */
+static void showPad(uint8_t id) {
+    Pad* pad = pads[id];
+    LOG_I("%u %-8s thr:%u lim:%u curve:%s", id, Pad::ID2Str(pad->getID()),
+          pad->getHitThreshold(), pad->getUpperLimit(), curveNames[pad->getForceCurve()]);
+}
+
+static void cmdHelp(uint8_t argc, const char* const* argv) {
+    (void)argc;
+    (void)argv;
+    for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        LOG_I("  %-8s%s", commands[i].name, commands[i].usage);
+    }
+}
+
+/**
+ * @brief pad [<pad> [thr|lim <n>]]
+ *
+ * The threshold must stay below the upper limit (the force mapping divides
+ * by their difference), a value breaking that on any selected pad is refused.
+ */
+static void cmdPad(uint8_t argc, const char* const* argv) {
+    uint8_t id = PAD_ALL;
+    if (argc >= 2 && !parsePad(argv[1], &id)) { return; }
+
+    uint8_t first = (id == PAD_ALL) ? 0 : id;
+    uint8_t last = (id == PAD_ALL) ? Pad::PAD_NUM - 1 : id;
+
+    if (argc <= 2) {
+        for (uint8_t i = first; i <= last; i++) { showPad(i); }
+        return;
+    }
+
+    uint16_t value;
+    bool thr = ShellParser::match(argv[2], "thr");
+    bool lim = ShellParser::match(argv[2], "lim");
+    if (argc != 4 || (!thr && !lim) || !ShellParser::toUInt16(argv[3], &value)) {
+        printUsage(argv[0]);
+        return;
+    }
+
+    for (uint8_t i = first; i <= last; i++) {
+        uint16_t t = thr ? value : pads[i]->getHitThreshold();
+        uint16_t l = lim ? value : pads[i]->getUpperLimit();
+        if (l > 4095 || t >= l) {
+            LOG_I("%s: need thr < lim <= 4095", Pad::ID2Str(static_cast<Pad::PadID>(i)));
+            return;
+        }
+    }
+
+    for (uint8_t i = first; i <= last; i++) {
+        thr ? pads[i]->setHitThreshold(value) : pads[i]->setUpperLimit(value);
+        showPad(i);
+    }
+}
+
+/**
+ * @brief curve <pad> lin|log|exp
+ */
+static void cmdCurve(uint8_t argc, const char* const* argv) {
+    uint8_t id;
+    if (argc != 3) {
+        printUsage(argv[0]);
+        return;
+    }
+    if (!parsePad(argv[1], &id)) { return; }
+
+    for (uint8_t c = 0; c < sizeof(curveNames) / sizeof(curveNames[0]); c++) {
+        if (!ShellParser::match(argv[2], curveNames[c])) { continue; }
+
+        uint8_t first = (id == PAD_ALL) ? 0 : id;
+        uint8_t last = (id == PAD_ALL) ? Pad::PAD_NUM - 1 : id;
+        for (uint8_t i = first; i <= last; i++) {
+            pads[i]->setForceCurve(static_cast<Pad::ForceMappingCurve>(c));
+            showPad(i);
+        }
+        return;
+    }
+    printUsage(argv[0]);
+}
+
+/**
+ * @brief stats: scheduler tasks, then log/trace, MIDI, hit and display counters
+ */
+static void cmdStats(uint8_t argc, const char* const* argv) {
+    (void)argc;
+    (void)argv;
+    scheduler.dumpStats();
+    LOG_I("Log written:%lu dropped:%lu txerr:%lu  trace rec:%lu dropped:%lu",
+          logger.getWritten(), logger.getDropped(), logger.getTxErrors(),
+          tracer.getRecords(), tracer.getDropped());
+
+    const Midi::TxStats& tx = midi.getTxStats();
+    LOG_I("MIDI on:%lu off:%lu timeout:%lu err:%lu held:%u util peak:%u%%  in:%lu err:%lu",
+          tx.note_on, tx.note_off, tx.timeouts, tx.tx_errors,
+          midi.getHeldCount(), midi.getLinkUtilizationPeak(),
+          midiIn.getRxBytes(), midiIn.getRxErrors());
+    LOG_I("Hits recorded:%lu  captures sent:%lu dropped:%lu",
+          hitRecorder.getTotal(), hitCapture.getSent(), hitCapture.getDropped());
+    LOG_I("OLED %u fps%s cost:%luus frames:%lu settled:%lu bus waits:%lu  bus jobs:%lu merged:%lu dropped:%lu",
+          ui.getFrameRate(), ui.isPlaying() ? " (playing)" : "", ui.getFrameCostUs(), ui.getFrames(),
+          ui.getSettledSkips(), ui.getBusSkips(), oledBus.getJobs(), oledBus.getMerged(), oledBus.getDropped());
+}
+
+/**
+ * @brief prof [reset]
+ */
+static void cmdProf(uint8_t argc, const char* const* argv) {
+    if (argc >= 2 && ShellParser::match(argv[1], "reset")) {
+        profiler.reset();
+        scheduler.resetStats();
+        LOG_I("profiler reset");
+        return;
+    }
+    profiler.dumpStats();
+}
+
+/**
+ * @brief trace dump
+ */
+static void cmdTrace(uint8_t argc, const char* const* argv) {
+    if (argc == 2 && ShellParser::match(argv[1], "dump")) {
+        hitRecorder.requestDump();
+        return;
+    }
+    printUsage(argv[0]);
+}
+
+/**
+ * @brief stream on|off (the reply is muted once the stream has started)
+ */
+static void cmdStream(uint8_t argc, const char* const* argv) {
+    bool on;
+    if (argc != 2 || !parseOnOff(argv[1], &on)) {
+        printUsage(argv[0]);
+        return;
+    }
+    if (on) { LOG_I("wave stream on, switch to %lu baud", (uint32_t)WAVE_STREAM_BAUD); }
+    waveStream.setEnabled(on);
+}
+
+/**
+ * @brief capture on|off
+ */
+static void cmdCapture(uint8_t argc, const char* const* argv) {
+    bool on;
+    if (argc != 2 || !parseOnOff(argv[1], &on)) {
+        printUsage(argv[0]);
+        return;
+    }
+    hitCapture.setEnabled(on);
+    LOG_I("hit capture %s", on ? "on" : "off");
+}
+
+/**
+ * @brief health [reset]
+ */
+static void cmdHealth(uint8_t argc, const char* const* argv) {
+    if (argc >= 2 && ShellParser::match(argv[1], "reset")) {
+        health.reset();
+        LOG_I("health counters reset");
+        return;
+    }
+    health.dump();
+}
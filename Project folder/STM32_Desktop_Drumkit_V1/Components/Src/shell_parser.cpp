@@ -0,0 +1,140 @@
+/**
+ * @file shell_parser.cpp
+ * @brief Incremental line parser for the serial command shell
+ *
+ * This file implements the ShellParser class (see shell_parser.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "shell_parser.h"
+#include "string.h"
+
+/**
+ * @brief Construct a new ShellParser object
+ */
+ShellParser::ShellParser() {
+    memset(&_stats, 0, sizeof(_stats));
+    reset();
+}
+
+/**
+ * @brief Drop the partial line
+ */
+void ShellParser::reset() {
+    _len = 0;
+    _overflow = false;
+    _split = false;
+    _argc = 0;
+}
+
+/**
+ * @brief Parse one byte
+ * @param byte Received byte
+ * @return true if a line is complete
+ *
+ * - CR / LF: ends the line (an empty line, e.g. the LF of CR LF, is skipped)
+ * - BS / DEL: removes the last byte
+ * - Printable ASCII: appended, TAB counts as a space
+ */
+bool ShellParser::feed(uint8_t byte) {
+    if (_split) { // Words of the previous line are no longer needed
+        _len = 0;
+        _argc = 0;
+        _split = false;
+    }
+
+    if (byte == '\r' || byte == '\n') {
+        return _endLine();
+    }
+
+    if (byte == 0x08 || byte == 0x7F) {
+        if (_len > 0 && !_overflow) { _len--; }
+        return false;
+    }
+
+    if (byte == '\t') { byte = ' '; }
+    if (byte < 0x20 || byte > 0x7E) {
+        _stats.ignored++;
+        return false;
+    }
+
+    if (_overflow) { return false; }
+    if (_len >= SHELL_LINE_MAX) {
+        _overflow = true;
+        return false;
+    }
+
+    _line[_len++] = (char)byte;
+    return false;
+}
+
+/**
+ * @brief Split the collected line into words
+ * @return true if the line has at least one word
+ */
+bool ShellParser::_endLine() {
+    if (_overflow) {
+        _stats.overflow++;
+        reset();
+        return false;
+    }
+
+    _line[_len] = '\0';
+    _argc = 0;
+    char* p = _line;
+
+    while (*p && _argc < SHELL_ARGS_MAX) {
+        while (*p == ' ') { p++; }
+        if (!*p) { break; }
+        _argv[_argc++] = p;
+        while (*p && *p != ' ') { p++; }
+        if (*p) { *p++ = '\0'; }
+    }
+
+    _split = true;
+    if (_argc == 0) { return false; }
+
+    _stats.lines++;
+    return true;
+}
+
+/**
+ * @brief Compare a word with a keyword, ignoring case
+ * @param word Word from the line
+ * @param keyword Keyword
+ * @return true if equal
+ */
+bool ShellParser::match(const char* word, const char* keyword) {
+    while (*word && *keyword) {
+        char a = *word++;
+        char b = *keyword++;
+        if (a >= 'A' && a <= 'Z') { a += 'a' - 'A'; }
+        if (b >= 'A' && b <= 'Z') { b += 'a' - 'A'; }
+        if (a != b) { return false; }
+    }
+    return *word == *keyword;
+}
+
+/**
+ * @brief Parse an unsigned decimal number
+ * @param word Word from the line
+ * @param out Result (untouched on error)
+ * @return true if the whole word is a number up to 65535
+ */
+bool ShellParser::toUInt16(const char* word, uint16_t* out) {
+    uint32_t value = 0;
+    if (!*word) { return false; }
+
+    while (*word) {
+        if (*word < '0' || *word > '9') { return false; }
+        value = value * 10 + (uint32_t)(*word++ - '0');
+        if (value > 0xFFFF) { return false; }
+    }
+
+    *out = (uint16_t)value;
+    return true;
+}
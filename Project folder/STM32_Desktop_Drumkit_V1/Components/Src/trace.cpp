@@ -0,0 +1,104 @@
+/**
+ * @file trace.cpp
+ * @brief Binary deferred-formatting trace on the debug UART
+ *
+ * This file implements the Tracer record encoder (see trace.h for the
+ * wire format).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "trace.h"
+#include "dwt.h"
+
+Tracer tracer; // Global tracer instance
+
+/**
+ * @brief Construct a new Tracer object
+ */
+Tracer::Tracer() :
+    _last_cycles(0),
+    _since_abs(0),
+    _resync(true),
+    _records(0),
+    _dropped(0) {}
+
+/**
+ * @brief Append a LEB128 varint
+ * @param p Write position
+ * @param value Value
+ * @return uint8_t* Position after the varint
+ */
+static inline uint8_t* putVarint(uint8_t* p, uint32_t value) {
+    while (value >= 0x80) {
+        *p++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (uint8_t)value;
+    return p;
+}
+
+/**
+ * @brief Encode one record and queue it in the logger ring
+ * @param level LOG_LVL_ERROR ... LOG_LVL_DEBUG
+ * @param id Format string offset in trace_fmt
+ * @param argv Arguments
+ * @param argc Argument count
+ */
+void Tracer::_emit(uint8_t level, uint16_t id, const uint32_t* argv, uint8_t argc) {
+    uint8_t rec[TRACE_RECORD_MAX];
+    uint8_t* p = rec + 1;
+    uint32_t now = DWT_GetCycles();
+    bool absolute = _resync || _since_abs >= TRACE_ABS_EVERY;
+
+    rec[0] = 0x80 | (absolute ? 0x40 : 0x00) | (uint8_t)((level - 1) << 4) | argc;
+    *p++ = (uint8_t)id;
+    *p++ = (uint8_t)(id >> 8);
+
+    if (absolute) {
+        *p++ = (uint8_t)now;
+        *p++ = (uint8_t)(now >> 8);
+        *p++ = (uint8_t)(now >> 16);
+        *p++ = (uint8_t)(now >> 24);
+    } else {
+        p = putVarint(p, now - _last_cycles);
+    }
+
+    for (uint8_t i = 0; i < argc; i++) {
+        p = putVarint(p, argv[i]);
+    }
+
+    if (!logger.writeRaw(rec, (uint16_t)(p - rec))) {
+        _dropped++;
+        _resync = true; // Host lost the delta chain
+        return;
+    }
+
+    _records++;
+    _last_cycles = now;
+    _resync = false;
+    _since_abs = absolute ? 0 : _since_abs + 1;
+}
+
+/**
+ * @brief Queue a binary block as a whole
+ * @param type TRACE_BLOCK_x
+ * @param payload Payload
+ * @param len Payload length
+ * @return true if queued, false if the ring has no room or the log is muted
+ *
+ * Room for header and payload is checked first; the producer is the only
+ * one taking space, so the two writes cannot be split by a drop.
+ */
+bool Tracer::writeBlock(uint8_t type, const uint8_t* payload, uint16_t len) {
+    if (logger.getLevel() == LOG_LVL_NONE) { return false; }
+    if (logger.getFree() < 4 + len) { return false; }
+
+    uint8_t header[4] = { TRACE_BLOCK_TAG, type, (uint8_t)len, (uint8_t)(len >> 8) };
+    logger.writeRaw(header, sizeof(header));
+    logger.writeRaw(payload, len);
+    return true;
+}
@@ -12,6 +12,14 @@
  */
 
 #include "ui.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "logger.h"
+#include "wavestream.h"
+#include "hitrec.h"
+#include "hitcapture.h"
+#include "health.h"
+#include "oled_bus.h"
 
 UI ui; // Global UI instance
 
@@ -25,7 +33,6 @@ UI ui; // Global UI instance
 void Callback_HomeMenuItem() {
     ui.setMode(UI::DisplayMode::PAGE);
     ui.setPage(UI::Page::MAIN);
-    ui._oled.clear();
 }
 
 /**
@@ -36,7 +43,6 @@ void Callback_HomeMenuItem() {
 void Callback_PadTestMenuItem() {
     ui.setMode(UI::DisplayMode::PAGE);
     ui.setPage(UI::Page::PAD_TEST);
-    ui._oled.clear();
 }
 
 /**
@@ -47,18 +53,49 @@ void Callback_PadTestMenuItem() {
 void Callback_PadSettingMenuItem() {
     ui.setMode(UI::DisplayMode::PAGE);
     ui.setPage(UI::Page::PAD_SETTING);
-    ui._oled.clear();
 }
 
 /**
  * @brief Callback for Statistics menu item
  * 
- * Switches to STATS page display mode
+ * Switches to STATS page display mode and dumps MIDI statistics to the debug UART
  */
 void Callback_StatsMenuItem() {
     ui.setMode(UI::DisplayMode::PAGE);
     ui.setPage(UI::Page::STATS);
-    ui._oled.clear();
+    midi.dumpStats();
+    scheduler.dumpStats();
+}
+
+/**
+ * @brief Callback for Profiler menu item
+ * 
+ * Switches to PROFILER page display mode and dumps the profiler to the debug UART
+ */
+void Callback_ProfilerMenuItem() {
+    ui.setMode(UI::DisplayMode::PAGE);
+    ui.setPage(UI::Page::PROFILER);
+    profiler.dumpStats();
+}
+
+/**
+ * @brief Callback for Health menu item
+ * 
+ * Switches to HEALTH page display mode and dumps the health counters to the debug UART
+ */
+void Callback_HealthMenuItem() {
+    ui.setMode(UI::DisplayMode::PAGE);
+    ui.setPage(UI::Page::HEALTH);
+    health.dump();
+}
+
+/**
+ * @brief Callback for Reset Map menu item
+ * 
+ * Drops all per-pad overrides of the active note map
+ */
+void Callback_ResetNoteMap() {
+    midi.resetNoteMap(midi.getNoteMapPreset());
 }
 
 /**
@@ -68,6 +105,7 @@ void Callback_StatsMenuItem() {
  */
 void Callback_PWROFF() {
     ui._oled.clear();
+    ui._oled.flush();
     ui._oled.power(false);
     for (uint8_t i = 0; i < 10; i++) {
         HAL_GPIO_TogglePin(LED_GPIO_Port, LED_Pin);
@@ -82,7 +120,7 @@ void Callback_PWROFF() {
 void Callback_ButtonSingleClick() {
     if (ui.getMode() == UI::DisplayMode::MENU) {
         Menu_MoveRight();
-        DBG("Menu Right.\r\n");
+        LOG_D("Menu Right.");
     }
 }
 
@@ -90,17 +128,20 @@ void Callback_ButtonSingleClick() {
 void Callback_ButtonDoubleClick() {
     if (ui.getMode() == UI::DisplayMode::MENU) {
         Menu_MoveLeft();
-        DBG("Menu Left.\r\n");
+        LOG_D("Menu Left.");
     }
 }
 
-// Multi click callback - handle menu go back
+// Multi click callback - handle menu go back, dump the hit recorder on a page
 void Callback_ButtonMultiClick() {
     if (ui.getMode() == UI::DisplayMode::MENU) {
         if (!Menu_GoBack()) {
             Callback_HomeMenuItem();
         }
-        DBG("Menu Go Back.\r\n");
+        LOG_D("Menu Go Back.");
+    } else {
+        hitRecorder.requestDump();
+        LOG_D("Hit recorder dump.");
     }
 }
 
@@ -109,14 +150,14 @@ void Callback_ButtonLongPressStart() {
     if (!ui.chkPower()) {
         HAL_GPIO_WritePin(PWR_EN_GPIO_Port, PWR_EN_Pin, GPIO_PIN_SET); // Power on
         ui.setPower(true);
-        DBG("Power has set.\r\n");
+        LOG_I("Power has set.");
     } else {
         if (ui.getMode() == UI::DisplayMode::PAGE) {
             ui.setMode(UI::DisplayMode::MENU);
-            DBG("Page -> Menu.\r\n");
+            LOG_D("Page -> Menu.");
         } else {
             Menu_Confirm();
-            DBG("Menu Confirm.\r\n");
+            LOG_D("Menu Confirm.");
         }
     }
 }
@@ -126,16 +167,42 @@ void Callback_ButtonLongPressStart() {
 UI::UI() :
     _isPowerOn(false),
     _midiConnected(false),
-    _ledEffectsEnabled(false),
-    _buzzerEnabled(true),
-    _debugLogEnabled(false),
+    _ledEffectsEnabled(0),
+    _buzzerEnabled(1),
+    _debugLogEnabled(0),
+    _waveStreamEnabled(0),
+    _hitCaptureEnabled(0),
+    _waveStreamSynced(0),
+    _hitCaptureSynced(0),
     _mode(DisplayMode::PAGE),
     _prevMode(DisplayMode::PAGE),
     _page(Page::MAIN),
+    _step(Step::IDLE),
+    _slice(0),
+    _frameInterval(1000 / UI_PAGE_FPS),
+    _playing(false),
+    _frameForced(true),
+    _windowHits(0),
+    _windowStart(0),
+    _playingTick(0),
+    _lastFrame(0),
+    _frameCycles(0),
+    _frameCostUs(0),
+    _frames(0),
+    _busSkips(0),
+    _settledSkips(0),
+    _lastMenuDraw(0),
     _pads(nullptr),
     _totalHitsAll(0),
-    _totalDataSent(0),
-    _selectedPadID(0) {
+    _selectedPadID(0),
+    _mapPreset(Midi::MAP_GM),
+    _mapEditPad(0),
+    _mapEditNote(0),
+    _mapEditChannel(MIDI_CHANNEL_ID),
+    _mapSyncedPreset(Midi::MAP_GM),
+    _mapSyncedPad(0),
+    _mapSyncedNote(0),
+    _mapSyncedChannel(MIDI_CHANNEL_ID) {
     memset(_totalHits, 0, sizeof(_totalHits));
 }
 
@@ -148,18 +215,10 @@ void UI::updatePadStats(Pad::PadID padID, uint32_t hits) {
     if (padID < Pad::PAD_NUM) {
         _totalHits[padID] += hits;
         _totalHitsAll += hits;
+        _windowHits += hits;
     }
 }
 
-/**
- * @brief Update MIDI statistics
- * 
- * Increments total MIDI data sent counter
- */
-void UI::updateMidiStats() {
-    _totalDataSent += 5;
-}
-
 /**
  * @brief Update MIDI connection status
  * @param connected true if connected, false otherwise
@@ -213,6 +272,7 @@ void UI::init() {
 
     // Create menu items
     _initMenuPointers();
+    _createMidiMapMenu();
     _createSettingsMenu();
     _createAboutMenu();
     _createMainMenu();
@@ -223,57 +283,219 @@ void UI::init() {
 }
 
 /**
- * @brief Update display
+ * @brief Update display (one slice)
+ * @return true if the current refresh is not finished yet
+ * 
+ * A refresh is split into slices of at most one display page (8 px line):
+ * - Mode change to PAGE: clear the frame buffer (not the screen) and render the page
+ *   right away, the menu library and the OLED class share the buffer, so only
+ *   the columns that differ from the menu are sent
+ * - MENU mode: draw the menu into the frame buffer, then send it one page per slice.
+ *   Once the transitions have settled and no button was pressed, a due frame
+ *   is only drawn every UI_MENU_SETTLED_MS. A menu change dissolves the old
+ *   menu over the next UI_SWITCH_FRAMES frames, nothing in here waits
+ * - PAGE mode: render the page one text line per slice,
+ *   the OLED class sends only the changed columns of that line
  * 
- * Handles button input and refreshes display based on current mode
+ * How often a frame starts is up to the frame rate governor (_frameDue()).
+ * The CPU time of all slices of a frame is its cost.
+ * 
+ * Button input is no longer handled here, see buttonTick().
  */
-void UI::update() {
-    if (!_isPowerOn) return;
-    buttonTick();
-    _show();
+bool UI::update() {
+    if (!_isPowerOn) {
+        _step = Step::IDLE;
+        return false;
+    }
+
+    PROF_SCOPE(UI_SHOW);
+
+    uint32_t start = DWT_GetCycles();
+    Step before = _step;
+    bool pending = _updateSlice();
+
+    if (pending || before != Step::IDLE) { // A slice of a frame, not an idle check
+        _frameCycles += DWT_GetCycles() - start;
+        if (!pending) {
+            _frameCostUs = DWT_CyclesToUs(_frameCycles);
+            _frameCycles = 0;
+        }
+    }
+    return pending;
 }
 
-void UI::_show() {
+/**
+ * @brief Frame rate governor: check whether the next frame may start
+ * @return true if a frame is due and the OLED bus has sent the last one
+ * 
+ * The interval follows the display mode (UI_MENU_FPS / UI_PAGE_FPS), the
+ * lower UI_PLAYING_x_FPS rates while the pads are played, and is stretched
+ * further if the last frame cost more than UI_CPU_BUDGET_PCT of it. A due
+ * frame waits while the bus is still sending, frames never pile up.
+ */
+bool UI::_frameDue() {
+    uint32_t now = HAL_GetTick();
+    _updateFrameRate(now);
+
+    // One tick of slack: the UI task releases are DWT timed, their tick distance jitters by one
+    if (!_frameForced && now - _lastFrame + 1 < _frameInterval) { return false; }
+    if (!oledBus.isIdle()) {
+        _busSkips++;
+        return false;
+    }
 
-    // Clear screen when display mode changes
-    if (_mode != _prevMode) {
-        _oled.clear();
-        _prevMode = _mode;
+    _frameForced = false;
+    _lastFrame = now;
+    return true;
+}
+
+/**
+ * @brief Measure the hit rate and set the frame interval
+ * @param now HAL tick
+ */
+void UI::_updateFrameRate(uint32_t now) {
+    uint32_t elapsed = now - _windowStart;
+    if (elapsed >= UI_HIT_WINDOW_MS) {
+        uint32_t rate = _windowHits * 1000UL / elapsed;
+        _windowHits = 0;
+        _windowStart = now;
+
+        if (rate >= UI_PLAYING_HIT_RATE) {
+            if (!_playing) { LOG_D("UI: %lu hits/s, display rate lowered", rate); }
+            _playing = true;
+            _playingTick = now;
+        }
+    }
+    if (_playing && now - _playingTick > UI_PLAYING_HOLD_MS) {
+        _playing = false;
+        LOG_D("UI: idle, display rate restored");
     }
 
-    // Show different content based on mode
+    uint8_t fps;
     if (_mode == DisplayMode::MENU) {
-        OLEDUI_Update();
-		OLEDUI_Move();
-		OLEDUI_Show();
-    } else if (_mode == DisplayMode::PAGE) {
-        static uint32_t lastUpdateTime = 0;
-        if (HAL_GetTick() - lastUpdateTime > 500) {
-            lastUpdateTime = HAL_GetTick();
-            switch (_page) {
-                case Page::MAIN:
-                    _showMainPage();
-                    break;
-                case Page::PAD_TEST:
-                    _showPadTestPage();
-                    break;
-                case Page::PAD_SETTING:
-                    _showPadSettingPage();
-                    break;
-                case Page::STATS:
-                    _showStatsPage();
-                    break;
+        fps = _playing ? UI_PLAYING_MENU_FPS : UI_MENU_FPS;
+    } else {
+        fps = _playing ? UI_PLAYING_PAGE_FPS : UI_PAGE_FPS;
+    }
+
+    uint32_t interval = 1000 / fps;
+    uint32_t budgetInterval = _frameCostUs / (10 * UI_CPU_BUDGET_PCT); // cost / (pct / 100), us -> ms
+    _frameInterval = (uint16_t)((budgetInterval > interval) ? budgetInterval : interval);
+}
+
+/**
+ * @brief Run one slice of the refresh state machine
+ * @return true if the current refresh is not finished yet
+ */
+bool UI::_updateSlice() {
+    switch (_step) {
+        case Step::IDLE:
+            // The menu draws a full frame anyway, a page starts from an empty buffer
+            if (_mode != _prevMode) {
+                _prevMode = _mode;
+                if (_mode == DisplayMode::PAGE) { _oled.clear(); }
+                else { menuRedrawFlag = 1; } // The page overwrote the buffer
+                _frameForced = true; // Show the new mode right away
+            }
+
+            if (!_frameDue()) { return false; }
+
+            if (_mode == DisplayMode::MENU) {
+                _syncNoteMap();
+                _syncSwitches();
+                if (!waveStream.isActive()) {
+                    logger.setLevel(_debugLogEnabled ? LOG_LVL_DEBUG : LOG_LVL_INFO);
+                }
+                OLEDUI_Update();
+                bool moving = OLEDUI_Move();
+
+                // A settled menu without input looks like the last frame, only values
+                // changed elsewhere (shell, MIDI) need the slow periodic redraw
+                uint32_t now = HAL_GetTick();
+                if (!moving && !menuRedrawFlag && now - _lastMenuDraw < UI_MENU_SETTLED_MS) {
+                    _settledSkips++;
+                    return false;
+                }
+                _lastMenuDraw = now;
+
+                OLEDUI_Draw();
+                _step = Step::FLUSH;
+            } else {
+                _step = Step::RENDER;
             }
+            _frames++;
+            _slice = 0;
+            return true;
+
+        case Step::RENDER:
+            _showPageLine(_slice);
+            _oled.flush(); // Only the bytes of this line that changed
+            break;
+
+        case Step::FLUSH: {
+            PROF_SCOPE(OLED_FLUSH);
+            OLED_ShowFramePage(_slice);
+            break;
         }
     }
+
+    if (++_slice < UI_PAGE_LINES) { return true; }
+
+    _step = Step::IDLE;
+    _slice = 0;
+    return false;
 }
 
+/**
+ * @brief Sync note map editor values with the MIDI handler
+ * 
+ * Values changed from the menu (different from the last sync) are clamped
+ * and written to the active map. Afterwards the editor is reloaded from the
+ * MIDI handler, so changes made elsewhere (SysEx, reset) show up as well.
+ */
+void UI::_syncNoteMap() {
+    _mapEditPad = (_mapEditPad < 0) ? 0 : ((_mapEditPad >= Pad::PAD_NUM) ? Pad::PAD_NUM - 1 : _mapEditPad);
+    Pad::PadID pad = static_cast<Pad::PadID>(_mapEditPad);
+
+    if (_mapPreset != _mapSyncedPreset) {
+        _mapPreset = (_mapPreset < 0) ? 0 : ((_mapPreset >= MIDI_NOTE_MAP_PRESET_NUM) ? MIDI_NOTE_MAP_PRESET_NUM - 1 : _mapPreset);
+        midi.selectNoteMap(static_cast<Midi::NoteMapPreset>(_mapPreset));
+    }
+
+    if (_mapEditPad == _mapSyncedPad) {
+        if (_mapEditNote != _mapSyncedNote) {
+            midi.setPadNote(pad, (_mapEditNote < 0) ? 0 : ((_mapEditNote > 127) ? 127 : _mapEditNote));
+        }
+        if (_mapEditChannel != _mapSyncedChannel) {
+            midi.setPadChannel(pad, (_mapEditChannel < 1) ? 1 : ((_mapEditChannel > 16) ? 16 : _mapEditChannel));
+        }
+    }
+
+    _mapPreset = _mapSyncedPreset = midi.getNoteMapPreset();
+    _mapSyncedPad = _mapEditPad;
+    _mapEditNote = _mapSyncedNote = midi.getPadNote(pad);
+    _mapEditChannel = _mapSyncedChannel = midi.getPadChannel(pad);
+}
+
+/**
+ * @brief Two-way sync of the Wave Stream / Hit Capture switches
+ *
+ * A switch toggled in the menu is applied, otherwise it follows the module,
+ * which the serial shell may have switched.
+ */
+void UI::_syncSwitches() {
+    if (_waveStreamEnabled != _waveStreamSynced) { waveStream.setEnabled(_waveStreamEnabled); }
+    if (_hitCaptureEnabled != _hitCaptureSynced) { hitCapture.setEnabled(_hitCaptureEnabled); }
+    _waveStreamEnabled = _waveStreamSynced = waveStream.isEnabled();
+    _hitCaptureEnabled = _hitCaptureSynced = hitCapture.isEnabled();
+}
 
 // Below are menu creation and page display helper functions
 
 void UI::_initMenuPointers() {
     _mainMenu = AddMenu("Main Menu", NULL, 0, NULL);
     _settingsMenu = AddMenu("Settings", NULL, 0, _mainMenu);
+    _midiMapMenu = AddMenu("MIDI Map", NULL, 0, _settingsMenu);
     _aboutMenu = AddMenu("About", NULL, 0, _mainMenu);
 }
 
@@ -282,15 +504,28 @@ void UI::_createMainMenu() {
     AddMenuItem(_mainMenu, "2 Settings", FunctionForNextMenu, _settingsMenu, NONE_CTRL, NULL);
     AddMenuItem(_mainMenu, "3 Pad Test", Callback_PadTestMenuItem, NULL, NONE_CTRL, NULL);
     AddMenuItem(_mainMenu, "4 Statistics", Callback_StatsMenuItem, NULL, NONE_CTRL, NULL);
-    AddMenuItem(_mainMenu, "5 About", FunctionForNextMenu, _aboutMenu, NONE_CTRL, NULL);
+    AddMenuItem(_mainMenu, "5 Profiler", Callback_ProfilerMenuItem, NULL, NONE_CTRL, NULL);
+    AddMenuItem(_mainMenu, "6 Health", Callback_HealthMenuItem, NULL, NONE_CTRL, NULL);
+    AddMenuItem(_mainMenu, "7 About", FunctionForNextMenu, _aboutMenu, NONE_CTRL, NULL);
     AddMenuItem(_mainMenu, "> POWER OFF!", Callback_PWROFF, NULL, NONE_CTRL, NULL);
 }
 
 void UI::_createSettingsMenu() {
     AddMenuItem(_settingsMenu, "1 Pad Settings", Callback_PadSettingMenuItem, NULL, NONE_CTRL, NULL);
-    AddMenuItem(_settingsMenu, "2 LED Effects(NA", FunctionForCtrl, NULL, SWITCH_CTRL, (int*)&_ledEffectsEnabled);
-    AddMenuItem(_settingsMenu, "3 Buzzer", FunctionForCtrl, NULL, SWITCH_CTRL, (int*)&_buzzerEnabled);
-    AddMenuItem(_settingsMenu, "4 Debug Log", FunctionForCtrl, NULL, SWITCH_CTRL, (int*)&_debugLogEnabled);
+    AddMenuItem(_settingsMenu, "2 LED Effects(NA", FunctionForCtrl, NULL, SWITCH_CTRL, &_ledEffectsEnabled);
+    AddMenuItem(_settingsMenu, "3 Buzzer", FunctionForCtrl, NULL, SWITCH_CTRL, &_buzzerEnabled);
+    AddMenuItem(_settingsMenu, "4 Debug Log", FunctionForCtrl, NULL, SWITCH_CTRL, &_debugLogEnabled);
+    AddMenuItem(_settingsMenu, "5 MIDI Map", FunctionForNextMenu, _midiMapMenu, NONE_CTRL, NULL);
+    AddMenuItem(_settingsMenu, "6 Wave Stream", FunctionForCtrl, NULL, SWITCH_CTRL, &_waveStreamEnabled);
+    AddMenuItem(_settingsMenu, "7 Hit Capture", FunctionForCtrl, NULL, SWITCH_CTRL, &_hitCaptureEnabled);
+}
+
+void UI::_createMidiMapMenu() {
+    AddMenuItem(_midiMapMenu, "1 Preset(GM/VST/Mod", FunctionForCtrl, NULL, SLIDER_CTRL, &_mapPreset);
+    AddMenuItem(_midiMapMenu, "2 Edit Pad", FunctionForCtrl, NULL, SLIDER_CTRL, &_mapEditPad);
+    AddMenuItem(_midiMapMenu, "3 Note", FunctionForCtrl, NULL, SLIDER_CTRL, &_mapEditNote);
+    AddMenuItem(_midiMapMenu, "4 Channel", FunctionForCtrl, NULL, SLIDER_CTRL, &_mapEditChannel);
+    AddMenuItem(_midiMapMenu, "5 Reset Preset", Callback_ResetNoteMap, NULL, NONE_CTRL, NULL);
 }
 
 void UI::_createAboutMenu() {
@@ -419,92 +654,218 @@ void UI::welcome() {
     _oled.printText(0, 1, "> Initializing...", 8);
     _oled.printText(36, 2, "WELCOME!", 16);
     // _oled.printImage(0, 0, 40, 32, _oled.ST);
+    _oled.flush();
     HAL_Delay(2000);
     _oled.clear();
+    _oled.flush();
 }
 
-void UI::_showMainPage() {
+/**
+ * @brief Render one text line of the current page
+ * @param line Display page (0 ~ UI_PAGE_LINES-1)
+ */
+void UI::_showPageLine(uint8_t line) {
+    switch (_page) {
+        case Page::MAIN:
+            _showMainPage(line);
+            break;
+        case Page::PAD_TEST:
+            _showPadTestPage(line);
+            break;
+        case Page::PAD_SETTING:
+            _showPadSettingPage(line);
+            break;
+        case Page::STATS:
+            _showStatsPage(line);
+            break;
+        case Page::PROFILER:
+            _showProfilerPage(line);
+            break;
+        case Page::HEALTH:
+            _showHealthPage(line);
+            break;
+    }
+}
+
+void UI::_showMainPage(uint8_t line) {
     static uint8_t currentInfo = 4;
     static uint32_t lastSwitchTime = 0;
     static bool shouldUpdate = true;
-    
-    // 每2秒切换到下一个信息
-    if (HAL_GetTick() - lastSwitchTime > 3000) {
-        currentInfo = (currentInfo + 1) % 5;
-        lastSwitchTime = HAL_GetTick();
-        shouldUpdate = true;
-    }
-
-    _oled.printText(0, 0, "> Home               ", 8);
-    _oled.printText(0, 1, "MIDI: ", 8);
-    _oled.printText(36, 1, _midiConnected ? "READY!        " : "Disconnected  ", 8);
 
-    if (!shouldUpdate) return;
+    static const char* const helpText[5][2] = {
+        { "Short press:         ", "Next item in menu    " },
+        { "Double press:        ", "Previous item in menu" },
+        { "Triple press:        ", "Go back in menu      " },
+        { "Long press 1 sec:    ", "Go to menu or Confirm" },
+        { "Long press 3 sec:    ", "Power on/off         " }
+    };
 
-    switch (currentInfo) {
+    switch (line) {
         case 0:
-            _oled.printText(0, 2, "Short press:         ", 8);
-            _oled.printText(0, 3, "Next item in menu    ", 8);
+            // 每3秒切换到下一个信息
+            if (HAL_GetTick() - lastSwitchTime > 3000) {
+                currentInfo = (currentInfo + 1) % 5;
+                lastSwitchTime = HAL_GetTick();
+                shouldUpdate = true;
+            }
+            _oled.printText(0, 0, "> Home               ", 8);
             break;
         case 1:
-            _oled.printText(0, 2, "Double press:        ", 8);
-            _oled.printText(0, 3, "Previous item in menu", 8);
+            _oled.printText(0, 1, "MIDI: ", 8);
+            _oled.printText(36, 1, _midiConnected ? "READY!        " : "Disconnected  ", 8);
             break;
         case 2:
-            _oled.printText(0, 2, "Triple press:        ", 8);
-            _oled.printText(0, 3, "Go back in menu      ", 8);
+            if (shouldUpdate) { _oled.printText(0, 2, helpText[currentInfo][0], 8); }
             break;
         case 3:
-            _oled.printText(0, 2, "Long press 1 sec:    ", 8);
-            _oled.printText(0, 3, "Go to menu or Confirm", 8);
+            if (shouldUpdate) { _oled.printText(0, 3, helpText[currentInfo][1], 8); }
+            shouldUpdate = false;
             break;
-        case 4:
-            _oled.printText(0, 2, "Long press 3 sec:    ", 8);
-            _oled.printText(0, 3, "Power on/off         ", 8);
     }
-
-    shouldUpdate = false;
 }
 
 
-void UI::_showPadTestPage() {
-    _oled.printText(0, 0, "> Pad Test           ", 8);
-    _oled.printText(0, 1, "                     ", 8);
-    _oled.printText(0, 2, "WillBeAddedSoon", 16);
+void UI::_showPadTestPage(uint8_t line) {
+    switch (line) {
+        case 0: _oled.printText(0, 0, "> Pad Test           ", 8); break;
+        case 1: _oled.printText(0, 1, "                     ", 8); break;
+        case 2: _oled.printText(0, 2, "WillBeAddedSoon", 16); break; // 16 px font covers lines 2 and 3
+        default: break;
+    }
 }
 
-void UI::_showPadSettingPage() {
-    _oled.printText(0, 0, "> Pad Settings       ", 8);
-    _oled.printText(0, 1, "                     ", 8);
-    _oled.printText(0, 2, "WillBeAddedSoon", 16);
+void UI::_showPadSettingPage(uint8_t line) {
+    switch (line) {
+        case 0: _oled.printText(0, 0, "> Pad Settings       ", 8); break;
+        case 1: _oled.printText(0, 1, "                     ", 8); break;
+        case 2: _oled.printText(0, 2, "WillBeAddedSoon", 16); break; // 16 px font covers lines 2 and 3
+        default: break;
+    }
     // char buf[32];
     // snprintf(buf, sizeof(buf), "Pad %d", _selectedPadID);
     // _oled.printText(0, 1, buf, 8);
 }
 
-void UI::_showStatsPage() {
+void UI::_showStatsPage(uint8_t line) {
     static uint8_t currentPad = 0;
+    static uint8_t currentMidiInfo = 0;
     static uint32_t lastSwitchTime = 0;
 
-    _oled.printText(0, 0, "> Statistics         ", 8);
-    _oled.printText(0, 1, "Total Hits:          ", 8);
-    _oled.printText(0, 2, "MIDI Data:          B", 8);
-    
-    if (HAL_GetTick() - lastSwitchTime > 2000) {
-        _oled.clearPart(0, 3, 127, 4);
-        currentPad = (currentPad + 1) % Pad::PAD_NUM;
-        lastSwitchTime = HAL_GetTick();
-    }
+    const Midi::TxStats& tx = midi.getTxStats();
     char buf[24];
-    snprintf(buf, sizeof(buf), "%s Hits:", Pad::ID2Str((Pad::PadID)currentPad));
-    _oled.printText(0, 3, buf, 8);
 
-    _oled.printVar(90, 1, _totalHitsAll, "int", 4, false);
-    _oled.printVar(84, 2, _totalDataSent, "int", 5, false);
-    _oled.printVar(90, 3, _totalHits[currentPad], "int", 4, false);
+    switch (line) {
+        case 0:
+            if (HAL_GetTick() - lastSwitchTime > 2000) {
+                currentPad = (currentPad + 1) % Pad::PAD_NUM;
+                currentMidiInfo = (currentMidiInfo + 1) % 4;
+                lastSwitchTime = HAL_GetTick();
+            }
+            _oled.printText(0, 0, "> Statistics         ", 8);
+            break;
+
+        case 1:
+            _oled.printText(0, 1, "Total Hits:          ", 8);
+            _oled.printVar(90, 1, _totalHitsAll, "int", 4, false);
+            break;
+
+        case 2:
+            // Fixed width lines (21 chars), so switching info needs no clear
+            switch (currentMidiInfo) {
+                case 0:
+                    _oled.printText(0, 2, "MIDI Data:          B", 8);
+                    _oled.printVar(84, 2, tx.bytes, "int", 5, false);
+                    break;
+                case 1:
+                    snprintf(buf, sizeof(buf), "Link:%3u%% Peak:%3u%%  ", midi.getLinkUtilization(), midi.getLinkUtilizationPeak());
+                    _oled.printText(0, 2, buf, 8);
+                    break;
+                case 2:
+                    snprintf(buf, sizeof(buf), "On:%-6lu Off:%-6lu", tx.note_on, tx.note_off);
+                    _oled.printText(0, 2, buf, 8);
+                    break;
+                case 3:
+                    snprintf(buf, sizeof(buf), "Retry:%-4lu T/O:%-4lu ", tx.retries, tx.timeouts);
+                    _oled.printText(0, 2, buf, 8);
+                    break;
+            }
+            break;
+
+        case 3:
+            snprintf(buf, sizeof(buf), "%-10s Hits:      ", Pad::ID2Str((Pad::PadID)currentPad));
+            _oled.printText(0, 3, buf, 8);
+            _oled.printVar(90, 3, _totalHits[currentPad], "int", 4, false);
+            break;
+    }
 
     // snprintf(buf, sizeof(buf), "%s Force: %d", 
     //         Pad::ID2Str((Pad::PadID)currentPad),
     //         _avgForce[currentPad]);
     // _oled.printText(0, 3, buf, 8);
 }
+
+void UI::_showProfilerPage(uint8_t line) {
+    static uint8_t currentScope = 0;
+    static uint32_t lastSwitchTime = 0;
+    static Profiler::Summary sum;
+
+    char buf[24];
+    uint32_t cyclesPerUs = SystemCoreClock / 1000000UL;
+
+    switch (line) {
+        case 0:
+            if (HAL_GetTick() - lastSwitchTime > 2000) {
+                currentScope = (currentScope + 1) % Profiler::SCOPE_NUM;
+                lastSwitchTime = HAL_GetTick();
+            }
+            sum = profiler.getSummary(static_cast<Profiler::Scope>(currentScope)); // One snapshot for all lines
+            _oled.printText(0, 0, "> Profiler (us)      ", 8);
+            break;
+
+        case 1:
+            snprintf(buf, sizeof(buf), "%-9s n:%-9lu", Profiler::Scope2Str(static_cast<Profiler::Scope>(currentScope)), sum.count);
+            _oled.printText(0, 1, buf, 8);
+            break;
+
+        case 2:
+            snprintf(buf, sizeof(buf), "min:%-6lu avg:%-6lu", sum.min / cyclesPerUs, sum.avg / cyclesPerUs);
+            _oled.printText(0, 2, buf, 8);
+            break;
+
+        case 3:
+            snprintf(buf, sizeof(buf), "max:%-6lu p99:%-6lu", sum.max / cyclesPerUs, sum.p99 / cyclesPerUs);
+            _oled.printText(0, 3, buf, 8);
+            break;
+    }
+}
+
+void UI::_showHealthPage(uint8_t line) {
+    static uint8_t currentCounter = 0;
+    static uint32_t lastSwitchTime = 0;
+
+    char buf[24];
+
+    switch (line) {
+        case 0:
+            if (HAL_GetTick() - lastSwitchTime > 2000) {
+                currentCounter = (currentCounter + 2) % HEALTH_COUNTER_NUM;
+                lastSwitchTime = HAL_GetTick();
+            }
+            _oled.printText(0, 0, "> Health             ", 8);
+            break;
+
+        case 1:
+            snprintf(buf, sizeof(buf), "Loop%7lu/s %5luus", health.getLoopRate(), health.getLoopMaxUs());
+            _oled.printText(0, 1, buf, 8);
+            break;
+
+        case 2:
+        case 3: {
+            // Two counters per screen, fixed width lines (21 chars)
+            HealthCounter counter = static_cast<HealthCounter>((currentCounter + line - 2) % HEALTH_COUNTER_NUM);
+            snprintf(buf, sizeof(buf), "%-13s%8lu", Health::Counter2Str(counter), health.getCounter(counter));
+            _oled.printText(0, line, buf, 8);
+            break;
+        }
+    }
+}
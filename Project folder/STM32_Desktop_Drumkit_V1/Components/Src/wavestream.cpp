@@ -0,0 +1,113 @@
+/**
+ * @file wavestream.cpp
+ * @brief Binary ADC waveform streaming on USART1 (calibration aid)
+ *
+ * This file implements the WaveStream class: frame packing and the
+ * start / stop sequence of the debug UART (see wavestream.h).
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "wavestream.h"
+#include "pad.h"
+#include "logger.h"
+#include "trace.h"
+
+WaveStream waveStream; // Global waveform streamer instance
+
+/**
+ * @brief Construct a new WaveStream object
+ */
+WaveStream::WaveStream() :
+    _state(State::OFF),
+    _request(false),
+    _savedLevel(LOG_LVL_INFO),
+    _seq(0),
+    _divider(0),
+    _frames(0),
+    _dropped(0) {}
+
+/**
+ * @brief Sample the ADC buffers and queue one frame
+ *
+ * Reads the DMA targets directly (Pad::readAll(), Pad::PadID order).
+ */
+void WaveStream::sample() {
+    if (_state != State::STREAMING) { return; }
+    if (++_divider < WAVE_STREAM_DIVIDER) { return; }
+    _divider = 0;
+
+    uint8_t frame[WAVE_FRAME_SIZE];
+    frame[0] = WAVE_SYNC_0;
+    frame[1] = WAVE_SYNC_1;
+    frame[2] = _seq++;
+
+    uint16_t val[Pad::PAD_NUM];
+    Pad::readAll(val);
+    for (uint8_t i = 0; i < Pad::PAD_NUM; i += 2) {
+        Trace_Pack12(&frame[3 + i * 3 / 2], val[i], val[i + 1]);
+    }
+
+    if (logger.writeRaw(frame, WAVE_FRAME_SIZE)) {
+        _frames++;
+    } else {
+        _dropped++;
+    }
+}
+
+/**
+ * @brief Apply on/off requests
+ *
+ * Start: mute the log, wait for the ring to drain, switch to WAVE_STREAM_BAUD.
+ * Stop: stop sampling, wait for the ring to drain, switch back and unmute.
+ */
+void WaveStream::poll() {
+    switch (_state) {
+        case State::OFF:
+            if (_request) {
+                _savedLevel = logger.getLevel();
+                logger.setLevel(LOG_LVL_NONE);
+                _state = State::STARTING;
+            }
+            break;
+
+        case State::STARTING:
+            if (!_request) {
+                logger.setLevel(_savedLevel);
+                _state = State::OFF;
+            } else if (logger.getPending() == 0 && _setBaud(WAVE_STREAM_BAUD)) {
+                _seq = 0;
+                _divider = 0;
+                _state = State::STREAMING;
+            }
+            break;
+
+        case State::STREAMING:
+            if (!_request) { _state = State::STOPPING; }
+            break;
+
+        case State::STOPPING:
+            if (logger.getPending() == 0 && _setBaud(WAVE_STREAM_LOG_BAUD)) {
+                logger.setLevel(_savedLevel);
+                _state = State::OFF;
+                LOG_I("Wave stream: %lu frames, %lu dropped", _frames, _dropped);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Reprogram the USART1 baud rate (TX idle only)
+ * @param baud Baud rate
+ * @return true if done, false if the UART is still busy
+ */
+bool WaveStream::_setBaud(uint32_t baud) {
+    if (huart1.gState != HAL_UART_STATE_READY) { return false; }
+    if (huart1.Init.BaudRate == baud) { return true; }
+
+    huart1.Init.BaudRate = baud;
+    return HAL_UART_Init(&huart1) == HAL_OK;
+}
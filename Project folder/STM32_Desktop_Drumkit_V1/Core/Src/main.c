@@ -27,6 +27,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "cpp_main.h"
+#include "health.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -169,7 +170,12 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
+  Health_Fatal((uint32_t)__builtin_return_address(0)); // Records the caller (resets only with HEALTH_FATAL_RESET)
   __disable_irq();
+  if (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk)
+  {
+    __BKPT(0); // Stop here when a debugger is attached
+  }
   while (1)
   {
   }
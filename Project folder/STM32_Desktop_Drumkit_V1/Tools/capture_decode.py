@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Extract the hit waveform captures (settings menu "Hit Capture", see
+Components/Inc/hitcapture.h) from a debug UART capture.
+
+    stty -F /dev/ttyUSB0 115200 raw -echo
+    cat /dev/ttyUSB0 > dump.bin
+    python3 capture_decode.py dump.bin --csv captures.csv
+
+Prints one summary line per capture (peak, time of the peak after the
+threshold crossing, time above the threshold) and reports captures lost
+to a full pool (sequence gaps). The CSV has one row per sample:
+
+    capture, pad, hit_s, index, t_us, value, threshold
+
+where index 0 / t_us 0 is the sample that crossed the threshold and
+negative values are pre-trigger history. Text log lines and trace
+records in the same stream are skipped. No third party packages are needed.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from trace_decode import Decoder  # noqa: E402
+
+BLOCK_CAPTURE = 0x01
+HEADER = struct.Struct("<BBIHHBH")  # pad, seq, hit cycles, threshold, period us, pre, count
+PADS = ["OpenHiHat", "CloseHiHat", "Crash", "Ride", "SideStick",
+        "Kick", "Snare", "MidTom", "LowTom", "HighTom"]
+
+
+def unpack12(data, count):
+    samples = []
+    for i in range(0, count // 2 * 3, 3):
+        b0, b1, b2 = data[i], data[i + 1], data[i + 2]
+        samples.append(b0 | ((b1 & 0x0F) << 8))
+        samples.append((b1 >> 4) | (b2 << 4))
+    return samples[:count]
+
+
+def parse_capture(payload):
+    pad, seq, hit, threshold, period, pre, count = HEADER.unpack_from(payload)
+    samples = unpack12(payload[HEADER.size:], count)
+    return {"pad": pad, "seq": seq, "hit": hit, "threshold": threshold,
+            "period": period, "pre": pre, "samples": samples}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Extract drumkit hit captures from a debug UART dump")
+    parser.add_argument("dump", help="Captured UART bytes, '-' for stdin")
+    parser.add_argument("--csv", help="Write all samples to this CSV file")
+    parser.add_argument("--clock", type=float, default=168e6, help="DWT clock in Hz (default 168e6)")
+    opts = parser.parse_args()
+
+    captures = []
+
+    def on_block(btype, payload):
+        if btype == BLOCK_CAPTURE:
+            captures.append(parse_capture(payload))
+        return None
+
+    decoder = Decoder(None, opts.clock, on_block)
+    data = sys.stdin.buffer.read() if opts.dump == "-" else open(opts.dump, "rb").read()
+    decoder.feed(data)
+
+    lost = 0
+    last_seq = None
+    print("%4s %-10s %12s %5s %5s %9s %9s" % ("seq", "pad", "hit [s]", "thr", "peak", "peak@[us]", "above[us]"))
+    for c in captures:
+        if last_seq is not None:
+            lost += (c["seq"] - last_seq - 1) & 0xFF
+        last_seq = c["seq"]
+
+        s = c["samples"]
+        trig = c["pre"] - 1
+        peak = max(s)
+        peak_at = (s.index(peak) - trig) * c["period"]
+        above = sum(1 for v in s if v > c["threshold"]) * c["period"]
+        pad = PADS[c["pad"]] if c["pad"] < len(PADS) else "pad%d" % c["pad"]
+        print("%4d %-10s %12.6f %5d %5d %9d %9d" % (
+            c["seq"], pad, c["hit"] / opts.clock, c["threshold"], peak, peak_at, above))
+
+    if opts.csv:
+        with open(opts.csv, "w") as f:
+            f.write("capture,pad,hit_s,index,t_us,value,threshold\n")
+            for c in captures:
+                trig = c["pre"] - 1
+                pad = PADS[c["pad"]] if c["pad"] < len(PADS) else "pad%d" % c["pad"]
+                for i, v in enumerate(c["samples"]):
+                    f.write("%d,%s,%.6f,%d,%d,%d,%d\n" % (
+                        c["seq"], pad, c["hit"] / opts.clock, i - trig, (i - trig) * c["period"], v, c["threshold"]))
+
+    print("%d captures, %d lost (pool full)" % (len(captures), lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+Build an indexed UTF-8 font (Font of Components/Libs/oled-menu/Inc/font.h)
+from the glyph table of the Baud-Dance LED tool (https://led.baud-dance.com).
+
+The tool emits one brace group per glyph: the UTF-8 bytes of the character
+padded to 4 bytes, then the glyph bytes (page by page, w bytes per page):
+
+    /* 0 波 */ {0xe6,0xb3,0xa2,0x00,0x10,0x60, ...},
+
+This script decodes the prefix to a codepoint, sorts the glyphs by
+codepoint (OLED_FindGlyph() does a binary search) and writes a C file with
+the codepoint table, the glyph table and the Font:
+
+    python3 font_index.py zh16x16.txt --name font16x16 -W 16 -H 16 -o font16x16.c
+
+--check reports the characters of a text (e.g. all menu strings of a
+localised menu) that the font lacks; OLED_PrintString() would draw them as
+ASCII fallback or blank. No third party packages are needed.
+"""
+
+import argparse
+import re
+import sys
+
+PREFIX_LEN = 4
+GROUP = re.compile(r"\{([^{}]*)\}")
+BYTE = re.compile(r"0[xX]([0-9a-fA-F]{1,2})")
+
+
+def parse(text, glyph_len):
+    """Return {codepoint: glyph bytes} of all brace groups of the tool output."""
+    glyphs = {}
+    for group in GROUP.finditer(text):
+        data = bytes(int(b, 16) for b in BYTE.findall(group.group(1)))
+        if not data:
+            continue
+        if len(data) != PREFIX_LEN + glyph_len:
+            sys.exit("glyph of %d bytes, expected %d (check -W / -H)" % (len(data), PREFIX_LEN + glyph_len))
+        try:
+            char = data[:PREFIX_LEN].rstrip(b"\x00").decode("utf-8")
+        except UnicodeDecodeError:
+            sys.exit("bad UTF-8 prefix %s" % data[:PREFIX_LEN].hex())
+        if len(char) != 1:
+            sys.exit("prefix %s is not one character" % data[:PREFIX_LEN].hex())
+        code = ord(char)
+        if code in glyphs and glyphs[code] != data[PREFIX_LEN:]:
+            print("warning: %s (U+%04X) defined twice, the last one is used" % (char, code), file=sys.stderr)
+        glyphs[code] = data[PREFIX_LEN:]
+    return glyphs
+
+
+def render(glyphs, name, width, height, ascii_font, source):
+    """Return the C source of the indexed font."""
+    glyph_len = (height + 7) // 8 * width
+    codes = sorted(glyphs)
+    out = ["// Generated by Tools/font_index.py from %s, do not edit" % source,
+           "// clang-format off",
+           '#include "font.h"',
+           "",
+           "const uint32_t %s_codes[] = {" % name]
+    for code in codes:
+        out.append("    0x%04X, // %s" % (code, chr(code)))
+    out.append("};")
+    out.append("")
+    out.append("const uint8_t %s_glyphs[][%d] = {" % (name, glyph_len))
+    for code in codes:
+        out.append("    /* %s */ {%s}," % (chr(code), ",".join("0x%02x" % b for b in glyphs[code])))
+    out.append("};")
+    out.append("")
+    out.append("const Font %s = {%d, %d, %s_codes, (const uint8_t *)%s_glyphs, %d, &%s};"
+               % (name, height, width, name, name, len(codes), ascii_font))
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sort a Baud-Dance glyph table into an indexed Font")
+    parser.add_argument("input", help="glyph table of the LED tool (C text)")
+    parser.add_argument("--name", default="font16x16", help="C name of the Font")
+    parser.add_argument("-W", "--width", type=int, default=16, help="glyph width")
+    parser.add_argument("-H", "--height", type=int, default=16, help="glyph height")
+    parser.add_argument("--ascii", default="afont8x6", help="ASCIIFont for characters missing in the font")
+    parser.add_argument("-o", "--output", help="C file to write (default: stdout)")
+    parser.add_argument("--check", metavar="TEXT_FILE", help="report characters of this UTF-8 text missing in the font")
+    args = parser.parse_args()
+
+    with open(args.input, encoding="utf-8") as f:
+        glyphs = parse(f.read(), (args.height + 7) // 8 * args.width)
+    if not glyphs:
+        sys.exit("no glyphs found in %s" % args.input)
+    if len(glyphs) > 0xFFFF:
+        sys.exit("%d glyphs, Font.len is uint16_t" % len(glyphs))
+
+    source = render(glyphs, args.name, args.width, args.height, args.ascii, args.input)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+    print("%d glyphs" % len(glyphs), file=sys.stderr)
+
+    if args.check:
+        with open(args.check, encoding="utf-8") as f:
+            text = f.read()
+        missing = sorted({c for c in text if ord(c) > 0x7E and ord(c) not in glyphs})
+        if missing:
+            print("missing %d: %s" % (len(missing), "".join(missing)), file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+Turn a hit recorder dump (multi click on a display page, see
+Components/Inc/hitrec.h) into a readable timeline.
+
+The input can be any capture of the debug UART (plain text log, or the
+raw stream with binary trace records): only the "#HREC" lines are used.
+
+    python3 hitrec_decode.py dump.txt
+    python3 hitrec_decode.py dump.bin --double-ms 30
+
+Times are relative to the dump ("now" in the BEGIN line). Hits that follow
+the previous hit on the same pad within --double-ms are flagged as
+possible double triggers. No third party packages are needed.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+PADS = ["OpenHiHat", "CloseHiHat", "Crash", "Ride", "SideStick",
+        "Kick", "Snare", "MidTom", "LowTom", "HighTom"]
+RESULTS = ["sent", "held", "flushed", "rejected"]   # Midi::QueueResult
+EVENT = struct.Struct("<IHHBBBB")                   # HitRecorder::Event
+WINDOW_MS = 18                                      # ADC_MEASURING_WINDOW_MS
+
+BEGIN = re.compile(rb"#HREC BEGIN n=(\d+) total=(\d+) now=(\d+)")
+LINE = re.compile(rb"#HREC ([0-9a-f]{24})\s*$")
+
+
+def parse(data):
+    """Return a list of dumps: {"total", "now", "events": [dict]}."""
+    dumps = []
+    current = None
+    for raw in data.split(b"\n"):
+        m = BEGIN.search(raw)
+        if m:
+            current = {"total": int(m.group(2)), "now": int(m.group(3)), "events": []}
+            dumps.append(current)
+            continue
+        if current is None:
+            continue
+        if b"#HREC END" in raw:
+            current = None
+            continue
+        m = LINE.search(raw)
+        if m:
+            tick, peak, threshold, pad_result, velocity, window, depth = EVENT.unpack(bytes.fromhex(m.group(1).decode()))
+            current["events"].append({
+                "tick": tick, "peak": peak, "threshold": threshold,
+                "pad": pad_result & 0x0F, "result": pad_result >> 4,
+                "velocity": velocity, "window": window, "depth": depth,
+            })
+    return dumps
+
+
+def timeline(dump, double_ms):
+    now = dump["now"]
+    events = dump["events"]
+    print("%d hits in dump, %d since boot" % (len(events), dump["total"]))
+    print("%10s %8s  %-10s %4s %5s %5s %6s %3s  %-8s %s" % (
+        "t [ms]", "dt [ms]", "pad", "vel", "peak", "thr", "win", "q", "midi", "notes"))
+
+    last_tick = None
+    last_per_pad = {}
+    for ev in events:
+        notes = []
+        onset = ev["tick"] - ev["window"]
+        prev = last_per_pad.get(ev["pad"])
+        if prev is not None and onset - prev < double_ms:
+            notes.append("double? (+%d ms on same pad)" % (onset - prev))
+        if ev["window"] >= 2 * WINDOW_MS:
+            notes.append("long window")
+        if ev["peak"] <= ev["threshold"]:
+            notes.append("peak below threshold")
+        if ev["result"] != 0:
+            notes.append("not sent directly")
+        last_per_pad[ev["pad"]] = ev["tick"]
+
+        dt = "" if last_tick is None else "%+d" % (ev["tick"] - last_tick)
+        last_tick = ev["tick"]
+        pad = PADS[ev["pad"]] if ev["pad"] < len(PADS) else "pad%d" % ev["pad"]
+        result = RESULTS[ev["result"]] if ev["result"] < len(RESULTS) else "?%d" % ev["result"]
+        window = ">=255" if ev["window"] == 255 else str(ev["window"])
+        print(("%10d %8s  %-10s %4d %5d %5d %6s %3d  %-8s %s" % (
+            ev["tick"] - now, dt, pad, ev["velocity"], ev["peak"], ev["threshold"],
+            window, ev["depth"], result, ", ".join(notes))).rstrip())
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode drumkit hit recorder dumps")
+    parser.add_argument("dump", help="UART capture containing #HREC lines, '-' for stdin")
+    parser.add_argument("--double-ms", type=int, default=40,
+                        help="Flag hits on the same pad closer than this (default 40 ms)")
+    opts = parser.parse_args()
+
+    data = sys.stdin.buffer.read() if opts.dump == "-" else open(opts.dump, "rb").read()
+    dumps = parse(data)
+    if not dumps:
+        print("no #HREC dump found", file=sys.stderr)
+        sys.exit(1)
+
+    for i, dump in enumerate(dumps):
+        if i:
+            print()
+        timeline(dump, opts.double_ms)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,210 @@
+/**
+ * @file draw_bench.cpp
+ * @brief Host benchmark of the display core drawing (oled_draw.c)
+ *
+ * Text: draws full 21 / 16 character lines with OLED_PrintASCIIString() into
+ * OLED_GRAM, alternating two strings so every glyph changes the buffer, and
+ * prints glyphs per second:
+ * - aligned: y on a page boundary (the whole glyph column bytes are copied)
+ * - unaligned: y = 3 mod 8 (every column byte is shifted into two pages)
+ * - CJK menu: lines of a Chinese menu with OLED_PrintString() and a 16x16
+ *   font of n glyphs (the menu characters plus filler codepoints, random
+ *   bitmaps), so the codepoint lookup is part of the cost
+ *
+ * Shapes: the rectangles and lines of the menu (scroll bar, slider, switch,
+ * selection frame, dialog box) at several positions, in pixels covered per
+ * second.
+ *
+ * Only the drawing code is linked, the OLED bus is stubbed out. Host
+ * numbers: compare the two paths and before / after a change, not with the
+ * target (build with the same OPT as the simulator).
+ *
+ *   make bench
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "oled_bus.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+#include "oled_draw.h"
+}
+
+#define BENCH_SECONDS 0.5               // Run time per case
+
+static const char* cjkMenu[] = { "设置菜单", "触发灵敏度", "音量曲线", "MIDI通道", "返回上级", "踩镲开合阈值" };
+
+extern "C" {
+
+uint32_t HAL_GetTick(void) { return 0; }
+bool OledBus_Cmds(const uint8_t* cmds, uint8_t len) { (void)cmds; (void)len; return true; }
+bool OledBus_Page(uint8_t page, uint8_t x1, uint8_t x2, const uint8_t* row) { (void)page; (void)x1; (void)x2; (void)row; return true; }
+
+} // extern "C"
+
+/**
+ * @brief Draw lines until BENCH_SECONDS have passed
+ * @return double Glyphs per second
+ */
+static double run(const ASCIIFont* font, int16_t y, OLED_ColorMode color) {
+    char lines[2][22] = { "Kick Snare Tom1 Ride!", "0123456789 abcdefghij" };
+    uint8_t perLine = OLED_COLUMN / font->w;
+    lines[0][perLine] = '\0';
+    lines[1][perLine] = '\0';
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    uint64_t glyphs = 0;
+    double elapsed = 0;
+    uint32_t batch = 0;
+
+    while (elapsed < BENCH_SECONDS) {
+        for (uint16_t i = 0; i < 1000; i++) {
+            OLED_PrintASCIIString(0, y, lines[batch++ & 1], font, color);
+        }
+        glyphs += 1000ULL * perLine;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    return glyphs / elapsed;
+}
+
+/**
+ * @brief Codepoint of a three byte UTF-8 character
+ */
+static uint32_t decode3(const unsigned char* p) {
+    return ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+}
+
+/**
+ * @brief Draw the CJK menu lines until BENCH_SECONDS have passed
+ * @param n Glyphs of the font
+ * @return double Glyphs per second
+ */
+static double runCjk(size_t n) {
+    std::vector<uint32_t> codes;
+    for (const char* line : cjkMenu) {
+        for (const unsigned char* p = (const unsigned char*)line; *p; p++) {
+            if (*p >= 0xE0) { codes.push_back(decode3(p)); p += 2; }
+        }
+    }
+    uint32_t filler = 0;
+    while (codes.size() < n) {
+        while (codes.size() < n) { codes.push_back(0x4E00 + (filler++ * 53) % 0x51A0); } // CJK Unified Ideographs
+        std::sort(codes.begin(), codes.end());
+        codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+    }
+    std::vector<uint8_t> glyphs(codes.size() * 32);
+    for (uint8_t& b : glyphs) { b = (uint8_t)rand(); }
+    Font font = { 16, 16, codes.data(), glyphs.data(), (uint16_t)codes.size(), &afont8x6 };
+
+    uint32_t lineGlyphs[6] = { 0 };
+    for (uint8_t i = 0; i < 6; i++) {
+        for (const unsigned char* p = (const unsigned char*)cjkMenu[i]; *p; p++) {
+            if ((*p & 0xC0) != 0x80) { lineGlyphs[i]++; }
+            if (*p >= 0xE0 && !OLED_FindGlyph(&font, decode3(p))) {
+                printf("lookup failed\n");
+                exit(1);
+            }
+        }
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    uint64_t count = 0;
+    double elapsed = 0;
+
+    while (elapsed < BENCH_SECONDS) {
+        for (uint16_t i = 0; i < 1000; i++) {
+            OLED_PrintString(0, 8, (char*)cjkMenu[i % 6], &font, OLED_COLOR_NORMAL);
+            count += lineGlyphs[i % 6];
+        }
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    return count / elapsed;
+}
+
+/**
+ * @brief Shape drawn by a case, at offset (dx, dy)
+ */
+typedef void (*ShapeFunc)(int16_t dx, int16_t dy);
+
+static void hLine(int16_t dx, int16_t dy) { OLED_DrawLine(dx, 3 + dy, 100 + dx, 3 + dy, OLED_COLOR_NORMAL); }
+static void vLine(int16_t dx, int16_t dy) { OLED_DrawLine(20 + dx, 1 + dy, 20 + dx, 30 + dy / 4, OLED_COLOR_NORMAL); }
+static void frame(int16_t dx, int16_t dy) { OLED_DrawRectangle(24 + dx, 10 + dy / 2, 80, 10, OLED_COLOR_NORMAL); }
+static void sliderBar(int16_t dx, int16_t dy) { OLED_DrawFilledRectangle(26 + dx, 12 + dy / 2, 60, 7, OLED_COLOR_NORMAL); }
+static void selection(int16_t dx, int16_t dy) { OLED_DrawFilledRectangleWithCorners(dx, 1 + dy, 90, 14, OLED_COLOR_REVERSED); }
+static void switchBox(int16_t dx, int16_t dy) { OLED_DrawRectangleWithCorners(34 + dx, 8 + dy / 2, 60, 20, OLED_COLOR_NORMAL); }
+static void dialog(int16_t dx, int16_t dy) { OLED_DrawEmptyRectangle(16 + dx, 2 + dy / 4, 96, 28); }
+
+/**
+ * @brief Draw a shape at changing offsets until BENCH_SECONDS have passed
+ * @param shape Shape
+ * @param pixels Pixels the shape covers
+ * @return double Pixels per second
+ */
+static double runShape(ShapeFunc shape, uint32_t pixels) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    uint64_t count = 0;
+    double elapsed = 0;
+
+    while (elapsed < BENCH_SECONDS) {
+        for (uint16_t i = 0; i < 1000; i++) {
+            shape(i % 8, i % 8); // All eight bit offsets within a page
+        }
+        count += 1000ULL * pixels;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    return count / elapsed;
+}
+
+int main() {
+    struct Case {
+        const char* name;
+        const ASCIIFont* font;
+        int16_t y;
+        OLED_ColorMode color;
+    };
+    const Case cases[] = {
+        { "8x6 aligned", &afont8x6, 8, OLED_COLOR_NORMAL },
+        { "8x6 aligned reversed", &afont8x6, 8, OLED_COLOR_REVERSED },
+        { "8x6 unaligned", &afont8x6, 11, OLED_COLOR_NORMAL },
+        { "12x6 unaligned", &afont12x6, 3, OLED_COLOR_NORMAL },
+        { "16x8 aligned", &afont16x8, 8, OLED_COLOR_NORMAL },
+        { "16x8 unaligned", &afont16x8, 11, OLED_COLOR_NORMAL },
+    };
+
+    for (const Case& c : cases) {
+        printf("%-22s %10.0f glyphs/s\n", c.name, run(c.font, c.y, c.color));
+    }
+    for (size_t n : { 40, 255, 1000 }) {
+        printf("CJK menu, %4u glyphs %10.0f glyphs/s\n", (unsigned)n, runCjk(n));
+    }
+
+    struct Shape {
+        const char* name;
+        ShapeFunc func;
+        uint32_t pixels;
+    };
+    const Shape shapes[] = {
+        { "line horizontal 101", hLine, 101 },
+        { "line vertical 30", vLine, 30 },
+        { "frame 81x11", frame, 2 * 81 + 2 * 9 },
+        { "slider bar 61x7", sliderBar, 61 * 7 },
+        { "selection 91x14 (xor)", selection, 91 * 14 - 4 * 4 },
+        { "switch 61x21 rounded", switchBox, 2 * 57 + 2 * 17 + 16 },
+        { "dialog 97x29 cleared", dialog, 97 * 29 },
+    };
+    for (const Shape& s : shapes) {
+        printf("%-22s %11.0f pixels/s\n", s.name, runShape(s.func, s.pixels));
+    }
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief Host HAL shim for the simulation build (see sim.h)
+ *
+ * Stands in for the STM32F4 HAL when Components and the oled-menu library
+ * are built on Linux. Only what the application code uses is declared:
+ * handle types with the fields it reads, the HAL calls, the CMSIS
+ * intrinsics and the DWT cycle counter. The calls are implemented by the
+ * simulator in sim_hal.cpp on a virtual clock.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum { HAL_OK = 0x00U, HAL_ERROR = 0x01U, HAL_BUSY = 0x02U, HAL_TIMEOUT = 0x03U } HAL_StatusTypeDef;
+
+/* GPIO --------------------------------------------------------------------*/
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+typedef struct {
+    uint16_t ODR;                       // Output latch
+    uint8_t index;                      // Port index (A = 0)
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef sim_gpio[3];
+
+#define GPIOA (&sim_gpio[0])
+#define GPIOB (&sim_gpio[1])
+#define GPIOC (&sim_gpio[2])
+
+#define GPIO_PIN_0  0x0001U
+#define GPIO_PIN_1  0x0002U
+#define GPIO_PIN_2  0x0004U
+#define GPIO_PIN_3  0x0008U
+#define GPIO_PIN_4  0x0010U
+#define GPIO_PIN_5  0x0020U
+#define GPIO_PIN_6  0x0040U
+#define GPIO_PIN_7  0x0080U
+#define GPIO_PIN_8  0x0100U
+#define GPIO_PIN_9  0x0200U
+#define GPIO_PIN_10 0x0400U
+#define GPIO_PIN_11 0x0800U
+#define GPIO_PIN_12 0x1000U
+#define GPIO_PIN_13 0x2000U
+#define GPIO_PIN_14 0x4000U
+#define GPIO_PIN_15 0x8000U
+
+typedef enum { EXTI4_IRQn = 10 } IRQn_Type;
+
+/* Peripheral instances ----------------------------------------------------*/
+
+#define USART1 1U
+#define USART2 2U
+#define I2C1   1U
+#define ADC1   1U
+#define ADC2   2U
+#define ADC3   3U
+
+/* DMA ---------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t Instance;
+    volatile uint32_t ErrorCode;
+    volatile uint32_t NDTR;             // Remaining transfers (circular RX)
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(h) ((h)->NDTR)
+
+/* ADC ---------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t Instance;
+    volatile uint32_t ErrorCode;
+} ADC_HandleTypeDef;
+
+#define HAL_ADC_ERROR_OVR 0x02U
+#define HAL_ADC_ERROR_DMA 0x04U
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc);
+
+/* I2C ---------------------------------------------------------------------*/
+
+typedef enum {
+    HAL_I2C_STATE_RESET   = 0x00U,
+    HAL_I2C_STATE_READY   = 0x20U,
+    HAL_I2C_STATE_BUSY    = 0x24U,
+    HAL_I2C_STATE_BUSY_TX = 0x21U
+} HAL_I2C_StateTypeDef;
+
+typedef struct {
+    uint32_t ClockSpeed;
+} I2C_InitTypeDef;
+
+typedef struct {
+    uint32_t Instance;
+    I2C_InitTypeDef Init;
+    volatile uint32_t ErrorCode;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+    volatile HAL_I2C_StateTypeDef State;
+} I2C_HandleTypeDef;
+
+#define I2C_MEMADD_SIZE_8BIT 0x00000001U
+#define HAL_I2C_ERROR_AF     0x04U
+#define HAL_I2C_ERROR_DMA    0x10U
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+                                          uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+                                              uint8_t *pData, uint16_t Size);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+/* UART --------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t BaudRate;
+} UART_InitTypeDef;
+
+typedef enum {
+    HAL_UART_STATE_RESET   = 0x00U,
+    HAL_UART_STATE_READY   = 0x20U,
+    HAL_UART_STATE_BUSY_TX = 0x21U,
+    HAL_UART_STATE_BUSY_RX = 0x22U
+} HAL_UART_StateTypeDef;
+
+typedef struct {
+    uint32_t Instance;
+    UART_InitTypeDef Init;
+    volatile uint32_t ErrorCode;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+    volatile HAL_UART_StateTypeDef gState;
+    volatile HAL_UART_StateTypeDef RxState;
+} UART_HandleTypeDef;
+
+#define HAL_UART_ERROR_DMA 0x10U
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+/* GPIO / system -----------------------------------------------------------*/
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+extern uint32_t SystemCoreClock;
+
+void NVIC_SystemReset(void) __attribute__((noreturn));
+
+/* CMSIS intrinsics --------------------------------------------------------*/
+
+uint32_t sim_get_primask(void);
+void sim_set_primask(uint32_t primask);
+
+#define __disable_irq()     sim_set_primask(1U)
+#define __enable_irq()      sim_set_primask(0U)
+#define __get_PRIMASK()     sim_get_primask()
+#define __set_PRIMASK(p)    sim_set_primask(p)
+#define __DMB()             __sync_synchronize()
+#define __DSB()             __sync_synchronize()
+#define __CLZ(x)            ((uint8_t)((x) ? __builtin_clz(x) : 32U))
+#define __NOP()             ((void)0)
+
+/* DWT cycle counter -------------------------------------------------------*/
+
+uint32_t sim_cycles(void);
+void sim_set_cycles(uint32_t cycles);
+
+#ifdef __cplusplus
+}
+
+/**
+ * @brief CYCCNT stand-in: every read returns (and advances) the virtual clock
+ */
+struct SimCycleCounter {
+    inline operator uint32_t() const { return sim_cycles(); }
+    inline SimCycleCounter& operator=(uint32_t value) { sim_set_cycles(value); return *this; }
+};
+
+typedef struct {
+    uint32_t CTRL;
+    SimCycleCounter CYCCNT;
+} DWT_Type;
+#else
+typedef struct {
+    uint32_t CTRL;
+    uint32_t CYCCNT;                    // Not backed by the clock, C code has no DWT reads
+} DWT_Type;
+#endif
+
+typedef struct {
+    uint32_t DEMCR;
+} CoreDebug_Type;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern DWT_Type sim_dwt;
+extern CoreDebug_Type sim_coredebug;
+
+#ifdef __cplusplus
+}
+#endif
+
+#define DWT       (&sim_dwt)
+#define CoreDebug (&sim_coredebug)
+
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
@@ -0,0 +1,306 @@
+/**
+ * @file midi_test.cpp
+ * @brief Host tests of the MIDI output queueing (midi.cpp) on the virtual board
+ *
+ * Drives the global Midi object directly (no cpp_main(), no scheduler) on
+ * the HAL shim of the simulator, so the CH345 ACKs, the link pin and the
+ * clock behave as in drumkit-sim. The bytes on USART2 are decoded by the
+ * simulator and compared without their timestamps.
+ *
+ * - Burst queue full while a SysEx reply is pending: the oldest note goes
+ *   to the hold buffer, nothing is written past the queue, all notes
+ *   follow the complete frame in order.
+ * - Link lost in the middle of a Note On / Note Off: the message is sent
+ *   again in full after reconnect, the Note Off is not forgotten.
+ * - SysEx replies received (our own through a loopback): no answer, an
+ *   unknown command still gets its NAK.
+ *
+ * Prints the failed checks and exits with 1 if there are any.
+ *
+ *   make midi-test
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "sim.h"
+#include "midi.h"
+#include "midi_in.h"
+#include "dwt.h"
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+static int checks = 0;
+static int failures = 0;
+
+static FILE* midiOut = nullptr;         // Decoded USART2 bytes of the current test
+static bool linkUp = true;              // USB_RDY level (low = connected)
+
+static void check(bool ok, const char* name, const std::string& got, const std::string& expected) {
+    checks++;
+    if (ok) { return; }
+    failures++;
+    printf("FAIL %s\n  got:      %s\n  expected: %s\n", name, got.c_str(), expected.c_str());
+}
+
+static void checkNum(const char* name, uint32_t got, uint32_t expected) {
+    check(got == expected, name, std::to_string(got), std::to_string(expected));
+}
+
+/**
+ * @brief MIDI link pin, every other input reads back its latch
+ */
+static int inputSource(uint64_t now, uint8_t port, uint16_t pin) {
+    (void)now;
+    if (port == USB_RDY_GPIO_Port->index && pin == USB_RDY_Pin) { return linkUp ? 0 : 1; }
+    return -1;
+}
+
+/**
+ * @brief Call the MIDI task until it has nothing left to send
+ * @return uint32_t Number of calls
+ */
+static uint32_t drain() {
+    uint32_t calls = 0;
+    while (midi.hasWork(0) && calls < 1000) {
+        midi.flushBurst(0);
+        midi.autoNoteOff();
+        calls++;
+    }
+    return calls;
+}
+
+/**
+ * @brief Start a test: fresh output capture, link up, queues empty
+ */
+static void begin() {
+    linkUp = true;
+    midi.isConnected();
+    sim_advance(sim_ms(200)); // Past the Note Off delay and stale cutoff of anything left over
+    drain();
+
+    midiOut = tmpfile();
+    SimOutputs outputs = { midiOut, nullptr, nullptr, nullptr };
+    sim_set_outputs(outputs, 40.0);
+}
+
+/**
+ * @brief Messages sent since begin(), one per line without the time column
+ * @return std::string Lines joined by "; "
+ */
+static std::string sent() {
+    std::string log;
+    char line[512];
+    fflush(midiOut);
+    rewind(midiOut);
+    while (fgets(line, sizeof(line), midiOut)) {
+        std::string msg(line + 10);
+        while (!msg.empty() && (msg.back() == '\n' || msg.back() == ' ')) { msg.pop_back(); }
+        if (!log.empty()) { log += "; "; }
+        log += msg.substr(1);
+    }
+    SimOutputs none = { nullptr, nullptr, nullptr, nullptr };
+    sim_set_outputs(none, 40.0);
+    fclose(midiOut);
+    midiOut = nullptr;
+    return log;
+}
+
+static void linkDownEvent(void* arg) {
+    (void)arg;
+    linkUp = false;
+}
+
+/**
+ * @brief Take the link down during the first byte of the next message
+ */
+static void dropLinkSoon() {
+    sim_at(sim_now() + sim_us(100), linkDownEvent, nullptr);
+}
+
+/**
+ * @brief Bring the link back after the MIDI task has seen it down
+ */
+static void reconnect() {
+    sim_advance(sim_ms(5));
+    linkUp = true;
+    midi.isConnected();
+}
+
+static std::string noteOn(Pad::PadID pad, uint8_t velocity) {
+    char msg[48];
+    snprintf(msg, sizeof(msg), "99 %02X %02X  NoteOn  ch10 note %u vel %u",
+             midi.getPadNote(pad), velocity, midi.getPadNote(pad), velocity);
+    return msg;
+}
+
+/**
+ * @brief Eleventh note into the full burst queue while a SysEx frame is open
+ */
+static void testBurstFullDuringSysEx() {
+    begin();
+
+    uint8_t payload[MIDI_SYSEX_TX_SIZE];
+    std::string frame = "F0";
+    for (uint16_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)i;
+        char hex[4];
+        snprintf(hex, sizeof(hex), " %02X", payload[i]);
+        frame += hex;
+    }
+    frame += " F7  SysEx";
+
+    check(midi.queueSysEx(payload, sizeof(payload)), "SysEx queued", "false", "true");
+    midi.flushBurst(0); // First slice, the frame is now open on the wire
+
+    uint16_t window = midi.getBurstWindow();
+    std::vector<std::string> expected;
+    expected.push_back(frame);
+
+    for (uint8_t i = 0; i < MIDI_CHANNELS_NUM; i++) {
+        Pad::PadID pad = static_cast<Pad::PadID>(i);
+        Midi::QueueResult result = midi.queueNoteOn(pad, 10 + i, DWT_GetCycles());
+        checkNum("queue until full", result, Midi::QUEUED);
+        expected.push_back(noteOn(pad, 10 + i));
+    }
+    checkNum("frame still open", midi.isSysExPending(), 1);
+
+    Midi::QueueResult result = midi.queueNoteOn(Pad::Snare, 100, DWT_GetCycles());
+    checkNum("full queue result", result, Midi::QUEUED_FLUSHED);
+    checkNum("full queue pending", midi.getBurstPending(), MIDI_CHANNELS_NUM);
+    checkNum("oldest note held", midi.getHeldCount(), 1);
+    checkNum("members behind the queue", midi.getBurstWindow(), window);
+    expected.push_back(noteOn(Pad::Snare, 100));
+
+    drain();
+
+    std::string want;
+    for (size_t i = 0; i < expected.size(); i++) { want += (i ? "; " : "") + expected[i]; }
+    std::string got = sent();
+    got = got.substr(0, got.find("; 89")); // Note Offs follow, not part of this test
+    check(got == want, "frame, held note, then the burst", got, want);
+
+    const Midi::HoldStats& hold = midi.getHoldStats();
+    checkNum("held", hold.held, 1);
+    checkNum("replayed", hold.replayed, 1);
+    checkNum("sysex frames", midi.getTxStats().sysex, 1);
+    checkNum("note ons", midi.getTxStats().note_on, MIDI_CHANNELS_NUM + 1);
+}
+
+static std::string noteOff(Pad::PadID pad) {
+    char msg[48];
+    snprintf(msg, sizeof(msg), "89 %02X 00  NoteOff ch10 note %u vel 0", midi.getPadNote(pad), midi.getPadNote(pad));
+    return msg;
+}
+
+/**
+ * @brief Note On broken off after its status byte, replayed after reconnect
+ */
+static void testNoteOnBrokenOff() {
+    begin();
+    uint32_t aborted = midi.getHoldStats().aborted;
+    uint32_t replayed = midi.getHoldStats().replayed;
+
+    midi.queueNoteOn(Pad::Kick, 90, DWT_GetCycles());
+    dropLinkSoon();
+    checkNum("broken off burst", midi.flushBurst(0), 0);
+    checkNum("broken off note held", midi.getHeldCount(), 1);
+    checkNum("broken off counted", midi.getHoldStats().aborted - aborted, 1);
+
+    reconnect();
+    drain();
+    checkNum("held note replayed", midi.getHoldStats().replayed - replayed, 1);
+
+    std::string want = noteOn(Pad::Kick, 90); // Its Note Off is not due yet
+    std::string got = sent();
+    check(got == want, "Note On sent in full after reconnect", got, want);
+}
+
+/**
+ * @brief Note Off broken off after its status byte, sent after reconnect
+ */
+static void testNoteOffBrokenOff() {
+    begin();
+    uint32_t aborted = midi.getHoldStats().aborted;
+
+    midi.queueNoteOn(Pad::Ride, 70, DWT_GetCycles());
+    midi.flushBurst(0);
+    sim_advance(sim_ms(NOTEOFF_DELAY_MS + 1));
+
+    dropLinkSoon();
+    midi.autoNoteOff();
+    checkNum("Note Off broken off counted", midi.getHoldStats().aborted - aborted, 1);
+    checkNum("Note Off still due", midi.hasWork(0), 0); // Link down
+
+    reconnect();
+    checkNum("Note Off due after reconnect", midi.hasWork(0), 1);
+    drain();
+
+    std::string want = noteOn(Pad::Ride, 70) + "; " + noteOff(Pad::Ride);
+    std::string got = sent();
+    check(got == want, "Note Off sent in full after reconnect", got, want);
+}
+
+/**
+ * @brief Feed one SysEx frame to the MIDI input and send whatever it answers
+ * @param hex Frame as hex digits, e.g. "F07D0101F7"
+ * @return std::string Messages sent in response
+ */
+static std::string answerTo(const char* hex) {
+    begin();
+    uint8_t bytes[MIDI_IN_SYSEX_BUF_SIZE];
+    uint16_t len = 0;
+    for (const char* p = hex; p[0] && p[1] && len < sizeof(bytes); p += 2) {
+        char digits[3] = { p[0], p[1], 0 };
+        bytes[len++] = (uint8_t)strtoul(digits, nullptr, 16);
+    }
+    sim_uart2_rx(bytes, len);
+    midiIn.poll(true);
+    drain();
+    midiIn.poll(true);
+    drain();
+    return sent();
+}
+
+/**
+ * @brief Replies are not answered (no NAK ping-pong through a loopback)
+ */
+static void testSysExReplies() {
+    std::string got = answerTo("F07D017F03F7");
+    check(got.empty(), "ACK ignored", got, "");
+
+    got = answerTo("F07D017E0303F7");
+    check(got.empty(), "NAK ignored", got, "");
+
+    got = answerTo("F07D010200F7");
+    check(got.empty(), "dump ignored", got, "");
+
+    std::string want = "F0 7D 01 7E 05 03 F7  SysEx";
+    got = answerTo("F07D0105F7");
+    check(got == want, "unknown command NAKed", got, want);
+}
+
+int main() {
+    sim_set_input_source(inputSource);
+    DWT_Init();
+    midiIn.begin();
+
+    testBurstFullDuringSysEx();
+    testNoteOnBrokenOff();
+    testNoteOffBrokenOff();
+    testSysExReplies();
+
+    printf("midi-test: %d checks, %d failed\n", checks, failures);
+    return failures ? 1 : 0;
+}
+
+/**
+ * @brief End of the virtual time (never set by the tests)
+ */
+void sim_finish() {
+    printf("midi-test: simulation ended unexpectedly\n");
+    exit(1);
+}
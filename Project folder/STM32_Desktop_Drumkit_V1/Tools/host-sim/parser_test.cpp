@@ -0,0 +1,280 @@
+/**
+ * @file parser_test.cpp
+ * @brief Host tests of the byte stream parsers (midi_parser.cpp, shell_parser.cpp)
+ *
+ * MidiParser: running status, realtime bytes inside a message and inside a
+ * SysEx frame, overlong and aborted SysEx frames. Every case is also fed
+ * split at every position and in random fragments, which has to give the
+ * same handler calls and statistics as feeding it in one block.
+ *
+ * ShellParser: a table of input bytes and the lines they have to give, for
+ * word splitting (quotes are plain characters, there is no quoting), too
+ * many words, the line length limit, backspace / DEL and the line endings.
+ * Plus match() and toUInt16().
+ *
+ * Only the parsers are linked, no HAL. Prints the failed checks and exits
+ * with 1 if there are any.
+ *
+ *   make parser-test
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "midi_parser.h"
+#include "shell_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static int checks = 0;
+static int failures = 0;
+
+static void check(bool ok, const char* name, const std::string& got, const std::string& expected) {
+    checks++;
+    if (ok) { return; }
+    failures++;
+    printf("FAIL %s\n  got:      %s\n  expected: %s\n", name, got.c_str(), expected.c_str());
+}
+
+/****************************************************** MidiParser ******************************************************/
+
+#define TEST_SYSEX_SIZE 8               // Small buffer, so the overflow case stays short
+
+static std::string midiLog;             // Handler calls, one "X hh hh ..." entry per call
+
+static void logByte(uint8_t byte) {
+    char hex[4];
+    snprintf(hex, sizeof(hex), " %02X", byte);
+    midiLog += hex;
+}
+
+static void onMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+    midiLog += "M";
+    logByte(status);
+    logByte(data1);
+    logByte(data2);
+    midiLog += "; ";
+}
+
+static void onRealtime(uint8_t byte) {
+    midiLog += "R";
+    logByte(byte);
+    midiLog += "; ";
+}
+
+static void onSysEx(const uint8_t* data, uint16_t len) {
+    midiLog += "S";
+    for (uint16_t i = 0; i < len; i++) { logByte(data[i]); }
+    midiLog += "; ";
+}
+
+/**
+ * @brief Feed a stream in the given fragments into a fresh parser
+ * @param bytes Stream
+ * @param cuts Fragment ends in ascending order (the rest of the stream is fed last)
+ * @return std::string Handler calls followed by the statistics
+ */
+static std::string runMidi(const std::vector<uint8_t>& bytes, const std::vector<size_t>& cuts) {
+    uint8_t buf[TEST_SYSEX_SIZE];
+    MidiParser parser(buf, sizeof(buf));
+    parser.attachMessage(onMessage);
+    parser.attachRealtime(onRealtime);
+    parser.attachSysEx(onSysEx);
+
+    midiLog.clear();
+    size_t pos = 0;
+    for (size_t i = 0; i <= cuts.size(); i++) {
+        size_t end = (i < cuts.size()) ? cuts[i] : bytes.size();
+        parser.feed(bytes.data() + pos, (uint16_t)(end - pos));
+        pos = end;
+    }
+
+    const MidiParser::Stats& s = parser.getStats();
+    char stats[96];
+    snprintf(stats, sizeof(stats), "| msg %u rt %u sysex %u overflow %u aborted %u stray %u",
+             (unsigned)s.messages, (unsigned)s.realtime, (unsigned)s.sysex,
+             (unsigned)s.sysex_overflow, (unsigned)s.sysex_aborted, (unsigned)s.stray);
+    return midiLog + stats;
+}
+
+struct MidiCase {
+    const char* name;
+    std::vector<uint8_t> bytes;
+    const char* expected;
+};
+
+static const std::vector<MidiCase> midiCases = {
+    { "running status",
+      { 0x99, 0x24, 0x7F, 0x26, 0x40, 0x89, 0x24, 0x00, 0x26, 0x00 },
+      "M 99 24 7F; M 99 26 40; M 89 24 00; M 89 26 00; | msg 4 rt 0 sysex 0 overflow 0 aborted 0 stray 0" },
+    { "running status, one data byte",
+      { 0xC9, 0x05, 0x06, 0xD0, 0x30, 0x31 },
+      "M C9 05 00; M C9 06 00; M D0 30 00; M D0 31 00; | msg 4 rt 0 sysex 0 overflow 0 aborted 0 stray 0" },
+    { "system common cancels running status",
+      { 0x99, 0x24, 0x7F, 0xF6, 0x26, 0x40, 0xF3, 0x02, 0x03 },
+      "M 99 24 7F; M F6 00 00; M F3 02 00; | msg 3 rt 0 sysex 0 overflow 0 aborted 0 stray 3" },
+    { "data without status",
+      { 0x24, 0x7F, 0x99, 0x24, 0x7F },
+      "M 99 24 7F; | msg 1 rt 0 sysex 0 overflow 0 aborted 0 stray 2" },
+    { "realtime inside note message",
+      { 0x99, 0xF8, 0x24, 0xFE, 0x7F, 0x26, 0xF8, 0x40 },
+      "R F8; R FE; M 99 24 7F; R F8; M 99 26 40; | msg 2 rt 3 sysex 0 overflow 0 aborted 0 stray 0" },
+    { "realtime inside SysEx",
+      { 0xF0, 0x7D, 0xF8, 0x01, 0xFE, 0x01, 0xF7 },
+      "R F8; R FE; S 7D 01 01; | msg 0 rt 2 sysex 1 overflow 0 aborted 0 stray 0" },
+    { "SysEx filling the buffer",
+      { 0xF0, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xF7 },
+      "S 01 02 03 04 05 06 07 08; | msg 0 rt 0 sysex 1 overflow 0 aborted 0 stray 0" },
+    { "overlong SysEx",
+      { 0xF0, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xF8, 0x0A, 0xF7,
+        0xF0, 0x7D, 0x01, 0x01, 0xF7 },
+      "R F8; S 7D 01 01; | msg 0 rt 1 sysex 1 overflow 1 aborted 0 stray 0" },
+    { "SysEx cut off by a status byte",
+      { 0xF0, 0x7D, 0x01, 0x99, 0x24, 0x7F },
+      "M 99 24 7F; | msg 1 rt 0 sysex 0 overflow 0 aborted 1 stray 0" },
+    { "SysEx cancels running status",
+      { 0x99, 0x24, 0x7F, 0xF0, 0x01, 0xF7, 0x26, 0x40 },
+      "M 99 24 7F; S 01; | msg 1 rt 0 sysex 1 overflow 0 aborted 0 stray 2" },
+    { "stray F7",
+      { 0xF7, 0x99, 0x24, 0x7F },
+      "M 99 24 7F; | msg 1 rt 0 sysex 0 overflow 0 aborted 0 stray 0" },
+};
+
+static void testMidiParser() {
+    std::vector<uint8_t> all;   // All cases in a row, the state carries over between them
+
+    for (const MidiCase& c : midiCases) {
+        std::string whole = runMidi(c.bytes, std::vector<size_t>());
+        check(whole == c.expected, c.name, whole, c.expected);
+
+        for (size_t cut = 0; cut <= c.bytes.size(); cut++) {
+            std::string split = runMidi(c.bytes, std::vector<size_t>(1, cut));
+            std::string name = std::string(c.name) + ", split at " + std::to_string(cut);
+            check(split == whole, name.c_str(), split, whole);
+        }
+
+        all.insert(all.end(), c.bytes.begin(), c.bytes.end());
+    }
+
+    std::string whole = runMidi(all, std::vector<size_t>());
+
+    std::vector<size_t> bytewise;
+    for (size_t i = 1; i < all.size(); i++) { bytewise.push_back(i); }
+    std::string split = runMidi(all, bytewise);
+    check(split == whole, "all cases, byte by byte", split, whole);
+
+    srand(28);
+    for (int run = 0; run < 1000; run++) {
+        std::vector<size_t> cuts;
+        size_t pos = 0;
+        for (;;) {
+            pos += rand() % 6; // Empty fragments included
+            if (pos > all.size()) { break; }
+            cuts.push_back(pos);
+        }
+        split = runMidi(all, cuts);
+        std::string name = "all cases, random fragments run " + std::to_string(run);
+        check(split == whole, name.c_str(), split, whole);
+    }
+}
+
+/****************************************************** ShellParser *****************************************************/
+
+/**
+ * @brief Feed bytes into a fresh parser
+ * @param bytes Input
+ * @return std::string Complete lines as "word,word,..." each ended by "; ", followed by the statistics
+ */
+static std::string runShell(const std::string& bytes) {
+    ShellParser parser;
+    std::string log;
+
+    for (size_t i = 0; i < bytes.size(); i++) {
+        if (!parser.feed((uint8_t)bytes[i])) { continue; }
+        for (uint8_t a = 0; a < parser.getArgc(); a++) {
+            if (a) { log += ","; }
+            log += parser.getArgv()[a];
+        }
+        log += "; ";
+    }
+
+    const ShellParser::Stats& s = parser.getStats();
+    char stats[64];
+    snprintf(stats, sizeof(stats), "| lines %u overflow %u ignored %u",
+             (unsigned)s.lines, (unsigned)s.overflow, (unsigned)s.ignored);
+    return log + stats;
+}
+
+struct ShellCase {
+    const char* name;
+    std::string bytes;
+    std::string expected;
+};
+
+static const std::string maxLine(SHELL_LINE_MAX, 'x');  // Longest line that fits
+
+static const std::vector<ShellCase> shellCases = {
+    { "words",                    "pad 3 thr 80\r",                "pad,3,thr,80; | lines 1 overflow 0 ignored 0" },
+    { "extra spaces and tabs",    "  pad\t\t3   thr 80 \t\n",      "pad,3,thr,80; | lines 1 overflow 0 ignored 0" },
+    { "quotes are plain",         "name \"my kit\"\n",             "name,\"my,kit\"; | lines 1 overflow 0 ignored 0" },
+    { "single quotes",            "name 'a b'\n",                  "name,'a,b'; | lines 1 overflow 0 ignored 0" },
+    { "argc limit",               "a b c d e f\n",                 "a,b,c,d,e,f; | lines 1 overflow 0 ignored 0" },
+    { "argc overflow",            "a b c d e f g h\n",             "a,b,c,d,e,f; | lines 1 overflow 0 ignored 0" },
+    { "argc overflow, next line", "a b c d e f g\nstats\n",        "a,b,c,d,e,f; stats; | lines 2 overflow 0 ignored 0" },
+    { "CR LF",                    "stats\r\nhelp\r\n",             "stats; help; | lines 2 overflow 0 ignored 0" },
+    { "LF CR",                    "stats\n\rhelp\n\r",             "stats; help; | lines 2 overflow 0 ignored 0" },
+    { "empty lines",              "\r\n\r\n  \t \r\n",             "| lines 0 overflow 0 ignored 0" },
+    { "no line ending",           "stats",                         "| lines 0 overflow 0 ignored 0" },
+    { "backspace",                "stsx\b\bats\n",                 "stats; | lines 1 overflow 0 ignored 0" },
+    { "DEL",                      "stats x\x7f\x7f\n",             "stats; | lines 1 overflow 0 ignored 0" },
+    { "backspace past start",     "\b\bab\b\b\bx\n",               "x; | lines 1 overflow 0 ignored 0" },
+    { "backspace to empty",       "ab\b\b\n",                      "| lines 0 overflow 0 ignored 0" },
+    { "control and non-ASCII",    "st\x01" "a\x1b" "ts\xc3\xa4\n", "stats; | lines 1 overflow 0 ignored 4" },
+    { "max line length",          maxLine + "\n",                  maxLine + "; | lines 1 overflow 0 ignored 0" },
+    { "max line length + 1",      maxLine + "y\nstats\n",          "stats; | lines 1 overflow 1 ignored 0" },
+    { "backspace after overflow", maxLine + "y\b\b\nstats\n",      "stats; | lines 1 overflow 1 ignored 0" },
+    { "backspace within limit",   maxLine + "\by\n",               maxLine.substr(1) + "y; | lines 1 overflow 0 ignored 0" },
+};
+
+static void testShellParser() {
+    for (const ShellCase& c : shellCases) {
+        std::string got = runShell(c.bytes);
+        check(got == c.expected, c.name, got, c.expected);
+    }
+
+    struct { const char* word; const char* keyword; bool expected; } matches[] = {
+        { "stats", "stats", true }, { "STATS", "stats", true }, { "StAtS", "stats", true },
+        { "stat", "stats", false }, { "statss", "stats", false }, { "", "stats", false },
+    };
+    for (size_t i = 0; i < sizeof(matches) / sizeof(matches[0]); i++) {
+        bool got = ShellParser::match(matches[i].word, matches[i].keyword);
+        std::string name = std::string("match ") + matches[i].word;
+        check(got == matches[i].expected, name.c_str(), got ? "true" : "false", matches[i].expected ? "true" : "false");
+    }
+
+    struct { const char* word; bool ok; uint16_t value; } numbers[] = {
+        { "0", true, 0 }, { "80", true, 80 }, { "65535", true, 65535 }, { "0065535", true, 65535 },
+        { "65536", false, 7 }, { "", false, 7 }, { "-1", false, 7 }, { "12a", false, 7 }, { "99999999999", false, 7 },
+    };
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++) {
+        uint16_t value = 7; // Untouched on error
+        bool ok = ShellParser::toUInt16(numbers[i].word, &value);
+        std::string name = std::string("toUInt16 ") + numbers[i].word;
+        check(ok == numbers[i].ok && value == numbers[i].value, name.c_str(),
+              std::to_string(ok) + " " + std::to_string(value),
+              std::to_string(numbers[i].ok) + " " + std::to_string(numbers[i].value));
+    }
+}
+
+int main() {
+    testMidiParser();
+    testShellParser();
+
+    printf("parser-test: %d checks, %d failed\n", checks, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file sim.h
+ * @brief Host simulation of the drumkit board (virtual clock and peripherals)
+ *
+ * The simulator runs the unmodified Components layer on Linux against the
+ * HAL shim in include/stm32f4xx_hal.h:
+ * - Virtual clock: a 64-bit cycle counter at SIM_CORE_CLOCK. Every read of
+ *   DWT->CYCCNT or HAL_GetTick() costs SIM_READ_CYCLES, HAL_Delay() and the
+ *   blocking transfers advance it by their duration. Nothing depends on the
+ *   host speed, so a run is fully deterministic.
+ * - Interrupts: timed events (DMA completions, MIDI ACK, shell input) fire
+ *   when the clock passes them, never while PRIMASK is set or inside
+ *   another event.
+ * - ADC: the buffers given to HAL_ADC_Start_DMA() are rewritten from the
+ *   replay source once per sample period.
+ * - I2C: every transaction is fed to an SSD1306 model and counted.
+ * - UART: USART2 bytes are the MIDI output, USART1 DMA bytes the debug log
+ *   stream, USART1 RX can be fed with shell commands.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <stdio.h>
+
+#define SIM_CORE_CLOCK 168000000UL      // Virtual core clock (Hz)
+#define SIM_READ_CYCLES 42              // Clock cost of one DWT / tick read (0.25 us)
+#define SIM_MIDI_ACK_US 20              // CH345 ACK delay after the end of a MIDI byte
+#define SIM_OLED_ADDR 0x78              // SSD1306 8-bit write address
+
+#define SIM_PAD_NUM 10                  // ADC channels, Pad::PadID order
+
+typedef void (*SimEventFunc)(void* arg);
+
+/**
+ * @brief Convert milliseconds / microseconds to virtual clock cycles
+ */
+static inline uint64_t sim_ms(double ms) { return (uint64_t)(ms * (SIM_CORE_CLOCK / 1000)); }
+static inline uint64_t sim_us(double us) { return (uint64_t)(us * (SIM_CORE_CLOCK / 1000000)); }
+
+/**
+ * @brief Get the virtual time without advancing it
+ * @return uint64_t Cycles since start
+ */
+uint64_t sim_now();
+
+/**
+ * @brief Advance the virtual clock and fire due events
+ * @param cycles Cycles to advance
+ */
+void sim_advance(uint64_t cycles);
+
+/**
+ * @brief Schedule an event (interrupt)
+ * @param when Absolute time (cycles)
+ * @param fn Handler
+ * @param arg Handler argument
+ */
+void sim_at(uint64_t when, SimEventFunc fn, void* arg);
+
+/**
+ * @brief Set the time at which the simulation ends (the process exits)
+ * @param when Absolute time (cycles)
+ */
+void sim_set_end(uint64_t when);
+
+/**
+ * @brief Replay source: ten raw ADC values at a point in time
+ *
+ * Set by sim_main.cpp, sampled once per ADC period (the pad scan rate).
+ */
+typedef void (*SimAdcSource)(uint64_t now, uint16_t* values);
+void sim_set_adc_source(SimAdcSource source, uint64_t period);
+
+/**
+ * @brief Input pin levels (button, MIDI link) as a function of time
+ *
+ * Returns -1 for pins that read back their output latch.
+ */
+typedef int (*SimInputSource)(uint64_t now, uint8_t port, uint16_t pin);
+void sim_set_input_source(SimInputSource source);
+
+/**
+ * @brief Push bytes into the USART1 RX DMA ring (shell input)
+ * @param data Bytes
+ * @param len Length
+ * @return uint16_t Bytes accepted (0 if the reception is not running)
+ */
+uint16_t sim_uart1_rx(const uint8_t* data, uint16_t len);
+
+/**
+ * @brief Push bytes into the USART2 RX DMA ring (MIDI input)
+ * @param data Bytes
+ * @param len Length
+ * @return uint16_t Bytes accepted (0 if the reception is not running)
+ */
+uint16_t sim_uart2_rx(const uint8_t* data, uint16_t len);
+
+/**
+ * @brief Output files (any may be NULL)
+ */
+struct SimOutputs {
+    FILE* midi;                         // Decoded MIDI messages with timestamps
+    FILE* uart1;                        // Raw debug UART stream (see Tools/trace_decode.py)
+    FILE* oled;                         // Changed display frames as text
+    FILE* i2c;                          // One line per I2C transaction
+};
+
+void sim_set_outputs(const SimOutputs& outputs, double frame_ms);
+
+/**
+ * @brief Run totals, printed by the summary
+ */
+struct SimStats {
+    uint32_t midi_bytes;
+    uint32_t note_on;
+    uint32_t note_off;
+    uint32_t midi_other;
+    uint32_t uart1_bytes;
+    uint32_t i2c_transactions;
+    uint32_t i2c_bytes;                 // Bytes on the bus incl. address bytes
+    uint32_t i2c_busy;                  // Calls refused with HAL_BUSY
+    uint64_t i2c_busy_cycles;           // Time the bus was busy
+    uint32_t frame_periods;             // Display frame periods elapsed
+    uint32_t frames_changed;            // Periods with a changed display
+    uint32_t i2c_bytes_max_period;      // Most bus bytes in one frame period
+    uint32_t resets;                    // NVIC_SystemReset() calls
+};
+
+const SimStats& sim_stats();
+
+/**
+ * @brief Write the run summary and exit (called at the end time)
+ */
+void sim_finish() __attribute__((noreturn));
+
+/**
+ * @brief SSD1306 model (sim_oled.cpp)
+ */
+void sim_oled_write(const uint8_t* data, uint16_t len);     // One I2C transaction (bytes after the address)
+bool sim_oled_frame(FILE* out, double t_ms);                // Dump the panel if it changed since the last call
@@ -0,0 +1,538 @@
+/**
+ * @file sim_hal.cpp
+ * @brief HAL shim implementation on the virtual clock (see sim.h)
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "sim.h"
+#include "main.h"
+#include <queue>
+#include <string>
+#include <vector>
+
+extern "C" {
+
+GPIO_TypeDef sim_gpio[3] = { { 0, 0 }, { 0, 1 }, { 0, 2 } };
+DWT_Type sim_dwt;
+CoreDebug_Type sim_coredebug;
+uint32_t SystemCoreClock = SIM_CORE_CLOCK;
+
+DMA_HandleTypeDef hdma_usart1_rx = { 0, 0, 0 };
+DMA_HandleTypeDef hdma_usart2_rx = { 0, 0, 0 };
+
+UART_HandleTypeDef huart1 = { USART1, { 115200 }, 0, nullptr, &hdma_usart1_rx, HAL_UART_STATE_READY, HAL_UART_STATE_READY };
+UART_HandleTypeDef huart2 = { USART2, { 31250 }, 0, nullptr, &hdma_usart2_rx, HAL_UART_STATE_READY, HAL_UART_STATE_READY };
+I2C_HandleTypeDef hi2c1 = { I2C1, { 400000 }, 0, nullptr, nullptr, HAL_I2C_STATE_READY };
+ADC_HandleTypeDef hadc1 = { ADC1, 0 };
+ADC_HandleTypeDef hadc2 = { ADC2, 0 };
+ADC_HandleTypeDef hadc3 = { ADC3, 0 };
+
+} // extern "C"
+
+/**
+ * @brief Pending interrupt
+ */
+struct SimEvent {
+    uint64_t when;
+    uint64_t seq;                       // Keeps events of the same time in order
+    SimEventFunc fn;
+    void* arg;
+
+    bool operator>(const SimEvent& other) const {
+        return (when != other.when) ? (when > other.when) : (seq > other.seq);
+    }
+};
+
+/**
+ * @brief Circular RX DMA state of one UART
+ */
+struct SimRxDma {
+    uint8_t* buf;
+    uint16_t size;
+    uint16_t pos;
+    bool enabled;                       // DMA stream running (until aborted)
+    bool receiving;                     // UART feeds the stream (cleared by HAL_UART_Init)
+};
+
+static std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> events;
+static uint64_t now = 0;
+static uint64_t endTime = UINT64_MAX;
+static uint64_t eventSeq = 0;
+static uint32_t cycleOffset = 0;        // DWT->CYCCNT = now + offset (CYCCNT writes)
+static uint32_t primask = 0;
+static bool inIrq = false;
+
+static SimAdcSource adcSource = nullptr;
+static uint64_t adcPeriod = 0;
+static uint64_t adcIndex = UINT64_MAX;
+static uint16_t* adcBuf[3] = { nullptr, nullptr, nullptr };
+static uint32_t adcLen[3] = { 0, 0, 0 };
+
+static SimInputSource inputSource = nullptr;
+
+static SimRxDma uart1Rx = { nullptr, 0, 0, false, false };
+static SimRxDma uart2Rx = { nullptr, 0, 0, false, false };
+
+static SimOutputs outputs = { nullptr, nullptr, nullptr, nullptr };
+static uint64_t framePeriod = 0;
+static uint64_t nextFrame = UINT64_MAX;
+static uint32_t periodI2cBytes = 0;
+
+static uint8_t midiMsg[3];
+static uint8_t midiLen = 0;
+static uint8_t midiNeed = 0;
+static std::string midiSysEx;           // Hex of the SysEx frame being sent, empty if none
+
+static SimStats stats;
+
+static double nowMs() { return (double)now * 1000.0 / SIM_CORE_CLOCK; }
+
+/**
+ * @brief Write the current replay row into the running ADC DMA buffers
+ *
+ * Values in Pad::PadID order: ADC1 holds pads 0-3, ADC2 4-6, ADC3 7-9.
+ */
+static void updateAdc() {
+    if (!adcSource || adcPeriod == 0) { return; }
+    uint64_t index = now / adcPeriod;
+    if (index == adcIndex) { return; }
+    adcIndex = index;
+
+    uint16_t values[SIM_PAD_NUM];
+    adcSource(now, values);
+
+    static const uint8_t first[3] = { 0, 4, 7 };
+    for (uint8_t adc = 0; adc < 3; adc++) {
+        for (uint32_t i = 0; adcBuf[adc] && i < adcLen[adc] && first[adc] + i < SIM_PAD_NUM; i++) {
+            adcBuf[adc][i] = values[first[adc] + i];
+        }
+    }
+}
+
+/**
+ * @brief Close the display frame periods passed by the clock
+ */
+static void updateFrames() {
+    while (now >= nextFrame) {
+        stats.frame_periods++;
+        if (periodI2cBytes > stats.i2c_bytes_max_period) { stats.i2c_bytes_max_period = periodI2cBytes; }
+        periodI2cBytes = 0;
+        if (sim_oled_frame(outputs.oled, (double)nextFrame * 1000.0 / SIM_CORE_CLOCK)) {
+            stats.frames_changed++;
+        }
+        nextFrame += framePeriod;
+    }
+}
+
+uint64_t sim_now() {
+    return now;
+}
+
+void sim_advance(uint64_t cycles) {
+    uint64_t target = now + cycles;
+
+    while (!events.empty() && primask == 0 && !inIrq && events.top().when <= target) {
+        SimEvent ev = events.top();
+        events.pop();
+        if (ev.when > now) { now = ev.when; }
+        updateAdc();
+        inIrq = true;
+        ev.fn(ev.arg);
+        inIrq = false;
+    }
+    if (target > now) { now = target; }
+
+    updateAdc();
+    updateFrames();
+    if (now >= endTime && !inIrq) { sim_finish(); }
+}
+
+void sim_at(uint64_t when, SimEventFunc fn, void* arg) {
+    SimEvent ev = { when, eventSeq++, fn, arg };
+    events.push(ev);
+}
+
+void sim_set_end(uint64_t when) {
+    endTime = when;
+}
+
+void sim_set_adc_source(SimAdcSource source, uint64_t period) {
+    adcSource = source;
+    adcPeriod = period;
+    adcIndex = UINT64_MAX;
+}
+
+void sim_set_input_source(SimInputSource source) {
+    inputSource = source;
+}
+
+void sim_set_outputs(const SimOutputs& out, double frame_ms) {
+    outputs = out;
+    framePeriod = sim_ms(frame_ms);
+    nextFrame = now + framePeriod;
+}
+
+const SimStats& sim_stats() {
+    return stats;
+}
+
+/**
+ * @brief Write received bytes into a running RX DMA ring
+ */
+static uint16_t rxWrite(SimRxDma& rx, DMA_HandleTypeDef* hdma, const uint8_t* data, uint16_t len) {
+    if (!rx.enabled || !rx.receiving) { return 0; }
+    for (uint16_t i = 0; i < len; i++) {
+        rx.buf[rx.pos] = data[i];
+        rx.pos = (rx.pos + 1) % rx.size;
+    }
+    hdma->NDTR = rx.size - rx.pos;
+    return len;
+}
+
+uint16_t sim_uart1_rx(const uint8_t* data, uint16_t len) {
+    return rxWrite(uart1Rx, &hdma_usart1_rx, data, len);
+}
+
+uint16_t sim_uart2_rx(const uint8_t* data, uint16_t len) {
+    return rxWrite(uart2Rx, &hdma_usart2_rx, data, len);
+}
+
+/**
+ * @brief Collect a SysEx output frame, logged as one line when it ends
+ * @return true if the byte belonged to a frame
+ */
+static bool midiSysExByte(uint8_t byte) {
+    char hex[4];
+    snprintf(hex, sizeof(hex), " %02X", byte);
+
+    if (byte == 0xF0) {
+        midiSysEx = hex;
+        return true;
+    }
+    if (midiSysEx.empty()) { return false; }
+    if (!(byte & 0x80)) {
+        midiSysEx += hex;
+        return true;
+    }
+
+    // F7 or any other status byte ends the frame
+    bool complete = (byte == 0xF7);
+    if (complete) { midiSysEx += hex; }
+    stats.midi_other++;
+    if (outputs.midi) {
+        fprintf(outputs.midi, "%10.3f%s  SysEx%s\n", nowMs(), midiSysEx.c_str(), complete ? "" : " (broken off)");
+    }
+    midiSysEx.clear();
+    midiLen = 0;
+    return complete;
+}
+
+/**
+ * @brief Decode and log one MIDI output byte
+ */
+static void midiByte(uint8_t byte) {
+    stats.midi_bytes++;
+    if (byte >= 0xF8) { return; } // Realtime, not used by the firmware
+    if (midiSysExByte(byte)) { return; }
+
+    if (byte & 0x80) {
+        midiMsg[0] = byte;
+        midiLen = 1;
+        uint8_t type = byte & 0xF0;
+        midiNeed = (type == 0xC0 || type == 0xD0) ? 2 : (byte >= 0xF0 ? 1 : 3);
+    } else if (midiLen == 0 || midiNeed == 0) {
+        return; // Data without status
+    } else {
+        if (midiLen >= midiNeed) { midiLen = 1; } // Running status
+        midiMsg[midiLen++] = byte;
+    }
+    if (midiLen < midiNeed) { return; }
+
+    uint8_t type = midiMsg[0] & 0xF0;
+    uint8_t channel = (midiMsg[0] & 0x0F) + 1;
+    bool on = (type == 0x90 && midiMsg[2] > 0);
+    bool off = (type == 0x80 || (type == 0x90 && midiMsg[2] == 0));
+    on ? stats.note_on++ : (off ? stats.note_off++ : stats.midi_other++);
+
+    if (!outputs.midi) { return; }
+    fprintf(outputs.midi, "%10.3f", nowMs());
+    for (uint8_t i = 0; i < 3; i++) {
+        (i < midiNeed) ? fprintf(outputs.midi, " %02X", midiMsg[i]) : fprintf(outputs.midi, "   ");
+    }
+    if (on || off) {
+        fprintf(outputs.midi, "  %s ch%u note %u vel %u\n", on ? "NoteOn " : "NoteOff", channel, midiMsg[1], midiMsg[2]);
+    } else {
+        fprintf(outputs.midi, "\n");
+    }
+}
+
+/**
+ * @brief Cycles one UART frame of n bytes takes (8N1)
+ */
+static uint64_t uartCycles(const UART_HandleTypeDef* huart, uint32_t n) {
+    return (uint64_t)n * 10 * SIM_CORE_CLOCK / huart->Init.BaudRate;
+}
+
+/**
+ * @brief Cycles one I2C write of n bytes (plus the address) takes
+ */
+static uint64_t i2cCycles(const I2C_HandleTypeDef* hi2c, uint32_t n) {
+    return (uint64_t)((n + 1) * 9 + 2) * SIM_CORE_CLOCK / hi2c->Init.ClockSpeed;
+}
+
+/**
+ * @brief Count and decode one I2C write
+ * @return true if the display acknowledged its address
+ */
+static bool i2cWrite(I2C_HandleTypeDef* hi2c, uint16_t addr, const uint8_t* data, uint16_t len) {
+    stats.i2c_transactions++;
+    stats.i2c_bytes += len + 1;
+    stats.i2c_busy_cycles += i2cCycles(hi2c, len);
+    periodI2cBytes += len + 1;
+
+    if (outputs.i2c) {
+        fprintf(outputs.i2c, "%10.3f %02X %4u :", nowMs(), addr, len);
+        for (uint16_t i = 0; i < len && i < 8; i++) { fprintf(outputs.i2c, " %02X", data[i]); }
+        fprintf(outputs.i2c, (len > 8) ? " ...\n" : "\n");
+    }
+
+    if (addr != SIM_OLED_ADDR) { return false; }
+    sim_oled_write(data, len);
+    return true;
+}
+
+static void midiAckEvent(void* arg) {
+    (void)arg;
+    HAL_GPIO_EXTI_Callback(CH345_ACK_IT_Pin);
+}
+
+static void uartTxDoneEvent(void* arg) {
+    UART_HandleTypeDef* huart = static_cast<UART_HandleTypeDef*>(arg);
+    huart->gState = HAL_UART_STATE_READY;
+    HAL_UART_TxCpltCallback(huart);
+}
+
+static void i2cTxDoneEvent(void* arg) {
+    I2C_HandleTypeDef* hi2c = static_cast<I2C_HandleTypeDef*>(arg);
+    hi2c->State = HAL_I2C_STATE_READY;
+    if (hi2c->ErrorCode) {
+        HAL_I2C_ErrorCallback(hi2c);
+    } else {
+        HAL_I2C_MasterTxCpltCallback(hi2c);
+    }
+}
+
+extern "C" {
+
+uint32_t sim_cycles(void) {
+    sim_advance(SIM_READ_CYCLES);
+    return (uint32_t)now + cycleOffset;
+}
+
+void sim_set_cycles(uint32_t cycles) {
+    cycleOffset = cycles - (uint32_t)now;
+}
+
+uint32_t sim_get_primask(void) {
+    return primask;
+}
+
+void sim_set_primask(uint32_t value) {
+    primask = value;
+    if (primask == 0) { sim_advance(0); } // Pending interrupts run now
+}
+
+uint32_t HAL_GetTick(void) {
+    sim_advance(SIM_READ_CYCLES);
+    return (uint32_t)(now / (SIM_CORE_CLOCK / 1000));
+}
+
+void HAL_Delay(uint32_t Delay) {
+    sim_advance(sim_ms(Delay + 1)); // HAL adds one tick of wait
+}
+
+void NVIC_SystemReset(void) {
+    stats.resets++;
+    fprintf(stderr, "sim: NVIC_SystemReset() at %.3f ms\n", nowMs());
+    sim_finish();
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    int level = inputSource ? inputSource(now, GPIOx->index, GPIO_Pin) : -1;
+    if (level < 0) { level = (GPIOx->ODR & GPIO_Pin) ? 1 : 0; }
+    return level ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    if (PinState == GPIO_PIN_SET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= (uint16_t)~GPIO_Pin;
+    }
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    GPIOx->ODR ^= GPIO_Pin;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length) {
+    uint8_t adc = (uint8_t)(hadc->Instance - ADC1);
+    if (adc >= 3 || adcBuf[adc]) { return HAL_BUSY; }
+    adcBuf[adc] = reinterpret_cast<uint16_t*>(pData);
+    adcLen[adc] = Length;
+    adcIndex = UINT64_MAX; // Fill the new buffer at the next clock step
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc) {
+    uint8_t adc = (uint8_t)(hadc->Instance - ADC1);
+    if (adc >= 3) { return HAL_ERROR; }
+    adcBuf[adc] = nullptr;
+    adcLen[adc] = 0;
+    return HAL_OK;
+}
+
+/**
+ * @brief Blocking transmit: USART2 is the MIDI output (CH345 ACKs each byte)
+ */
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    (void)Timeout;
+    if (huart->gState != HAL_UART_STATE_READY) { return HAL_BUSY; }
+
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    for (uint16_t i = 0; i < Size; i++) {
+        if (huart->Instance == USART2) {
+            midiByte(pData[i]);
+        } else {
+            stats.uart1_bytes++;
+            if (outputs.uart1) { fputc(pData[i], outputs.uart1); }
+        }
+    }
+    sim_advance(uartCycles(huart, Size));
+    huart->gState = HAL_UART_STATE_READY;
+
+    bool linked = (HAL_GPIO_ReadPin(USB_RDY_GPIO_Port, USB_RDY_Pin) == GPIO_PIN_RESET);
+    if (huart->Instance == USART2 && linked) {
+        sim_at(now + sim_us(SIM_MIDI_ACK_US), midiAckEvent, nullptr);
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief DMA transmit: USART1 is the debug log / wave stream
+ */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size) {
+    if (huart->gState != HAL_UART_STATE_READY) { return HAL_BUSY; }
+
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    if (huart->Instance == USART1) {
+        stats.uart1_bytes += Size;
+        if (outputs.uart1) { fwrite(pData, 1, Size, outputs.uart1); }
+    } else {
+        for (uint16_t i = 0; i < Size; i++) { midiByte(pData[i]); }
+    }
+    sim_at(now + uartCycles(huart, Size), uartTxDoneEvent, huart);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+    SimRxDma& rx = (huart->Instance == USART1) ? uart1Rx : uart2Rx;
+    if (huart->RxState != HAL_UART_STATE_READY || rx.enabled) { return HAL_BUSY; }
+
+    rx.buf = pData;
+    rx.size = Size;
+    rx.pos = 0;
+    rx.enabled = true;
+    rx.receiving = true;
+    huart->hdmarx->NDTR = Size;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart) {
+    SimRxDma& rx = (huart->Instance == USART1) ? uart1Rx : uart2Rx;
+    rx.enabled = false;
+    rx.receiving = false;
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+/**
+ * @brief Re-init (baud change): the UART stops feeding the RX DMA, the stream itself keeps running
+ */
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart) {
+    SimRxDma& rx = (huart->Instance == USART1) ? uart1Rx : uart2Rx;
+    rx.receiving = false;
+    huart->ErrorCode = 0;
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    (void)MemAddSize;
+    (void)Timeout;
+    if (hi2c->State != HAL_I2C_STATE_READY) {
+        stats.i2c_busy++;
+        return HAL_BUSY;
+    }
+
+    std::vector<uint8_t> bytes(1, (uint8_t)MemAddress);
+    bytes.insert(bytes.end(), pData, pData + Size);
+
+    hi2c->State = HAL_I2C_STATE_BUSY_TX;
+    bool ack = i2cWrite(hi2c, DevAddress, bytes.data(), (uint16_t)bytes.size());
+    sim_advance(i2cCycles(hi2c, ack ? bytes.size() : 0));
+    hi2c->State = HAL_I2C_STATE_READY;
+    return ack ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+                                          uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    (void)Timeout;
+    if (hi2c->State != HAL_I2C_STATE_READY) {
+        stats.i2c_busy++;
+        return HAL_BUSY;
+    }
+
+    hi2c->State = HAL_I2C_STATE_BUSY_TX;
+    bool ack = i2cWrite(hi2c, DevAddress, pData, Size);
+    sim_advance(i2cCycles(hi2c, ack ? Size : 0));
+    hi2c->State = HAL_I2C_STATE_READY;
+    return ack ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+                                              uint8_t *pData, uint16_t Size) {
+    if (hi2c->State != HAL_I2C_STATE_READY) {
+        stats.i2c_busy++;
+        return HAL_BUSY;
+    }
+
+    hi2c->State = HAL_I2C_STATE_BUSY_TX;
+    bool ack = i2cWrite(hi2c, DevAddress, pData, Size);
+    hi2c->ErrorCode = ack ? 0 : HAL_I2C_ERROR_AF;
+    sim_at(now + i2cCycles(hi2c, ack ? Size : 0), i2cTxDoneEvent, hi2c);
+    return HAL_OK;
+}
+
+/* Default callbacks, overridden by the application ------------------------*/
+
+__attribute__((weak)) void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) { (void)GPIO_Pin; }
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) { (void)huart; }
+__attribute__((weak)) void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) { (void)huart; }
+__attribute__((weak)) void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) { (void)hi2c; }
+__attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) { (void)hi2c; }
+__attribute__((weak)) void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc) { (void)hadc; }
+
+void Error_Handler(void) {
+    fprintf(stderr, "sim: Error_Handler() at %.3f ms\n", nowMs());
+    sim_finish();
+}
+
+} // extern "C"
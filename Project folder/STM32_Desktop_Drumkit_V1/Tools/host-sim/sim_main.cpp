@@ -0,0 +1,389 @@
+/**
+ * @file sim_main.cpp
+ * @brief Host simulation driver: replay sources, scripted inputs and the run summary
+ *
+ * Runs cpp_main() of the firmware on the virtual board (see sim.h). The ADC
+ * is fed from a recorded trace (CSV of Tools/wave_decode.py) and/or from
+ * synthetic hits, the button and the MIDI link follow a script, and the
+ * run ends after a fixed virtual time. All times are virtual milliseconds
+ * since reset; the button is pressed for power on at 10-810 ms and the
+ * main loop starts about 2.9 s in (welcome screen), so put hits after 3000.
+ *
+ *     drumkit-sim [options]
+ *       --trace <csv>          Replay a recorded ADC trace (frame index + ten values per row)
+ *       --rate <hz>            Trace frame rate (default 10000)
+ *       --trace-at <ms>        Start of the trace (default 3000)
+ *       --hit <pad>@<ms>[:<peak>]  Synthetic hit (pad name or index, peak raw ADC, default 3000)
+ *       --key <ms>:<len>       Press the button (single click ~100, long press >= 600)
+ *       --unplug <ms>:<len>    Take the MIDI link down
+ *       --cmd <ms>:<line>      Type a shell command on the debug UART
+ *       --midi-in <ms>:<hex>   Send bytes to the MIDI input, e.g. 2000:F07D0101F7 (dump request)
+ *       --log-level <n>        Debug log level at reset (4 = DEBUG, as the "Debug Log" switch; the menu resets it)
+ *       --duration <ms>        Run time (default: last scripted event + 1000, at least 4000)
+ *       --frame-ms <ms>        Display frame period for the I2C statistics (default 40)
+ *       --out <dir>            Output directory (default sim-out)
+ *       --i2c-log              Also write one line per I2C transaction
+ *       --seed <n>             Noise seed of the synthetic source
+ *
+ * Output files (deterministic, diff them between two builds):
+ * - midi.txt: MIDI messages with their time
+ * - oled.txt: every changed display frame as 128 x 32 text
+ * - uart1.bin: debug UART stream (Tools/trace_decode.py)
+ * - i2c.txt: I2C transactions (--i2c-log)
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "sim.h"
+#include "cpp_main.h"
+#include "pad.h"
+#include "health.h"
+#include "logger.h"
+#include "scheduler.h"
+#include "shell_parser.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/stat.h>
+#include <time.h>
+
+#define SIM_POWER_PRESS_MS 10           // Power on long press start
+#define SIM_POWER_PRESS_LEN 800         // Power on long press length
+#define SIM_TRACE_AT_MS 3000            // Default trace start
+#define SIM_ADC_PERIOD_US 100           // ADC sequence rate (~10 kHz, see cpp_main.cpp)
+#define SIM_NOISE_LSB 6                 // Synthetic noise amplitude (+/- raw ADC)
+#define SIM_HIT_RISE_MS 0.5             // Synthetic hit rise time
+#define SIM_HIT_DECAY_MS 3.0            // Synthetic hit decay time constant
+#define SIM_HIT_RING_HZ 400.0           // Synthetic hit ringing
+#define SIM_HIT_LEN_MS 25.0             // Synthetic hit length
+
+/**
+ * @brief Resting ADC values of the pads (the numbers before the offset in cpp_main.cpp)
+ */
+static const uint16_t restValues[SIM_PAD_NUM] = { 1023, 580, 416, 302, 1629, 1676, 1536, 928, 1322, 1381 };
+
+struct Hit {
+    uint8_t pad;
+    double ms;
+    uint16_t peak;
+};
+
+struct Window {
+    double ms;
+    double len;
+};
+
+struct Command {
+    double ms;
+    std::string line;
+};
+
+struct TraceRow {
+    uint32_t frame;
+    uint16_t values[SIM_PAD_NUM];
+};
+
+static std::vector<Hit> hits;
+static std::vector<Window> keys;
+static std::vector<Window> unplugs;
+static std::vector<Command> commands;
+static std::vector<Command> midiInputs;   // line holds the bytes as hex
+static std::vector<TraceRow> trace;
+static double traceRate = 10000.0;
+static double traceAt = SIM_TRACE_AT_MS;
+static uint32_t noiseState = 1;
+static clock_t hostStart;
+static double durationMs = 0;
+static SimOutputs outputs = { nullptr, nullptr, nullptr, nullptr };
+
+static double toMs(uint64_t cycles) { return (double)cycles * 1000.0 / SIM_CORE_CLOCK; }
+
+static bool inWindow(const std::vector<Window>& windows, double ms) {
+    for (size_t i = 0; i < windows.size(); i++) {
+        if (ms >= windows[i].ms && ms < windows[i].ms + windows[i].len) { return true; }
+    }
+    return false;
+}
+
+/**
+ * @brief Button (active low) and MIDI link (USB_RDY low = connected)
+ */
+static int inputLevel(uint64_t now, uint8_t port, uint16_t pin) {
+    double ms = toMs(now);
+    if (port == KEY_PRESS_GPIO_Port->index && pin == KEY_PRESS_Pin) {
+        return inWindow(keys, ms) ? 0 : 1;
+    }
+    if (port == USB_RDY_GPIO_Port->index && pin == USB_RDY_Pin) {
+        return inWindow(unplugs, ms) ? 1 : 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Synthetic piezo pulse: linear rise, then a ringing exponential decay
+ * @param t Time since the hit start (ms)
+ * @return double Envelope 0..1
+ */
+static double hitShape(double t) {
+    if (t < 0 || t >= SIM_HIT_LEN_MS) { return 0; }
+    if (t < SIM_HIT_RISE_MS) { return t / SIM_HIT_RISE_MS; }
+    double decay = exp(-(t - SIM_HIT_RISE_MS) / SIM_HIT_DECAY_MS);
+    return decay * (0.75 + 0.25 * cos(2.0 * M_PI * SIM_HIT_RING_HZ * (t - SIM_HIT_RISE_MS) / 1000.0));
+}
+
+/**
+ * @brief ADC source: trace row (or resting value) plus synthetic hits and noise
+ */
+static void adcValues(uint64_t now, uint16_t* values) {
+    double ms = toMs(now);
+
+    const TraceRow* row = nullptr;
+    if (!trace.empty() && ms >= traceAt) {
+        uint32_t frame = (uint32_t)((ms - traceAt) * traceRate / 1000.0);
+        if (frame <= trace.back().frame) {
+            auto it = std::upper_bound(trace.begin(), trace.end(), frame,
+                                       [](uint32_t f, const TraceRow& r) { return f < r.frame; });
+            if (it != trace.begin()) { row = &*(it - 1); }
+        }
+    }
+
+    for (uint8_t i = 0; i < SIM_PAD_NUM; i++) {
+        double v;
+        if (row) {
+            v = row->values[i];
+        } else {
+            noiseState = noiseState * 1103515245U + 12345U;
+            v = restValues[i] + (int)((noiseState >> 16) % (2 * SIM_NOISE_LSB + 1)) - SIM_NOISE_LSB;
+        }
+        for (size_t h = 0; h < hits.size(); h++) {
+            if (hits[h].pad != i) { continue; }
+            v += (hits[h].peak - restValues[i]) * hitShape(ms - hits[h].ms);
+        }
+        values[i] = (uint16_t)std::max(0.0, std::min(4095.0, v));
+    }
+}
+
+static void commandEvent(void* arg) {
+    const Command* cmd = static_cast<const Command*>(arg);
+    std::string line = cmd->line + "\r\n";
+    if (sim_uart1_rx(reinterpret_cast<const uint8_t*>(line.data()), (uint16_t)line.size()) == 0) {
+        fprintf(stderr, "sim: shell not receiving at %.3f ms, \"%s\" lost\n", cmd->ms, cmd->line.c_str());
+    }
+}
+
+static void midiInEvent(void* arg) {
+    const Command* in = static_cast<const Command*>(arg);
+    uint8_t bytes[256];
+    uint16_t len = 0;
+    for (size_t i = 0; i + 1 < in->line.size() && len < sizeof(bytes); i += 2) {
+        bytes[len++] = (uint8_t)strtoul(in->line.substr(i, 2).c_str(), nullptr, 16);
+    }
+    if (sim_uart2_rx(bytes, len) == 0) {
+        fprintf(stderr, "sim: MIDI input not receiving at %.3f ms\n", in->ms);
+    }
+}
+
+/**
+ * @brief Load a CSV written by Tools/wave_decode.py (header line, frame index + ten values)
+ */
+static bool loadTrace(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "sim: cannot open %s\n", path);
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        TraceRow row;
+        unsigned v[SIM_PAD_NUM];
+        unsigned frame;
+        int n = sscanf(line, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u", &frame,
+                       &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8], &v[9]);
+        if (n != SIM_PAD_NUM + 1) { continue; } // Header or broken line
+        row.frame = frame;
+        for (uint8_t i = 0; i < SIM_PAD_NUM; i++) { row.values[i] = (uint16_t)std::min(v[i], 4095U); }
+        if (!trace.empty() && row.frame <= trace.back().frame) { continue; }
+        trace.push_back(row);
+    }
+    fclose(f);
+    if (trace.empty()) {
+        fprintf(stderr, "sim: no frames in %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+static bool parsePad(const char* word, uint8_t* out) {
+    uint16_t index;
+    if (ShellParser::toUInt16(word, &index) && index < Pad::PAD_NUM) {
+        *out = (uint8_t)index;
+        return true;
+    }
+    for (uint8_t i = 0; i < Pad::PAD_NUM; i++) {
+        if (ShellParser::match(word, Pad::ID2Str(static_cast<Pad::PadID>(i)))) {
+            *out = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseHit(const char* arg) {
+    char name[16];
+    double ms;
+    unsigned peak = 3000;
+    if (sscanf(arg, "%15[^@]@%lf:%u", name, &ms, &peak) < 2) { return false; }
+    Hit hit = { 0, ms, (uint16_t)std::min(peak, 4095U) };
+    if (!parsePad(name, &hit.pad)) { return false; }
+    hits.push_back(hit);
+    return true;
+}
+
+static bool parseWindow(const char* arg, std::vector<Window>& out) {
+    Window w;
+    if (sscanf(arg, "%lf:%lf", &w.ms, &w.len) != 2) { return false; }
+    out.push_back(w);
+    return true;
+}
+
+static bool parseCommand(const char* arg, std::vector<Command>& out) {
+    const char* colon = strchr(arg, ':');
+    if (!colon) { return false; }
+    Command cmd = { atof(arg), std::string(colon + 1) };
+    out.push_back(cmd);
+    return true;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: drumkit-sim [--trace csv [--rate hz] [--trace-at ms]] [--hit pad@ms[:peak]]...\n"
+            "                   [--key ms:len]... [--unplug ms:len]... [--cmd ms:line]... [--midi-in ms:hex]...\n"
+            "                   [--log-level n] [--duration ms] [--frame-ms ms] [--out dir] [--i2c-log] [--seed n]\n");
+    exit(2);
+}
+
+static FILE* openOutput(const std::string& dir, const char* name, const char* mode) {
+    std::string path = dir + "/" + name;
+    FILE* f = fopen(path.c_str(), mode);
+    if (!f) {
+        fprintf(stderr, "sim: cannot write %s\n", path.c_str());
+        exit(1);
+    }
+    return f;
+}
+
+void sim_finish() {
+    const SimStats& s = sim_stats();
+    double simMs = toMs(sim_now());
+    double hostS = (double)(clock() - hostStart) / CLOCKS_PER_SEC;
+
+    if (outputs.midi) { fclose(outputs.midi); }
+    if (outputs.uart1) { fclose(outputs.uart1); }
+    if (outputs.oled) { fclose(outputs.oled); }
+    if (outputs.i2c) { fclose(outputs.i2c); }
+
+    printf("Simulated %.1f ms in %.2f s host time\n", simMs, hostS);
+    printf("MIDI:  %lu bytes, %lu note on, %lu note off, %lu other (%zu synthetic hits)\n",
+           (unsigned long)s.midi_bytes, (unsigned long)s.note_on, (unsigned long)s.note_off,
+           (unsigned long)s.midi_other, hits.size());
+    printf("UART1: %lu bytes\n", (unsigned long)s.uart1_bytes);
+    printf("I2C:   %lu transactions, %lu bytes, bus busy %.1f%%, %lu busy refusals\n",
+           (unsigned long)s.i2c_transactions, (unsigned long)s.i2c_bytes,
+           simMs > 0 ? toMs(s.i2c_busy_cycles) * 100.0 / simMs : 0.0, (unsigned long)s.i2c_busy);
+    printf("OLED:  %lu of %lu frame periods changed, %.1f bytes/period avg, %lu max\n",
+           (unsigned long)s.frames_changed, (unsigned long)s.frame_periods,
+           s.frame_periods ? (double)s.i2c_bytes / s.frame_periods : 0.0,
+           (unsigned long)s.i2c_bytes_max_period);
+    printf("Loop:  %lu/s, max %lu us\n", (unsigned long)health.getLoopRate(), (unsigned long)health.getLoopMaxUs());
+    for (uint8_t i = 0; i < scheduler.getTaskCount(); i++) {
+        const Scheduler::TaskStats& t = scheduler.getTaskStats(i);
+        printf("Task:  %-7s %8lu slices, WCET %6.1f us, %lu misses\n", scheduler.getTaskName(i),
+               (unsigned long)t.slices, t.wcet_cycles * 1e6 / SIM_CORE_CLOCK, (unsigned long)t.misses);
+    }
+    for (uint8_t i = 0; i < HEALTH_COUNTER_NUM; i++) {
+        HealthCounter c = static_cast<HealthCounter>(i);
+        if (health.getCounter(c)) {
+            printf("Health: %-13s %lu\n", Health::Counter2Str(c), (unsigned long)health.getCounter(c));
+        }
+    }
+    fflush(stdout);
+    exit(s.resets ? 1 : 0);
+}
+
+int main(int argc, char** argv) {
+    std::string outDir = "sim-out";
+    double frameMs = 40;
+    bool i2cLog = false;
+    int logLevel = -1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string opt = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+
+        if (opt == "--i2c-log") { i2cLog = true; continue; }
+        if (!val) { usage(); }
+        i++;
+
+        if (opt == "--trace") { ok = loadTrace(val); }
+        else if (opt == "--rate") { traceRate = atof(val); ok = traceRate > 0; }
+        else if (opt == "--trace-at") { traceAt = atof(val); }
+        else if (opt == "--hit") { ok = parseHit(val); }
+        else if (opt == "--key") { ok = parseWindow(val, keys); }
+        else if (opt == "--unplug") { ok = parseWindow(val, unplugs); }
+        else if (opt == "--cmd") { ok = parseCommand(val, commands); }
+        else if (opt == "--midi-in") { ok = parseCommand(val, midiInputs) && midiInputs.back().line.size() % 2 == 0; }
+        else if (opt == "--log-level") { logLevel = atoi(val); ok = logLevel >= LOG_LVL_NONE && logLevel <= LOG_LVL_DEBUG; }
+        else if (opt == "--duration") { durationMs = atof(val); ok = durationMs > 0; }
+        else if (opt == "--frame-ms") { frameMs = atof(val); ok = frameMs > 0; }
+        else if (opt == "--out") { outDir = val; }
+        else if (opt == "--seed") { noiseState = (uint32_t)strtoul(val, nullptr, 0); }
+        else { ok = false; }
+
+        if (!ok) {
+            fprintf(stderr, "sim: bad option %s %s\n", opt.c_str(), val);
+            usage();
+        }
+    }
+
+    Window power = { SIM_POWER_PRESS_MS, SIM_POWER_PRESS_LEN };
+    keys.push_back(power);
+
+    if (durationMs <= 0) {
+        double last = 0;
+        for (size_t i = 0; i < hits.size(); i++) { last = std::max(last, hits[i].ms); }
+        for (size_t i = 0; i < keys.size(); i++) { last = std::max(last, keys[i].ms + keys[i].len); }
+        for (size_t i = 0; i < unplugs.size(); i++) { last = std::max(last, unplugs[i].ms + unplugs[i].len); }
+        for (size_t i = 0; i < commands.size(); i++) { last = std::max(last, commands[i].ms); }
+        for (size_t i = 0; i < midiInputs.size(); i++) { last = std::max(last, midiInputs[i].ms); }
+        if (!trace.empty()) { last = std::max(last, traceAt + trace.back().frame * 1000.0 / traceRate); }
+        durationMs = std::max(last + 1000.0, 4000.0);
+    }
+
+    mkdir(outDir.c_str(), 0755);
+    outputs.midi = openOutput(outDir, "midi.txt", "w");
+    outputs.oled = openOutput(outDir, "oled.txt", "w");
+    outputs.uart1 = openOutput(outDir, "uart1.bin", "wb");
+    outputs.i2c = i2cLog ? openOutput(outDir, "i2c.txt", "w") : nullptr;
+
+    sim_set_outputs(outputs, frameMs);
+    sim_set_input_source(inputLevel);
+    sim_set_adc_source(adcValues, sim_us(SIM_ADC_PERIOD_US));
+    for (size_t i = 0; i < commands.size(); i++) {
+        sim_at(sim_ms(commands[i].ms), commandEvent, &commands[i]);
+    }
+    for (size_t i = 0; i < midiInputs.size(); i++) {
+        sim_at(sim_ms(midiInputs[i].ms), midiInEvent, &midiInputs[i]);
+    }
+    sim_set_end(sim_ms(durationMs));
+    if (logLevel >= 0) { logger.setLevel((uint8_t)logLevel); }
+
+    hostStart = clock();
+    cpp_main();
+    sim_finish();
+}
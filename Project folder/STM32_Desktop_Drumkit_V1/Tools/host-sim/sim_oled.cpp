@@ -0,0 +1,162 @@
+/**
+ * @file sim_oled.cpp
+ * @brief SSD1306 model for the host simulation (see sim.h)
+ *
+ * Decodes the control byte stream of each I2C transaction (Co / D/C# bits),
+ * the addressing commands of all three memory modes (page, horizontal,
+ * vertical) and the multiplex ratio, and keeps the GDDRAM. Other commands
+ * are parsed for their argument count and otherwise ignored. The panel is
+ * dumped in RAM order: the segment / COM remap commands only mirror the
+ * physical picture, the firmware draws in RAM coordinates.
+ *
+ * @author WilliTourt, willitourt@foxmail.com
+ * @copyright Copyright (c) 2025 by WilliTourt
+ *
+ * @note Comments are mostly written by AI
+ */
+
+#include "sim.h"
+
+#define SSD1306_PAGES 8
+#define SSD1306_COLUMNS 128
+
+/**
+ * @brief SSD1306 controller state
+ */
+struct Ssd1306 {
+    uint8_t ram[SSD1306_PAGES][SSD1306_COLUMNS];
+    uint8_t shown[SSD1306_PAGES][SSD1306_COLUMNS];  // Last dumped frame
+
+    uint8_t mode;                       // 0 horizontal, 1 vertical, 2 page
+    uint8_t column;
+    uint8_t page;
+    uint8_t colStart, colEnd;           // Window (horizontal / vertical mode)
+    uint8_t pageStart, pageEnd;
+    uint8_t mux;                        // Multiplex ratio - 1 (rows - 1)
+    bool on;
+
+    uint8_t cmd[7];                     // Command being collected
+    uint8_t cmdLen;
+    uint8_t cmdNeed;
+
+    uint32_t frames;
+};
+
+static Ssd1306 oled = {
+    { { 0 } }, { { 0 } },
+    2, 0, 0, 0, SSD1306_COLUMNS - 1, 0, SSD1306_PAGES - 1, 63, false,
+    { 0 }, 0, 0,
+    0
+};
+
+/**
+ * @brief Total length of a command from its first byte
+ */
+static uint8_t cmdLength(uint8_t first) {
+    switch (first) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 2;
+        case 0x21: case 0x22: case 0xA3:
+            return 3;
+        case 0x29: case 0x2A:
+            return 6;
+        case 0x26: case 0x27:
+            return 7;
+        default:
+            return 1;
+    }
+}
+
+static void runCommand(const uint8_t* c) {
+    if (c[0] <= 0x0F) {
+        oled.column = (uint8_t)((oled.column & 0xF0) | c[0]);
+    } else if (c[0] <= 0x1F) {
+        oled.column = (uint8_t)((oled.column & 0x0F) | ((c[0] & 0x07) << 4));
+    } else if (c[0] >= 0xB0 && c[0] <= 0xB7) {
+        oled.page = c[0] & 0x07;
+    } else {
+        switch (c[0]) {
+            case 0x20: oled.mode = c[1] & 0x03; break;
+            case 0x21:
+                oled.colStart = c[1] & 0x7F;
+                oled.colEnd = c[2] & 0x7F;
+                oled.column = oled.colStart;
+                break;
+            case 0x22:
+                oled.pageStart = c[1] & 0x07;
+                oled.pageEnd = c[2] & 0x07;
+                oled.page = oled.pageStart;
+                break;
+            case 0xA8: oled.mux = c[1] & 0x3F; break;
+            case 0xAE: oled.on = false; break;
+            case 0xAF: oled.on = true; break;
+            default: break;
+        }
+    }
+}
+
+static void commandByte(uint8_t byte) {
+    if (oled.cmdLen == 0) { oled.cmdNeed = cmdLength(byte); }
+    oled.cmd[oled.cmdLen++] = byte;
+    if (oled.cmdLen >= oled.cmdNeed) {
+        runCommand(oled.cmd);
+        oled.cmdLen = 0;
+    }
+}
+
+/**
+ * @brief Write one GDDRAM byte and advance the address like the controller
+ */
+static void dataByte(uint8_t byte) {
+    oled.ram[oled.page][oled.column] = byte;
+
+    if (oled.mode == 2) { // Page mode: column wraps within the page
+        oled.column = (oled.column + 1) & 0x7F;
+    } else if (oled.mode == 0) {
+        if (oled.column++ >= oled.colEnd) {
+            oled.column = oled.colStart;
+            oled.page = (oled.page >= oled.pageEnd) ? oled.pageStart : oled.page + 1;
+        }
+    } else {
+        if (oled.page++ >= oled.pageEnd) {
+            oled.page = oled.pageStart;
+            oled.column = (oled.column >= oled.colEnd) ? oled.colStart : oled.column + 1;
+        }
+    }
+}
+
+void sim_oled_write(const uint8_t* data, uint16_t len) {
+    uint16_t i = 0; // A command may continue in the next transaction (the menu library sends arguments alone)
+
+    while (i < len) {
+        uint8_t control = data[i++];
+        bool single = (control & 0x80) != 0;    // Co: one byte, then another control byte
+        bool isData = (control & 0x40) != 0;    // D/C#
+
+        uint16_t end = single ? (uint16_t)(i + 1) : len;
+        for (; i < end && i < len; i++) {
+            isData ? dataByte(data[i]) : commandByte(data[i]);
+        }
+    }
+}
+
+bool sim_oled_frame(FILE* out, double t_ms) {
+    uint8_t pages = (uint8_t)((oled.mux + 1 + 7) / 8);
+    if (memcmp(oled.ram, oled.shown, sizeof(oled.ram)) == 0) { return false; }
+    memcpy(oled.shown, oled.ram, sizeof(oled.ram));
+    oled.frames++;
+
+    if (!out) { return true; }
+    fprintf(out, "frame %lu t=%.3f ms%s\n", (unsigned long)oled.frames, t_ms, oled.on ? "" : " (display off)");
+    for (uint8_t row = 0; row < pages * 8; row++) {
+        char line[SSD1306_COLUMNS + 2];
+        for (uint8_t x = 0; x < SSD1306_COLUMNS; x++) {
+            line[x] = (oled.ram[row / 8][x] & (1 << (row % 8))) ? '#' : '.';
+        }
+        line[SSD1306_COLUMNS] = '\n';
+        line[SSD1306_COLUMNS + 1] = '\0';
+        fputs(line, out);
+    }
+    return true;
+}
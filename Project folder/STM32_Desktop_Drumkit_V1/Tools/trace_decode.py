@@ -0,0 +1,257 @@
+#!/usr/bin/env python3
+"""
+Decode the debug UART stream (USART1) of the drumkit.
+
+The stream mixes plain text log lines (LOG_x), binary trace records
+(TRACE_x, see Components/Inc/trace.h) and binary blocks (hit captures).
+Text is passed through, records are formatted with the format strings read
+from the trace_fmt section of the firmware ELF, blocks are summarised
+(Tools/capture_decode.py extracts the captures).
+
+Capture on Linux, then decode:
+
+    stty -F /dev/ttyUSB0 115200 raw -echo
+    cat /dev/ttyUSB0 > dump.bin
+    python3 trace_decode.py build/STM32_Desktop_Drumkit_V1.elf dump.bin
+
+Use "-" as the dump file to read stdin (live: cat /dev/ttyUSB0 | ...).
+The host simulator works the same way: pass build/drumkit-sim and its
+sim-out/uart1.bin.
+No third party packages are needed.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+LEVELS = "EWID"
+BLOCK_TAG = 0x88
+BLOCK_NAMES = {0x01: "hit capture"}
+FMT_SPEC = re.compile(r"%([-+ #0]*)(\d*|\*)?(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+
+def load_trace_fmt(elf_path):
+    """Return the raw bytes of the trace_fmt section (ELF32 or ELF64, little endian)."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF":
+        raise ValueError("%s is not an ELF file" % elf_path)
+    is64 = elf[4] == 2
+    if elf[5] != 1:
+        raise ValueError("big endian ELF is not supported")
+
+    if is64:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+        sh_fmt, name_at, off_at, size_at = "<IIQQQQ", 0, 4, 5
+    else:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+        sh_fmt, name_at, off_at, size_at = "<IIIIII", 0, 4, 5
+
+    def section(i):
+        return struct.unpack_from(sh_fmt, elf, shoff + i * shentsize)
+
+    strtab = section(shstrndx)
+    for i in range(shnum):
+        sh = section(i)
+        start = strtab[off_at] + sh[name_at]
+        name = elf[start:elf.index(b"\0", start)].decode()
+        if name in ("trace_fmt", ".trace_fmt"):  # .trace_fmt: older builds
+            return elf[sh[off_at]:sh[off_at] + sh[size_at]]
+
+    raise ValueError("no trace_fmt section in %s (built without TRACE_ calls?)" % elf_path)
+
+
+def format_record(fmt, args):
+    """printf-style formatting of integer arguments (uint32 bit patterns)."""
+    args = list(args)
+
+    def repl(m):
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        if not args:
+            return "<missing>"
+        value = args.pop(0)
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conv = "d"
+        elif conv == "u":
+            conv = "d"
+        elif conv == "p":
+            flags, conv = "#", "x"
+        elif conv == "s":
+            return "<str@0x%08x>" % value
+        spec = "%" + flags + (width or "") + ("." + prec if prec else "") + conv
+        return spec % value
+
+    return FMT_SPEC.sub(repl, fmt)
+
+
+class Decoder:
+    """
+    Incremental stream decoder, feed() bytes and get text lines back.
+    Binary blocks go to on_block(type, payload) if set, the returned
+    string (if any) is added to the output.
+    """
+
+    def __init__(self, fmt_section, clock_hz, on_block=None):
+        self.fmt_section = fmt_section or b""
+        self.clock_hz = clock_hz
+        self.on_block = on_block
+        self.blocks = 0
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.time = None        # 64-bit cycle count, None until the first absolute record
+        self.records = 0
+        self.errors = 0
+
+    def _fmt(self, fmt_id):
+        if fmt_id >= len(self.fmt_section):
+            return None
+        end = self.fmt_section.find(b"\0", fmt_id)
+        return self.fmt_section[fmt_id:end].decode(errors="replace")
+
+    @staticmethod
+    def _varint(data, pos):
+        value, shift = 0, 0
+        while True:
+            if pos >= len(data):
+                return None, pos
+            b = data[pos]
+            pos += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return value & 0xFFFFFFFF, pos
+            if shift > 35:
+                raise ValueError("varint too long")
+
+    def _record(self, data, pos):
+        """Parse one record at pos, return (line, new pos) or (None, pos) if incomplete."""
+        tag = data[pos]
+        absolute = bool(tag & 0x40)
+        level = LEVELS[(tag >> 4) & 0x03]
+        argc = tag & 0x07
+        p = pos + 1
+
+        if len(data) < p + 2:
+            return None, pos
+        fmt_id = data[p] | (data[p + 1] << 8)
+        p += 2
+
+        if absolute:
+            if len(data) < p + 4:
+                return None, pos
+            stamp, = struct.unpack_from("<I", data, p)
+            p += 4
+        else:
+            stamp, p = self._varint(data, p)
+            if stamp is None:
+                return None, pos
+
+        args = []
+        for _ in range(argc):
+            value, p = self._varint(data, p)
+            if value is None:
+                return None, pos
+            args.append(value)
+
+        if absolute:
+            if self.time is None:
+                self.time = stamp
+            else:
+                t = (self.time & ~0xFFFFFFFF) | stamp
+                if t < self.time:
+                    t += 1 << 32
+                self.time = t
+        elif self.time is not None:
+            self.time += stamp
+
+        fmt = self._fmt(fmt_id)
+        if fmt is None:
+            self.errors += 1
+            text = "<unknown trace id 0x%04x> %s" % (fmt_id, " ".join(str(a) for a in args))
+        else:
+            text = format_record(fmt, args)
+        self.records += 1
+
+        stamp_str = "%12.6f" % (self.time / self.clock_hz) if self.time is not None else "           ?"
+        if level in "EW":
+            text = level + ": " + text
+        return "[%s] %s" % (stamp_str, text), p
+
+    def feed(self, chunk):
+        self.buf += chunk
+        out = []
+        pos = 0
+        while pos < len(self.buf):
+            b = self.buf[pos]
+            if b < 0x80:
+                if b == 0x0A:
+                    out.append(self.text.decode(errors="replace").rstrip("\r"))
+                    self.text.clear()
+                else:
+                    self.text.append(b)
+                pos += 1
+                continue
+
+            if b == BLOCK_TAG:
+                if len(self.buf) < pos + 4:
+                    break
+                btype = self.buf[pos + 1]
+                blen = self.buf[pos + 2] | (self.buf[pos + 3] << 8)
+                if len(self.buf) < pos + 4 + blen:
+                    break
+                payload = bytes(self.buf[pos + 4:pos + 4 + blen])
+                self.blocks += 1
+                line = self.on_block(btype, payload) if self.on_block else None
+                if line is None and not self.on_block:
+                    line = "<%s block, %d bytes>" % (BLOCK_NAMES.get(btype, "type 0x%02x" % btype), blen)
+                if line is not None:
+                    out.append(line)
+                pos += 4 + blen
+                continue
+
+            try:
+                line, new_pos = self._record(self.buf, pos)
+            except ValueError:
+                self.errors += 1
+                pos += 1        # Garbage, skip one byte and resync
+                continue
+            if line is None:
+                break           # Incomplete record, wait for more data
+            out.append(line)
+            pos = new_pos
+
+        del self.buf[:pos]
+        return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode drumkit debug UART dumps (text log + binary trace)")
+    parser.add_argument("elf", help="Firmware ELF (for the trace_fmt section)")
+    parser.add_argument("dump", help="Captured UART bytes, '-' for stdin")
+    parser.add_argument("--clock", type=float, default=168e6, help="DWT clock in Hz (default 168e6)")
+    opts = parser.parse_args()
+
+    decoder = Decoder(load_trace_fmt(opts.elf), opts.clock)
+    src = sys.stdin.buffer if opts.dump == "-" else open(opts.dump, "rb")
+    with src:
+        while True:
+            chunk = src.read1(4096) if hasattr(src, "read1") else src.read(4096)
+            if not chunk:
+                break
+            for line in decoder.feed(chunk):
+                print(line, flush=True)
+
+    if decoder.buf or decoder.text:
+        print("(%d trailing bytes)" % (len(decoder.buf) + len(decoder.text)), file=sys.stderr)
+    print("%d records, %d blocks, %d errors" % (decoder.records, decoder.blocks, decoder.errors), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Decode a raw ADC waveform stream (settings menu "Wave Stream", see
+Components/Inc/wavestream.h) into CSV and/or a 10 channel WAV file.
+
+Capture on Linux (enable the stream first, the UART switches to 2 Mbaud):
+
+    stty -F /dev/ttyUSB0 2000000 raw -echo
+    cat /dev/ttyUSB0 > wave.bin
+    python3 wave_decode.py wave.bin --csv wave.csv --wav wave.wav
+
+CSV columns: frame index (gaps included), then the ten raw 12-bit values.
+WAV channels hold (value - 2048) * 16 so 0..4095 spans the 16-bit range.
+Dropped frames (sequence gaps) and resync skips are reported on stderr.
+No third party packages are needed.
+"""
+
+import argparse
+import struct
+import sys
+import wave
+
+SYNC = b"\xA5\x5A"
+FRAME_SIZE = 18
+PADS = ["OpenHiHat", "CloseHiHat", "Crash", "Ride", "SideStick",
+        "Kick", "Snare", "MidTom", "LowTom", "HighTom"]
+
+
+def unpack_frame(frame):
+    """Return (seq, [10 samples]) of an 18 byte frame."""
+    seq = frame[2]
+    samples = []
+    for i in range(3, FRAME_SIZE, 3):
+        b0, b1, b2 = frame[i], frame[i + 1], frame[i + 2]
+        samples.append(b0 | ((b1 & 0x0F) << 8))
+        samples.append((b1 >> 4) | (b2 << 4))
+    return seq, samples
+
+
+def decode(data):
+    """
+    Return ([(index, samples)], stats), the frame index counts lost frames too.
+    A frame is accepted when the next one starts with the sync as well
+    (or it is the last one), otherwise one byte is skipped.
+    """
+    frames = []
+    stats = {"frames": 0, "dropped": 0, "skipped": 0}
+    pos = 0
+    index = 0
+    last_seq = None
+
+    while pos + FRAME_SIZE <= len(data):
+        nxt = pos + FRAME_SIZE
+        locked = data[pos:pos + 2] == SYNC and (nxt + 2 > len(data) or data[nxt:nxt + 2] == SYNC)
+        if not locked:
+            pos += 1
+            stats["skipped"] += 1
+            continue
+
+        seq, samples = unpack_frame(data[pos:nxt])
+        if last_seq is not None:
+            gap = (seq - last_seq - 1) & 0xFF
+            stats["dropped"] += gap
+            index += gap + 1
+        last_seq = seq
+
+        stats["frames"] += 1
+        frames.append((index, samples))
+        pos = nxt
+
+    stats["trailing"] = len(data) - pos
+    return frames, stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode drumkit ADC waveform stream dumps")
+    parser.add_argument("dump", help="Captured UART bytes")
+    parser.add_argument("--csv", help="Write CSV to this file ('-' for stdout)")
+    parser.add_argument("--wav", help="Write a 10 channel 16-bit WAV to this file")
+    parser.add_argument("--rate", type=int, default=10000, help="Frame rate in Hz (pad scan rate / divider, default 10000)")
+    opts = parser.parse_args()
+
+    with open(opts.dump, "rb") as f:
+        data = f.read()
+
+    frames, stats = decode(data)
+
+    if opts.csv:
+        out = sys.stdout if opts.csv == "-" else open(opts.csv, "w")
+        out.write("frame," + ",".join(PADS) + "\n")
+        for index, samples in frames:
+            out.write("%d,%s\n" % (index, ",".join(str(s) for s in samples)))
+        if out is not sys.stdout:
+            out.close()
+
+    if opts.wav:
+        with wave.open(opts.wav, "wb") as w:
+            w.setnchannels(len(PADS))
+            w.setsampwidth(2)
+            w.setframerate(opts.rate)
+            prev = [2048] * len(PADS)
+            body = bytearray()
+            expected = 0
+            for index, samples in frames:
+                # Hold the last value over lost frames to keep the time axis
+                for _ in range(index - expected):
+                    body += struct.pack("<10h", *[(v - 2048) * 16 for v in prev])
+                body += struct.pack("<10h", *[(v - 2048) * 16 for v in samples])
+                prev = samples
+                expected = index + 1
+            w.writeframes(bytes(body))
+
+    total = stats["frames"] + stats["dropped"]
+    print("%d frames, %d dropped (%.2f%%), %d bytes skipped, %d trailing bytes" % (
+        stats["frames"], stats["dropped"], 100.0 * stats["dropped"] / total if total else 0.0,
+        stats["skipped"], stats["trailing"]), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()